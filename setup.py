@@ -226,5 +226,6 @@ setup(name = "gmpy2",
         'Topic :: Software Development :: Libraries :: Python Modules',
       ],
       cmdclass = my_commands,
+      headers = [os.path.join('src', 'gmpy2_capi.h')],
       ext_modules = [gmpy2_ext]
 )
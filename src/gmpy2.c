@@ -396,6 +396,7 @@
 #include <stdio.h>
 #include <ctype.h>
 
+#define GMPY2_MODULE
 #include "gmpy2.h"
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
@@ -418,30 +419,35 @@ LGPL 3 or later.";
  */
 
 static struct gmpy_global {
-    int cache_size;          /* size of cache, for all caches */
+    int cache_size;          /* size of cache, for all caches (see gmpy2_cache.c) */
     int cache_obsize;        /* maximum size of the objects that are cached */
+    int cache_autotune;      /* grow cache_size when the miss rate is high */
+    long gil_threshold;      /* minimum size of operands that release the GIL */
 } global = {
     100,                     /* cache_size */
     128,                     /* cache_obsize */
+    0,                       /* cache_autotune */
+    GMPY_DEFAULT_GIL_THRESHOLD, /* gil_threshold */
 };
 
-static mpz_t* zcache;
-static int in_zcache;
-
-static MPZ_Object **gmpympzcache;
-static int in_gmpympzcache;
-
-static XMPZ_Object **gmpyxmpzcache;
-static int in_gmpyxmpzcache;
+/* Each thread has its own caches (see gmpy2_cache.c). Objects that do not
+ * fit in the cache of a thread are kept in a shared pool protected by
+ * gmpy_cache_lock.
+ */
 
-static MPQ_Object **gmpympqcache;
-static int in_gmpympqcache;
+#ifdef GMPY_TLS
+static GMPY_TLS GMPy_Cache *gmpy_cache_tls = NULL;
+static GMPy_Cache gmpy_cache_pool;
+static PyThread_type_lock gmpy_cache_lock = NULL;
+static PyObject *gmpy_cache_key = NULL;
+#else
+static GMPy_Cache gmpy_cache_main;
+#endif
+static int gmpy_cache_generation = 1;
 
-static MPFR_Object **gmpympfrcache;
-static int in_gmpympfrcache;
+/* The interned mpz values (see GMPY_SMALL_MPZ_MIN in gmpy2_cache.h). */
 
-static MPC_Object **gmpympccache;
-static int in_gmpympccache;
+static MPZ_Object *gmpy_small_mpz[GMPY_SMALL_MPZ_MAX - GMPY_SMALL_MPZ_MIN + 1];
 
 /* Support for context manager. */
 
@@ -449,11 +455,28 @@ static int in_gmpympccache;
 /* Use a module-level context. */
 static CTXT_Object *module_context = NULL;
 #else
+#ifdef GMPY_CONTEXTVAR
+/* contextvars.ContextVar that holds the current context */
+static PyObject *current_context_var = NULL;
+#else
 /* Key for thread state dictionary */
 static PyObject *tls_context_key = NULL;
+#endif
+#if defined(GMPY_TLS)
+/* Borrowed reference to the context of the current thread, or NULL. The
+ * reference is owned by the thread state dictionary (or the current
+ * contextvars.Context) of tls_tstate; an OS thread may run several
+ * (sub)interpreter thread states. */
+static GMPY_TLS CTXT_Object *tls_context = NULL;
+static GMPY_TLS PyThreadState *tls_tstate = NULL;
+#ifdef GMPY_CONTEXTVAR
+static GMPY_TLS uint64_t tls_context_ver = 0;
+#endif
+#elif !defined(GMPY_CONTEXTVAR)
 /* Invariant: NULL or the most recently accessed thread local context */
 static CTXT_Object *cached_context = NULL;
 #endif
+#endif
 
 
 /* Define gmpy2 specific errors for mpfr and mpc data types. No change will
@@ -469,10 +492,20 @@ static PyObject *GMPyExc_Underflow = NULL;
 static PyObject *GMPyExc_Erange = NULL;
 
 
+/* Table of pointers exported as the capsule "gmpy2._C_API". See
+ * gmpy2_capi.h for the layout.
+ */
+
+static void *GMPy_C_API[GMPy_CAPI_SIZE];
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
  * End of global data declarations.                                        *
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+/* The memory functions used by GMP, MPFR, and MPC are in gmpy2_alloc.c. */
+
+#include "gmpy2_alloc.c"
+
 /* The code for object creation, deletion, and caching is in gmpy_cache.c. */
 
 #include "gmpy2_cache.c"
@@ -488,6 +521,7 @@ static PyObject *GMPyExc_Erange = NULL;
 /* Support for conversion to/from binary representation. */
 
 #include "gmpy2_binary.c"
+#include "gmpy2_pickle.c"
 
 /* Support for conversions to/from numeric types. */
 
@@ -556,60 +590,84 @@ static PyObject *GMPyExc_Erange = NULL;
 #include "gmpy2_mpq.c"
 #include "gmpy2_mpfr.c"
 #include "gmpy2_mpc.c"
+#include "gmpy2_mpz_vector.c"
+#include "gmpy2_mpz_tree.c"
+#include "gmpy2_modcontext.c"
+#include "gmpy2_fixedbase.c"
+#include "gmpy2_crt.c"
+#include "gmpy2_mpz_table.c"
 
 #include "gmpy2_context.c"
 
 static PyMethodDef Pygmpy_methods [] =
 {
     { "_cvsid", GMPy_get_cvsid, METH_NOARGS, GMPy_doc_cvsid },
+#ifdef GMPY_PICKLE_BUFFERS
+    { "_from_pickle_buffers", (PyCFunction)GMPy_MPANY_From_Pickle_Buffers, GMPY_METH_FASTCALL, GMPy_doc_function_from_pickle_buffers },
+#endif
     { "_printf", GMPy_printf, METH_VARARGS, GMPy_doc_function_printf },
-    { "add", GMPy_Context_Add, METH_VARARGS, GMPy_doc_function_add },
-    { "bit_clear", GMPy_MPZ_bit_clear_function, METH_VARARGS, doc_bit_clear_function },
-    { "bit_flip", GMPy_MPZ_bit_flip_function, METH_VARARGS, doc_bit_flip_function },
+    { "add", (PyCFunction)GMPy_Context_Add, GMPY_METH_FASTCALL, GMPy_doc_function_add },
+    { "allocator_stats", GMPy_allocator_stats, METH_NOARGS, GMPy_doc_allocator_stats },
+    { "bit_clear", (PyCFunction)GMPy_MPZ_bit_clear_function, GMPY_METH_FASTCALL, doc_bit_clear_function },
+    { "bit_flip", (PyCFunction)GMPy_MPZ_bit_flip_function, GMPY_METH_FASTCALL, doc_bit_flip_function },
     { "bit_length", GMPy_MPZ_bit_length_function, METH_O, doc_bit_length_function },
     { "bit_mask", GMPy_MPZ_bit_mask, METH_O, doc_bit_mask },
-    { "bit_scan0", GMPy_MPZ_bit_scan0_function, METH_VARARGS, doc_bit_scan0_function },
-    { "bit_scan1", GMPy_MPZ_bit_scan1_function, METH_VARARGS, doc_bit_scan1_function },
-    { "bit_set", GMPy_MPZ_bit_set_function, METH_VARARGS, doc_bit_set_function },
-    { "bit_test", GMPy_MPZ_bit_test_function, METH_VARARGS, doc_bit_test_function },
-    { "bincoef", GMPy_MPZ_Function_Bincoef, METH_VARARGS, GMPy_doc_mpz_function_bincoef },
-    { "comb", GMPy_MPZ_Function_Bincoef, METH_VARARGS, GMPy_doc_mpz_function_comb },
-    { "c_div", GMPy_MPZ_c_div, METH_VARARGS, doc_c_div },
-    { "c_div_2exp", GMPy_MPZ_c_div_2exp, METH_VARARGS, doc_c_div_2exp },
-    { "c_divmod", GMPy_MPZ_c_divmod, METH_VARARGS, doc_c_divmod },
-    { "c_divmod_2exp", GMPy_MPZ_c_divmod_2exp, METH_VARARGS, doc_c_divmod_2exp },
-    { "c_mod", GMPy_MPZ_c_mod, METH_VARARGS, doc_c_mod },
-    { "c_mod_2exp", GMPy_MPZ_c_mod_2exp, METH_VARARGS, doc_c_mod_2exp },
+    { "bit_scan0", (PyCFunction)GMPy_MPZ_bit_scan0_function, GMPY_METH_FASTCALL, doc_bit_scan0_function },
+    { "bit_scan1", (PyCFunction)GMPy_MPZ_bit_scan1_function, GMPY_METH_FASTCALL, doc_bit_scan1_function },
+    { "bit_set", (PyCFunction)GMPy_MPZ_bit_set_function, GMPY_METH_FASTCALL, doc_bit_set_function },
+    { "bit_test", (PyCFunction)GMPy_MPZ_bit_test_function, GMPY_METH_FASTCALL, doc_bit_test_function },
+    { "batch_gcd", GMPy_MPZ_Function_BatchGCD, METH_O, GMPy_doc_mpz_function_batch_gcd },
+    { "batch_invert", (PyCFunction)GMPy_MPZ_Function_BatchInvert, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_batch_invert },
+    { "batch_mod", (PyCFunction)GMPy_MPZ_Function_BatchMod, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_batch_mod },
+    { "bincoef", (PyCFunction)GMPy_MPZ_Function_Bincoef, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_bincoef },
+    { "comb", (PyCFunction)GMPy_MPZ_Function_Bincoef, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_comb },
+    { "cache_stats", GMPy_cache_stats, METH_NOARGS, GMPy_doc_cache_stats },
+    { "c_div", (PyCFunction)GMPy_MPZ_c_div, GMPY_METH_FASTCALL, doc_c_div },
+    { "c_div_2exp", (PyCFunction)GMPy_MPZ_c_div_2exp, GMPY_METH_FASTCALL, doc_c_div_2exp },
+    { "c_divmod", (PyCFunction)GMPy_MPZ_c_divmod, GMPY_METH_FASTCALL, doc_c_divmod },
+    { "c_divmod_2exp", (PyCFunction)GMPy_MPZ_c_divmod_2exp, GMPY_METH_FASTCALL, doc_c_divmod_2exp },
+    { "c_mod", (PyCFunction)GMPy_MPZ_c_mod, GMPY_METH_FASTCALL, doc_c_mod },
+    { "c_mod_2exp", (PyCFunction)GMPy_MPZ_c_mod_2exp, GMPY_METH_FASTCALL, doc_c_mod_2exp },
+    { "crt", (PyCFunction)GMPy_MPZ_Function_CRT, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_crt },
+    { "CRTBasis", GMPy_CRTBasis_Factory, METH_O, GMPy_doc_crtbasis_factory },
     { "denom", GMPy_MPQ_Function_Denom, METH_O, GMPy_doc_mpq_function_denom },
     { "digits", GMPy_Context_Digits, METH_VARARGS, GMPy_doc_context_digits },
-    { "div", GMPy_Context_TrueDiv, METH_VARARGS, GMPy_doc_truediv },
-    { "divexact", GMPy_MPZ_Function_Divexact, METH_VARARGS, GMPy_doc_mpz_function_divexact },
-    { "divm", GMPy_MPZ_Function_Divm, METH_VARARGS, GMPy_doc_mpz_function_divm },
-    { "div_mod", GMPy_Context_DivMod, METH_VARARGS, GMPy_doc_divmod },
+    { "div", (PyCFunction)GMPy_Context_TrueDiv, GMPY_METH_FASTCALL, GMPy_doc_truediv },
+    { "divexact", (PyCFunction)GMPy_MPZ_Function_Divexact, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_divexact },
+    { "divm", (PyCFunction)GMPy_MPZ_Function_Divm, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_divm },
+    { "div_mod", (PyCFunction)GMPy_Context_DivMod, GMPY_METH_FASTCALL, GMPy_doc_divmod },
     { "double_fac", GMPy_MPZ_Function_DoubleFac, METH_O, GMPy_doc_mpz_function_double_fac },
     { "fac", GMPy_MPZ_Function_Fac, METH_O, GMPy_doc_mpz_function_fac },
     { "fib", GMPy_MPZ_Function_Fib, METH_O, GMPy_doc_mpz_function_fib },
     { "fib2", GMPy_MPZ_Function_Fib2, METH_O, GMPy_doc_mpz_function_fib2 },
-    { "floor_div", GMPy_Context_FloorDiv, METH_VARARGS, GMPy_doc_floordiv },
+    { "FixedBasePow", (PyCFunction)GMPy_FixedBasePow_Factory, GMPY_METH_FASTCALL, GMPy_doc_fixedbasepow_factory },
+    { "floor_div", (PyCFunction)GMPy_Context_FloorDiv, GMPY_METH_FASTCALL, GMPy_doc_floordiv },
     { "from_binary", GMPy_MPANY_From_Binary, METH_O, doc_from_binary },
-    { "f_div", GMPy_MPZ_f_div, METH_VARARGS, doc_f_div },
-    { "f_div_2exp", GMPy_MPZ_f_div_2exp, METH_VARARGS, doc_f_div_2exp },
-    { "f_divmod", GMPy_MPZ_f_divmod, METH_VARARGS, doc_f_divmod },
-    { "f_divmod_2exp", GMPy_MPZ_f_divmod_2exp, METH_VARARGS, doc_f_divmod_2exp },
-    { "f_mod", GMPy_MPZ_f_mod, METH_VARARGS, doc_f_mod },
-    { "f_mod_2exp", GMPy_MPZ_f_mod_2exp, METH_VARARGS, doc_f_mod_2exp },
-    { "gcd", GMPy_MPZ_Function_GCD, METH_VARARGS, GMPy_doc_mpz_function_gcd },
-    { "gcdext", GMPy_MPZ_Function_GCDext, METH_VARARGS, GMPy_doc_mpz_function_gcdext },
+    { "from_binary_iter", GMPy_MPANY_From_Binary_Iter, METH_O, GMPy_doc_function_from_binary_iter },
+    { "from_binary_many", GMPy_MPANY_From_Binary_Many, METH_O, GMPy_doc_function_from_binary_many },
+    { "from_limbs", (PyCFunction)GMPy_MPZ_Function_From_Limbs, GMPY_METH_FASTCALL, GMPy_doc_function_from_limbs },
+    { "f_div", (PyCFunction)GMPy_MPZ_f_div, GMPY_METH_FASTCALL, doc_f_div },
+    { "f_div_2exp", (PyCFunction)GMPy_MPZ_f_div_2exp, GMPY_METH_FASTCALL, doc_f_div_2exp },
+    { "f_divmod", (PyCFunction)GMPy_MPZ_f_divmod, GMPY_METH_FASTCALL, doc_f_divmod },
+    { "f_divmod_2exp", (PyCFunction)GMPy_MPZ_f_divmod_2exp, GMPY_METH_FASTCALL, doc_f_divmod_2exp },
+    { "f_mod", (PyCFunction)GMPy_MPZ_f_mod, GMPY_METH_FASTCALL, doc_f_mod },
+    { "f_mod_2exp", (PyCFunction)GMPy_MPZ_f_mod_2exp, GMPY_METH_FASTCALL, doc_f_mod_2exp },
+    { "gcd", (PyCFunction)GMPy_MPZ_Function_GCD, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_gcd },
+    { "gcdext", (PyCFunction)GMPy_MPZ_Function_GCDext, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_gcdext },
     { "get_cache", GMPy_get_cache, METH_NOARGS, GMPy_doc_get_cache },
-    { "hamdist", GMPy_MPZ_hamdist, METH_VARARGS, doc_hamdist },
-    { "invert", GMPy_MPZ_Function_Invert, METH_VARARGS, GMPy_doc_mpz_function_invert },
-    { "iroot", GMPy_MPZ_Function_Iroot, METH_VARARGS, GMPy_doc_mpz_function_iroot },
-    { "iroot_rem", GMPy_MPZ_Function_IrootRem, METH_VARARGS, GMPy_doc_mpz_function_iroot_rem },
+    { "get_cache_autotune", GMPy_get_cache_autotune, METH_NOARGS, GMPy_doc_get_cache_autotune },
+    { "get_allocator", GMPy_get_allocator, METH_NOARGS, GMPy_doc_get_allocator },
+    { "get_cache_bins", GMPy_get_cache_bins, METH_NOARGS, GMPy_doc_get_cache_bins },
+    { "get_gil_threshold", GMPy_get_gil_threshold, METH_NOARGS, GMPy_doc_get_gil_threshold },
+    { "hamdist", (PyCFunction)GMPy_MPZ_hamdist, GMPY_METH_FASTCALL, doc_hamdist },
+    { "invert", (PyCFunction)GMPy_MPZ_Function_Invert, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_invert },
+    { "iroot", (PyCFunction)GMPy_MPZ_Function_Iroot, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_iroot },
+    { "iroot_rem", (PyCFunction)GMPy_MPZ_Function_IrootRem, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_iroot_rem },
     { "isqrt", GMPy_MPZ_Function_Isqrt, METH_O, GMPy_doc_mpz_function_isqrt },
     { "isqrt_rem", GMPy_MPZ_Function_IsqrtRem, METH_O, GMPy_doc_mpz_function_isqrt_rem },
     { "is_bpsw_prp", GMPY_mpz_is_bpsw_prp, METH_VARARGS, doc_mpz_is_bpsw_prp },
-    { "is_congruent", GMPy_MPZ_Function_IsCongruent, METH_VARARGS, GMPy_doc_mpz_function_is_congruent },
-    { "is_divisible", GMPy_MPZ_Function_IsDivisible, METH_VARARGS, GMPy_doc_mpz_function_is_divisible },
+    { "is_congruent", (PyCFunction)GMPy_MPZ_Function_IsCongruent, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_is_congruent },
+    { "is_divisible", (PyCFunction)GMPy_MPZ_Function_IsDivisible, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_is_divisible },
     { "is_even", GMPy_MPZ_Function_IsEven, METH_O, GMPy_doc_mpz_function_is_even },
     { "is_euler_prp", GMPY_mpz_is_euler_prp, METH_VARARGS, doc_mpz_is_euler_prp },
     { "is_extra_strong_lucas_prp", GMPY_mpz_is_extrastronglucas_prp, METH_VARARGS, doc_mpz_is_extrastronglucas_prp },
@@ -618,17 +676,17 @@ static PyMethodDef Pygmpy_methods [] =
     { "is_lucas_prp", GMPY_mpz_is_lucas_prp, METH_VARARGS, doc_mpz_is_lucas_prp },
     { "is_odd", GMPy_MPZ_Function_IsOdd, METH_O, GMPy_doc_mpz_function_is_odd },
     { "is_power", GMPy_MPZ_Function_IsPower, METH_O, GMPy_doc_mpz_function_is_power },
-    { "is_prime", GMPy_MPZ_Function_IsPrime, METH_VARARGS, GMPy_doc_mpz_function_is_prime },
+    { "is_prime", (PyCFunction)GMPy_MPZ_Function_IsPrime, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_is_prime },
     { "is_selfridge_prp", GMPY_mpz_is_selfridge_prp, METH_VARARGS, doc_mpz_is_selfridge_prp },
     { "is_square", GMPy_MPZ_Function_IsSquare, METH_O, GMPy_doc_mpz_function_is_square },
     { "is_strong_prp", GMPY_mpz_is_strong_prp, METH_VARARGS, doc_mpz_is_strong_prp },
     { "is_strong_bpsw_prp", GMPY_mpz_is_strongbpsw_prp, METH_VARARGS, doc_mpz_is_strongbpsw_prp },
     { "is_strong_lucas_prp", GMPY_mpz_is_stronglucas_prp, METH_VARARGS, doc_mpz_is_stronglucas_prp },
     { "is_strong_selfridge_prp", GMPY_mpz_is_strongselfridge_prp, METH_VARARGS, doc_mpz_is_strongselfridge_prp },
-    { "jacobi", GMPy_MPZ_Function_Jacobi, METH_VARARGS, GMPy_doc_mpz_function_jacobi },
-    { "kronecker", GMPy_MPZ_Function_Kronecker, METH_VARARGS, GMPy_doc_mpz_function_kronecker },
-    { "lcm", GMPy_MPZ_Function_LCM, METH_VARARGS, GMPy_doc_mpz_function_lcm },
-    { "legendre", GMPy_MPZ_Function_Legendre, METH_VARARGS, GMPy_doc_mpz_function_legendre },
+    { "jacobi", (PyCFunction)GMPy_MPZ_Function_Jacobi, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_jacobi },
+    { "kronecker", (PyCFunction)GMPy_MPZ_Function_Kronecker, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_kronecker },
+    { "lcm", (PyCFunction)GMPy_MPZ_Function_LCM, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_lcm },
+    { "legendre", (PyCFunction)GMPy_MPZ_Function_Legendre, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_legendre },
     { "license", GMPy_get_license, METH_NOARGS, GMPy_doc_license },
     { "lucas", GMPy_MPZ_Function_Lucas, METH_O, GMPy_doc_mpz_function_lucas },
     { "lucasu", GMPY_mpz_lucasu, METH_VARARGS, doc_mpz_lucasu },
@@ -636,57 +694,68 @@ static PyMethodDef Pygmpy_methods [] =
     { "lucasv", GMPY_mpz_lucasv, METH_VARARGS, doc_mpz_lucasv },
     { "lucasv_mod", GMPY_mpz_lucasv_mod, METH_VARARGS, doc_mpz_lucasv_mod },
     { "lucas2", GMPy_MPZ_Function_Lucas2, METH_O, GMPy_doc_mpz_function_lucas2 },
-    { "mod", GMPy_Context_Mod, METH_VARARGS, GMPy_doc_mod },
+    { "mod", (PyCFunction)GMPy_Context_Mod, GMPY_METH_FASTCALL, GMPy_doc_mod },
+    { "ModContext", (PyCFunction)GMPy_ModContext_Factory, GMPY_METH_FASTCALL, GMPy_doc_modcontext_factory },
     { "mp_version", GMPy_get_mp_version, METH_NOARGS, GMPy_doc_mp_version },
     { "mp_limbsize", GMPy_get_mp_limbsize, METH_NOARGS, GMPy_doc_mp_limbsize },
     { "mpc_version", GMPy_get_mpc_version, METH_NOARGS, GMPy_doc_mpc_version },
     { "mpfr_version", GMPy_get_mpfr_version, METH_NOARGS, GMPy_doc_mpfr_version },
-    { "mpq", (PyCFunction)GMPy_MPQ_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpq_factory },
+    { "mpq", (PyCFunction)GMPy_MPQ_Factory, GMPY_METH_FASTCALL | METH_KEYWORDS, GMPy_doc_mpq_factory },
     { "mpq_from_old_binary", GMPy_MPQ_From_Old_Binary, METH_O, doc_mpq_from_old_binary },
-    { "mpz", (PyCFunction)GMPy_MPZ_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpz_factory },
+    { "mpz", (PyCFunction)GMPy_MPZ_Factory, GMPY_METH_FASTCALL | METH_KEYWORDS, GMPy_doc_mpz_factory },
     { "mpz_from_old_binary", GMPy_MPZ_From_Old_Binary, METH_O, doc_mpz_from_old_binary },
-    { "mpz_random", GMPy_MPZ_random_Function, METH_VARARGS, GMPy_doc_mpz_random_function },
-    { "mpz_rrandomb", GMPy_MPZ_rrandomb_Function, METH_VARARGS, GMPy_doc_mpz_rrandomb_function },
-    { "mpz_urandomb", GMPy_MPZ_urandomb_Function, METH_VARARGS, GMPy_doc_mpz_urandomb_function },
-    { "mul", GMPy_Context_Mul, METH_VARARGS, GMPy_doc_function_mul },
-    { "multi_fac", GMPy_MPZ_Function_MultiFac, METH_VARARGS, GMPy_doc_mpz_function_multi_fac },
+    { "mpz_random", (PyCFunction)GMPy_MPZ_random_Function, GMPY_METH_FASTCALL, GMPy_doc_mpz_random_function },
+    { "mpz_rrandomb", (PyCFunction)GMPy_MPZ_rrandomb_Function, GMPY_METH_FASTCALL, GMPy_doc_mpz_rrandomb_function },
+    { "mpz_urandomb", (PyCFunction)GMPy_MPZ_urandomb_Function, GMPY_METH_FASTCALL, GMPy_doc_mpz_urandomb_function },
+    { "MPZTable", GMPy_MPZTable_Factory, METH_O, GMPy_doc_mpztable_factory },
+    { "mpz_vector", (PyCFunction)GMPy_MPZ_Vector_Factory, GMPY_METH_FASTCALL, GMPy_doc_mpz_vector_factory },
+    { "mul", (PyCFunction)GMPy_Context_Mul, GMPY_METH_FASTCALL, GMPy_doc_function_mul },
+    { "multi_fac", (PyCFunction)GMPy_MPZ_Function_MultiFac, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_multi_fac },
+    { "multi_powmod", (PyCFunction)GMPy_Integer_MultiPowMod, GMPY_METH_FASTCALL, GMPy_doc_integer_multi_powmod },
     { "next_prime", GMPy_MPZ_Function_NextPrime, METH_O, GMPy_doc_mpz_function_next_prime },
     { "numer", GMPy_MPQ_Function_Numer, METH_O, GMPy_doc_mpq_function_numer },
-    { "num_digits", GMPy_MPZ_Function_NumDigits, METH_VARARGS, GMPy_doc_mpz_function_num_digits },
-    { "pack", GMPy_MPZ_pack, METH_VARARGS, doc_pack },
+    { "num_digits", (PyCFunction)GMPy_MPZ_Function_NumDigits, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_num_digits },
+    { "pack", (PyCFunction)GMPy_MPZ_pack, GMPY_METH_FASTCALL, doc_pack },
     { "popcount", GMPy_MPZ_popcount, METH_O, doc_popcount },
-    { "powmod", GMPy_Integer_PowMod, METH_VARARGS, GMPy_doc_integer_powmod },
+    { "powmod", (PyCFunction)GMPy_Integer_PowMod, GMPY_METH_FASTCALL, GMPy_doc_integer_powmod },
     { "primorial", GMPy_MPZ_Function_Primorial, METH_O, GMPy_doc_mpz_function_primorial },
-    { "qdiv", GMPy_MPQ_Function_Qdiv, METH_VARARGS, GMPy_doc_function_qdiv },
-    { "remove", GMPy_MPZ_Function_Remove, METH_VARARGS, GMPy_doc_mpz_function_remove },
-    { "random_state", GMPy_RandomState_Factory, METH_VARARGS, GMPy_doc_random_state_factory },
+    { "prod_tree", GMPy_MPZ_Function_ProdTree, METH_O, GMPy_doc_mpz_function_prod_tree },
+    { "qdiv", (PyCFunction)GMPy_MPQ_Function_Qdiv, GMPY_METH_FASTCALL, GMPy_doc_function_qdiv },
+    { "reset_cache_stats", GMPy_reset_cache_stats, METH_NOARGS, GMPy_doc_reset_cache_stats },
+    { "remove", (PyCFunction)GMPy_MPZ_Function_Remove, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_remove },
+    { "random_state", (PyCFunction)GMPy_RandomState_Factory, GMPY_METH_FASTCALL, GMPy_doc_random_state_factory },
+    { "set_allocator", GMPy_set_allocator, METH_O, GMPy_doc_set_allocator },
     { "set_cache", GMPy_set_cache, METH_VARARGS, GMPy_doc_set_cache },
+    { "set_cache_autotune", GMPy_set_cache_autotune, METH_O, GMPy_doc_set_cache_autotune },
+    { "set_gil_threshold", GMPy_set_gil_threshold, METH_O, GMPy_doc_set_gil_threshold },
     { "sign", GMPy_Context_Sign, METH_O, GMPy_doc_function_sign },
     { "square", GMPy_Context_Square, METH_O, GMPy_doc_function_square },
-    { "sub", GMPy_Context_Sub, METH_VARARGS, GMPy_doc_sub },
-    { "to_binary", GMPy_MPANY_To_Binary, METH_O, doc_to_binary },
-    { "t_div", GMPy_MPZ_t_div, METH_VARARGS, doc_t_div },
-    { "t_div_2exp", GMPy_MPZ_t_div_2exp, METH_VARARGS, doc_t_div_2exp },
-    { "t_divmod", GMPy_MPZ_t_divmod, METH_VARARGS, doc_t_divmod },
-    { "t_divmod_2exp", GMPy_MPZ_t_divmod_2exp, METH_VARARGS, doc_t_divmod_2exp },
-    { "t_mod", GMPy_MPZ_t_mod, METH_VARARGS, doc_t_mod },
-    { "t_mod_2exp", GMPy_MPZ_t_mod_2exp, METH_VARARGS, doc_t_mod_2exp },
-    { "unpack", GMPy_MPZ_unpack, METH_VARARGS, doc_unpack },
+    { "sub", (PyCFunction)GMPy_Context_Sub, GMPY_METH_FASTCALL, GMPy_doc_sub },
+    { "to_binary", (PyCFunction)GMPy_MPANY_To_Binary_Function, GMPY_METH_FASTCALL | METH_KEYWORDS, doc_to_binary },
+    { "to_binary_many", (PyCFunction)GMPy_MPANY_To_Binary_Many, GMPY_METH_FASTCALL | METH_KEYWORDS, GMPy_doc_function_to_binary_many },
+    { "t_div", (PyCFunction)GMPy_MPZ_t_div, GMPY_METH_FASTCALL, doc_t_div },
+    { "t_div_2exp", (PyCFunction)GMPy_MPZ_t_div_2exp, GMPY_METH_FASTCALL, doc_t_div_2exp },
+    { "t_divmod", (PyCFunction)GMPy_MPZ_t_divmod, GMPY_METH_FASTCALL, doc_t_divmod },
+    { "t_divmod_2exp", (PyCFunction)GMPy_MPZ_t_divmod_2exp, GMPY_METH_FASTCALL, doc_t_divmod_2exp },
+    { "t_mod", (PyCFunction)GMPy_MPZ_t_mod, GMPY_METH_FASTCALL, doc_t_mod },
+    { "t_mod_2exp", (PyCFunction)GMPy_MPZ_t_mod_2exp, GMPY_METH_FASTCALL, doc_t_mod_2exp },
+    { "unpack", (PyCFunction)GMPy_MPZ_unpack, GMPY_METH_FASTCALL, doc_unpack },
     { "version", GMPy_get_version, METH_NOARGS, GMPy_doc_version },
+    { "write_mpz_table", (PyCFunction)GMPy_MPZ_Function_WriteTable, GMPY_METH_FASTCALL, GMPy_doc_mpz_function_write_table },
     { "xbit_mask", GMPy_XMPZ_Function_XbitMask, METH_O, GMPy_doc_xmpz_function_xbit_mask },
-    { "xmpz", (PyCFunction)GMPy_XMPZ_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_xmpz_factory },
-    { "_mpmath_normalize", Pympz_mpmath_normalize, METH_VARARGS, doc_mpmath_normalizeg },
-    { "_mpmath_create", Pympz_mpmath_create, METH_VARARGS, doc_mpmath_createg },
+    { "xmpz", (PyCFunction)GMPy_XMPZ_Factory, GMPY_METH_FASTCALL | METH_KEYWORDS, GMPy_doc_xmpz_factory },
+    { "_mpmath_normalize", (PyCFunction)Pympz_mpmath_normalize, GMPY_METH_FASTCALL, doc_mpmath_normalizeg },
+    { "_mpmath_create", (PyCFunction)Pympz_mpmath_create, GMPY_METH_FASTCALL, doc_mpmath_createg },
 
     { "acos", GMPy_Context_Acos, METH_O, GMPy_doc_function_acos },
     { "acosh", GMPy_Context_Acosh, METH_O, GMPy_doc_function_acosh },
     { "ai", GMPy_Context_Ai, METH_O, GMPy_doc_function_ai },
-    { "agm", GMPy_Context_AGM, METH_VARARGS, GMPy_doc_function_agm },
+    { "agm", (PyCFunction)GMPy_Context_AGM, GMPY_METH_FASTCALL, GMPy_doc_function_agm },
     { "asin", GMPy_Context_Asin, METH_O, GMPy_doc_function_asin },
     { "asinh", GMPy_Context_Asinh, METH_O, GMPy_doc_function_asinh },
     { "atan", GMPy_Context_Atan, METH_O, GMPy_doc_function_atan },
     { "atanh", GMPy_Context_Atanh, METH_O, GMPy_doc_function_atanh },
-    { "atan2", GMPy_Context_Atan2, METH_VARARGS, GMPy_doc_function_atan2 },
+    { "atan2", (PyCFunction)GMPy_Context_Atan2, GMPY_METH_FASTCALL, GMPy_doc_function_atan2 },
     { "can_round", GMPy_MPFR_Can_Round, METH_VARARGS, GMPy_doc_mpfr_can_round },
     { "cbrt", GMPy_Context_Cbrt, METH_O, GMPy_doc_function_cbrt },
     { "ceil", GMPy_Context_Ceil, METH_O, GMPy_doc_function_ceil },
@@ -696,7 +765,7 @@ static PyMethodDef Pygmpy_methods [] =
     { "const_log2", (PyCFunction)GMPy_Function_Const_Log2, METH_VARARGS | METH_KEYWORDS, GMPy_doc_function_const_log2 },
     { "const_pi", (PyCFunction)GMPy_Function_Const_Pi, METH_VARARGS | METH_KEYWORDS, GMPy_doc_function_const_pi },
     { "context", (PyCFunction)GMPy_CTXT_Context, METH_VARARGS | METH_KEYWORDS, GMPy_doc_context },
-    { "copy_sign", GMPy_MPFR_copy_sign, METH_VARARGS, GMPy_doc_mpfr_copy_sign },
+    { "copy_sign", (PyCFunction)GMPy_MPFR_copy_sign, GMPY_METH_FASTCALL, GMPy_doc_mpfr_copy_sign },
     { "cos", GMPy_Context_Cos, METH_O, GMPy_doc_function_cos },
     { "cosh", GMPy_Context_Cosh, METH_O, GMPy_doc_function_cosh },
     { "cot", GMPy_Context_Cot, METH_O, GMPy_doc_function_cot },
@@ -705,7 +774,7 @@ static PyMethodDef Pygmpy_methods [] =
     { "csch", GMPy_Context_Csch, METH_O, GMPy_doc_function_csch },
     { "degrees", GMPy_Context_Degrees, METH_O, GMPy_doc_function_degrees },
     { "digamma", GMPy_Context_Digamma, METH_O, GMPy_doc_function_digamma },
-    { "div_2exp", GMPy_Context_Div_2exp, METH_VARARGS, GMPy_doc_function_div_2exp },
+    { "div_2exp", (PyCFunction)GMPy_Context_Div_2exp, GMPY_METH_FASTCALL, GMPy_doc_function_div_2exp },
     { "eint", GMPy_Context_Eint, METH_O, GMPy_doc_function_eint },
     { "erf", GMPy_Context_Erf, METH_O, GMPy_doc_function_erf },
     { "erfc", GMPy_Context_Erfc, METH_O, GMPy_doc_function_erfc },
@@ -713,12 +782,12 @@ static PyMethodDef Pygmpy_methods [] =
     { "expm1", GMPy_Context_Expm1, METH_O, GMPy_doc_function_expm1 },
     { "exp10", GMPy_Context_Exp10, METH_O, GMPy_doc_function_exp10 },
     { "exp2", GMPy_Context_Exp2, METH_O, GMPy_doc_function_exp2 },
-    { "f2q", GMPy_Context_F2Q, METH_VARARGS, GMPy_doc_function_f2q },
+    { "f2q", (PyCFunction)GMPy_Context_F2Q, GMPY_METH_FASTCALL, GMPy_doc_function_f2q },
     { "factorial", GMPy_Context_Factorial, METH_O, GMPy_doc_function_factorial },
     { "floor", GMPy_Context_Floor, METH_O, GMPy_doc_function_floor },
-    { "fma", GMPy_Context_FMA, METH_VARARGS, GMPy_doc_function_fma },
-    { "fms", GMPy_Context_FMS, METH_VARARGS, GMPy_doc_function_fms },
-    { "fmod", GMPy_Context_Fmod, METH_VARARGS, GMPy_doc_function_fmod },
+    { "fma", (PyCFunction)GMPy_Context_FMA, GMPY_METH_FASTCALL, GMPy_doc_function_fma },
+    { "fms", (PyCFunction)GMPy_Context_FMS, GMPY_METH_FASTCALL, GMPy_doc_function_fms },
+    { "fmod", (PyCFunction)GMPy_Context_Fmod, GMPY_METH_FASTCALL, GMPy_doc_function_fmod },
     { "frac", GMPy_Context_Frac, METH_O, GMPy_doc_function_frac },
     { "free_cache", GMPy_MPFR_Free_Cache, METH_NOARGS, GMPy_doc_mpfr_free_cache },
     { "frexp", GMPy_Context_Frexp, METH_O, GMPy_doc_function_frexp },
@@ -729,19 +798,19 @@ static PyMethodDef Pygmpy_methods [] =
     { "get_emin_min", GMPy_MPFR_get_emin_min, METH_NOARGS, GMPy_doc_mpfr_get_emin_min },
     { "get_exp", GMPy_MPFR_get_exp, METH_O, GMPy_doc_mpfr_get_exp },
     { "get_max_precision", GMPy_MPFR_get_max_precision, METH_NOARGS, GMPy_doc_mpfr_get_max_precision },
-    { "hypot", GMPy_Context_Hypot, METH_VARARGS, GMPy_doc_function_hypot },
+    { "hypot", (PyCFunction)GMPy_Context_Hypot, GMPY_METH_FASTCALL, GMPy_doc_function_hypot },
     { "ieee", GMPy_CTXT_ieee, METH_O, GMPy_doc_context_ieee },
     { "inf", GMPy_MPFR_set_inf, METH_VARARGS, GMPy_doc_mpfr_set_inf },
     { "is_finite", GMPy_Context_Is_Finite, METH_O, GMPy_doc_function_is_finite },
     { "is_infinite", GMPy_Context_Is_Infinite, METH_O, GMPy_doc_function_is_infinite },
     { "is_integer", GMPy_Context_Is_Integer, METH_O, GMPy_doc_function_is_integer },
-    { "is_lessgreater", GMPy_Context_Is_LessGreater, METH_VARARGS, GMPy_doc_function_is_lessgreater },
+    { "is_lessgreater", (PyCFunction)GMPy_Context_Is_LessGreater, GMPY_METH_FASTCALL, GMPy_doc_function_is_lessgreater },
     { "is_nan", GMPy_Context_Is_NAN, METH_O, GMPy_doc_function_is_nan },
     { "is_regular", GMPy_Context_Is_Regular, METH_O, GMPy_doc_function_is_regular },
     { "is_signed", GMPy_Context_Is_Signed, METH_O, GMPy_doc_function_is_signed },
-    { "is_unordered", GMPy_Context_Is_Unordered, METH_VARARGS, GMPy_doc_function_is_unordered },
+    { "is_unordered", (PyCFunction)GMPy_Context_Is_Unordered, GMPY_METH_FASTCALL, GMPy_doc_function_is_unordered },
     { "is_zero", GMPy_Context_Is_Zero, METH_O, GMPy_doc_function_is_zero },
-    { "jn", GMPy_Context_Jn, METH_VARARGS, GMPy_doc_function_jn },
+    { "jn", (PyCFunction)GMPy_Context_Jn, GMPY_METH_FASTCALL, GMPy_doc_function_jn },
     { "j0", GMPy_Context_J0, METH_O, GMPy_doc_function_j0 },
     { "j1", GMPy_Context_J1, METH_O, GMPy_doc_function_j1 },
     { "lgamma", GMPy_Context_Lgamma, METH_O, GMPy_doc_function_lgamma },
@@ -752,36 +821,36 @@ static PyMethodDef Pygmpy_methods [] =
     { "log1p", GMPy_Context_Log1p, METH_O, GMPy_doc_function_log1p },
     { "log10", GMPy_Context_Log10, METH_O, GMPy_doc_function_log10 },
     { "log2", GMPy_Context_Log2, METH_O, GMPy_doc_function_log2 },
-    { "maxnum", GMPy_Context_Maxnum, METH_VARARGS, GMPy_doc_function_maxnum },
-    { "minnum", GMPy_Context_Minnum, METH_VARARGS, GMPy_doc_function_minnum },
+    { "maxnum", (PyCFunction)GMPy_Context_Maxnum, GMPY_METH_FASTCALL, GMPy_doc_function_maxnum },
+    { "minnum", (PyCFunction)GMPy_Context_Minnum, GMPY_METH_FASTCALL, GMPy_doc_function_minnum },
     { "modf", GMPy_Context_Modf, METH_O, GMPy_doc_function_modf },
-    { "mpfr", (PyCFunction)GMPy_MPFR_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpfr_factory },
+    { "mpfr", (PyCFunction)GMPy_MPFR_Factory, GMPY_METH_FASTCALL | METH_KEYWORDS, GMPy_doc_mpfr_factory },
     { "mpfr_from_old_binary", GMPy_MPFR_From_Old_Binary, METH_O, doc_mpfr_from_old_binary },
-    { "mpfr_random", GMPy_MPFR_random_Function, METH_VARARGS, GMPy_doc_mpfr_random_function },
-    { "mpfr_grandom", GMPy_MPFR_grandom_Function, METH_VARARGS, GMPy_doc_mpfr_grandom_function },
-    { "mul_2exp", GMPy_Context_Mul_2exp, METH_VARARGS, GMPy_doc_function_mul_2exp },
+    { "mpfr_random", (PyCFunction)GMPy_MPFR_random_Function, GMPY_METH_FASTCALL, GMPy_doc_mpfr_random_function },
+    { "mpfr_grandom", (PyCFunction)GMPy_MPFR_grandom_Function, GMPY_METH_FASTCALL, GMPy_doc_mpfr_grandom_function },
+    { "mul_2exp", (PyCFunction)GMPy_Context_Mul_2exp, GMPY_METH_FASTCALL, GMPy_doc_function_mul_2exp },
     { "nan", GMPy_MPFR_set_nan, METH_NOARGS, GMPy_doc_mpfr_set_nan },
     { "next_above", GMPy_Context_NextAbove, METH_O, GMPy_doc_function_next_above },
     { "next_below", GMPy_Context_NextBelow, METH_O, GMPy_doc_function_next_below },
-    { "next_toward", GMPy_Context_NextToward, METH_VARARGS, GMPy_doc_function_next_toward },
+    { "next_toward", (PyCFunction)GMPy_Context_NextToward, GMPY_METH_FASTCALL, GMPy_doc_function_next_toward },
     { "radians", GMPy_Context_Radians, METH_O, GMPy_doc_function_radians },
     { "rec_sqrt", GMPy_Context_RecSqrt, METH_O, GMPy_doc_function_rec_sqrt },
-    { "reldiff", GMPy_Context_RelDiff, METH_VARARGS, GMPy_doc_function_reldiff },
-    { "remainder", GMPy_Context_Remainder, METH_VARARGS, GMPy_doc_function_remainder },
-    { "remquo", GMPy_Context_RemQuo, METH_VARARGS, GMPy_doc_function_remquo },
+    { "reldiff", (PyCFunction)GMPy_Context_RelDiff, GMPY_METH_FASTCALL, GMPy_doc_function_reldiff },
+    { "remainder", (PyCFunction)GMPy_Context_Remainder, GMPY_METH_FASTCALL, GMPy_doc_function_remainder },
+    { "remquo", (PyCFunction)GMPy_Context_RemQuo, GMPY_METH_FASTCALL, GMPy_doc_function_remquo },
     { "rint", GMPy_Context_Rint, METH_O, GMPy_doc_function_rint },
     { "rint_ceil", GMPy_Context_RintCeil, METH_O, GMPy_doc_function_rint_ceil },
     { "rint_floor", GMPy_Context_RintFloor, METH_O, GMPy_doc_function_rint_floor },
     { "rint_round", GMPy_Context_RintRound, METH_O, GMPy_doc_function_rint_round },
     { "rint_trunc", GMPy_Context_RintTrunc, METH_O, GMPy_doc_function_rint_trunc },
-    { "root", GMPy_Context_Root, METH_VARARGS, GMPy_doc_function_root },
+    { "root", (PyCFunction)GMPy_Context_Root, GMPY_METH_FASTCALL, GMPy_doc_function_root },
     { "round_away", GMPy_Context_RoundAway, METH_O, GMPy_doc_function_round_away },
-    { "round2", GMPy_Context_Round2, METH_VARARGS, GMPy_doc_function_round2 },
+    { "round2", (PyCFunction)GMPy_Context_Round2, GMPY_METH_FASTCALL, GMPy_doc_function_round2 },
     { "sec", GMPy_Context_Sec, METH_O, GMPy_doc_function_sec },
     { "sech", GMPy_Context_Sech, METH_O, GMPy_doc_function_sech },
     { "set_context", GMPy_CTXT_Set, METH_O, GMPy_doc_set_context },
-    { "set_exp", GMPy_MPFR_set_exp, METH_VARARGS, GMPy_doc_mpfr_set_exp },
-    { "set_sign", GMPy_MPFR_set_sign, METH_VARARGS, GMPy_doc_mpfr_set_sign },
+    { "set_exp", (PyCFunction)GMPy_MPFR_set_exp, GMPY_METH_FASTCALL, GMPy_doc_mpfr_set_exp },
+    { "set_sign", (PyCFunction)GMPy_MPFR_set_sign, GMPY_METH_FASTCALL, GMPy_doc_mpfr_set_sign },
     { "sin", GMPy_Context_Sin, METH_O, GMPy_doc_function_sin },
     { "sin_cos", GMPy_Context_Sin_Cos, METH_O, GMPy_doc_function_sin_cos },
     { "sinh", GMPy_Context_Sinh, METH_O, GMPy_doc_function_sinh },
@@ -790,54 +859,22 @@ static PyMethodDef Pygmpy_methods [] =
     { "tan", GMPy_Context_Tan, METH_O, GMPy_doc_function_tan },
     { "tanh", GMPy_Context_Tanh, METH_O, GMPy_doc_function_tanh },
     { "trunc", GMPy_Context_Trunc, METH_O, GMPy_doc_function_trunc},
-    { "yn", GMPy_Context_Yn, METH_VARARGS, GMPy_doc_function_yn },
+    { "yn", (PyCFunction)GMPy_Context_Yn, GMPY_METH_FASTCALL, GMPy_doc_function_yn },
     { "y0", GMPy_Context_Y0, METH_O, GMPy_doc_function_y0 },
     { "y1", GMPy_Context_Y1, METH_O, GMPy_doc_function_y1 },
     { "zero", GMPy_MPFR_set_zero, METH_VARARGS, GMPy_doc_mpfr_set_zero },
     { "zeta", GMPy_Context_Zeta, METH_O, GMPy_doc_function_zeta },
 
-    { "mpc", (PyCFunction)GMPy_MPC_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpc_factory },
-    { "mpc_random", GMPy_MPC_random_Function, METH_VARARGS, GMPy_doc_mpc_random_function },
+    { "mpc", (PyCFunction)GMPy_MPC_Factory, GMPY_METH_FASTCALL | METH_KEYWORDS, GMPy_doc_mpc_factory },
+    { "mpc_random", (PyCFunction)GMPy_MPC_random_Function, GMPY_METH_FASTCALL, GMPy_doc_mpc_random_function },
     { "norm", GMPy_Context_Norm, METH_O, GMPy_doc_function_norm },
     { "polar", GMPy_Context_Polar, METH_O, GMPy_doc_function_polar },
     { "phase", GMPy_Context_Phase, METH_O, GMPy_doc_function_phase },
     { "proj", GMPy_Context_Proj, METH_O, GMPy_doc_function_proj },
-    { "rect", GMPy_Context_Rect, METH_VARARGS, GMPy_doc_function_rect },
+    { "rect", (PyCFunction)GMPy_Context_Rect, GMPY_METH_FASTCALL, GMPy_doc_function_rect },
     { NULL, NULL, 1}
 };
 
-/* The custom memory allocation routines either use PyMem_* or the standard
- * libraries. See gmpy.h for defines.
- */
-
-static void *
-gmpy_allocate(size_t size)
-{
-    void *res;
-
-    if (!(res = GMPY_MALLOC(size)))
-        Py_FatalError("Insufficient memory");
-
-    return res;
-}
-
-static void *
-gmpy_reallocate(void *ptr, size_t old_size, size_t new_size)
-{
-    void *res;
-
-    if (!(res = GMPY_REALLOC(ptr, new_size)))
-        Py_FatalError("Insufficient memory");
-
-    return res;
-}
-
-static void
-gmpy_free( void *ptr, size_t size)
-{
-    GMPY_FREE(ptr);
-}
-
 static char _gmpy_docs[] =
 "gmpy2 2.1.0a0 - General Multiple-precision arithmetic for Python\n"
 "\n"
@@ -864,6 +901,20 @@ static char _gmpy_docs[] =
 "MPFR and MPC libraries are available.\n\
 ";
 
+/* Return a borrowed reference to the current context. Used by the C API
+ * since GMPy_current_context() does not exist when WITHOUT_THREADS is
+ * defined.
+ */
+
+static CTXT_Object *
+GMPy_CAPI_current_context(void)
+{
+    CTXT_Object *context = NULL;
+
+    CHECK_CONTEXT(context);
+    return context;
+}
+
 /* Notes on Python 3.x support: Full support for PEP-3121 has not been
  * implemented. No per-module state has been defined.
  */
@@ -892,7 +943,6 @@ PyMODINIT_FUNC initgmpy2(void)
 #endif
 {
     PyObject* gmpy_module = NULL;
-    PyObject* copy_reg_module = NULL;
     PyObject *temp = NULL;
 
     /* Validate the sizes of the various typedef'ed integer types. */
@@ -933,6 +983,12 @@ PyMODINIT_FUNC initgmpy2(void)
         INITERROR;
     if (PyType_Ready(&GMPy_Iter_Type) < 0)
         INITERROR;
+    if (PyType_Ready(&GMPy_BinaryIter_Type) < 0)
+        INITERROR;
+#ifdef GMPY_PICKLE_BUFFERS
+    if (PyType_Ready(&GMPy_LimbBuffer_Type) < 0)
+        INITERROR;
+#endif
     if (PyType_Ready(&MPFR_Type) < 0)
         INITERROR;
     if (PyType_Ready(&CTXT_Type) < 0)
@@ -941,17 +997,27 @@ PyMODINIT_FUNC initgmpy2(void)
         INITERROR;
     if (PyType_Ready(&MPC_Type) < 0)
         INITERROR;
+    if (PyType_Ready(&MPZ_Vector_Type) < 0)
+        INITERROR;
+    if (PyType_Ready(&ModContext_Type) < 0)
+        INITERROR;
+    if (PyType_Ready(&FixedBasePow_Type) < 0)
+        INITERROR;
+    if (PyType_Ready(&CRTBasis_Type) < 0)
+        INITERROR;
+    if (PyType_Ready(&MPZTable_Type) < 0)
+        INITERROR;
 
     /* Initialize the custom memory handlers. */
+    if (GMPy_Allocator_Init() < 0)
+        INITERROR;
     mp_set_memory_functions(gmpy_allocate, gmpy_reallocate, gmpy_free);
 
     /* Initialize object caching. */
-    set_zcache();
-    set_gmpympzcache();
-    set_gmpympqcache();
-    set_gmpyxmpzcache();
-    set_gmpympfrcache();
-    set_gmpympccache();
+    if (GMPy_Cache_Init() < 0)
+        INITERROR;
+    if (GMPy_MPZ_Small_Init() < 0)
+        INITERROR;
 
     /* Initialize exceptions. */
     GMPyExc_GmpyError = PyErr_NewException("gmpy2.gmpyError",
@@ -1017,8 +1083,14 @@ PyMODINIT_FUNC initgmpy2(void)
         Py_DECREF(Py_False);
         INITERROR;
     }
+#else
+#ifdef GMPY_CONTEXTVAR
+    current_context_var = PyContextVar_New("gmpy2_context", NULL);
+    if (!current_context_var)
+        INITERROR;
 #else
     tls_context_key = PyUnicode_FromString("__GMPY2_CTX__");
+#endif
     Py_INCREF(Py_True);
     if (PyModule_AddObject(gmpy_module, "HAVE_THREADS", Py_True) < 0) {
         Py_DECREF(Py_True);
@@ -1026,6 +1098,46 @@ PyMODINIT_FUNC initgmpy2(void)
     }
 #endif
 
+    /* Export the C API. */
+#if PY_VERSION_HEX >= 0x02070000
+    GMPy_C_API[GMPy_CAPI_Version_NUM] = (void*)(Py_ssize_t)GMPY2_CAPI_VERSION;
+    GMPy_C_API[MPZ_Type_NUM] = (void*)&MPZ_Type;
+    GMPy_C_API[XMPZ_Type_NUM] = (void*)&XMPZ_Type;
+    GMPy_C_API[MPQ_Type_NUM] = (void*)&MPQ_Type;
+    GMPy_C_API[MPFR_Type_NUM] = (void*)&MPFR_Type;
+    GMPy_C_API[MPC_Type_NUM] = (void*)&MPC_Type;
+    GMPy_C_API[CTXT_Type_NUM] = (void*)&CTXT_Type;
+    GMPy_C_API[GMPy_current_context_NUM] = (void*)GMPy_CAPI_current_context;
+    GMPy_C_API[GMPy_MPZ_New_NUM] = (void*)GMPy_MPZ_New;
+    GMPy_C_API[GMPy_XMPZ_New_NUM] = (void*)GMPy_XMPZ_New;
+    GMPy_C_API[GMPy_MPQ_New_NUM] = (void*)GMPy_MPQ_New;
+    GMPy_C_API[GMPy_MPFR_New_NUM] = (void*)GMPy_MPFR_New;
+    GMPy_C_API[GMPy_MPC_New_NUM] = (void*)GMPy_MPC_New;
+    GMPy_C_API[GMPy_MPZ_From_Integer_NUM] = (void*)GMPy_MPZ_From_Integer;
+    GMPy_C_API[GMPy_MPZ_From_Number_NUM] = (void*)GMPy_MPZ_From_Number;
+    GMPy_C_API[GMPy_MPZ_From_PyStr_NUM] = (void*)GMPy_MPZ_From_PyStr;
+    GMPy_C_API[GMPy_PyIntOrLong_From_MPZ_NUM] = (void*)GMPy_PyIntOrLong_From_MPZ;
+    GMPy_C_API[GMPy_PyStr_From_MPZ_NUM] = (void*)GMPy_PyStr_From_MPZ;
+    GMPy_C_API[GMPy_MPQ_From_Rational_NUM] = (void*)GMPy_MPQ_From_Rational;
+    GMPy_C_API[GMPy_MPQ_From_Number_NUM] = (void*)GMPy_MPQ_From_Number;
+    GMPy_C_API[GMPy_MPQ_From_PyStr_NUM] = (void*)GMPy_MPQ_From_PyStr;
+    GMPy_C_API[GMPy_PyStr_From_MPQ_NUM] = (void*)GMPy_PyStr_From_MPQ;
+    GMPy_C_API[GMPy_MPFR_From_Real_NUM] = (void*)GMPy_MPFR_From_Real;
+    GMPy_C_API[GMPy_MPFR_From_PyStr_NUM] = (void*)GMPy_MPFR_From_PyStr;
+    GMPy_C_API[GMPy_MPZ_From_MPFR_NUM] = (void*)GMPy_MPZ_From_MPFR;
+    GMPy_C_API[GMPy_MPQ_From_MPFR_NUM] = (void*)GMPy_MPQ_From_MPFR;
+    GMPy_C_API[GMPy_PyFloat_From_MPFR_NUM] = (void*)GMPy_PyFloat_From_MPFR;
+    GMPy_C_API[GMPy_PyStr_From_MPFR_NUM] = (void*)GMPy_PyStr_From_MPFR;
+
+    temp = PyCapsule_New((void*)GMPy_C_API, GMPY2_CAPI_NAME, NULL);
+    if (!temp)
+        INITERROR;
+    if (PyModule_AddObject(gmpy_module, "_C_API", temp) < 0) {
+        Py_DECREF(temp);
+        INITERROR;
+    }
+#endif
+
     /* Add the constants for defining rounding modes. */
     if (PyModule_AddIntConstant(gmpy_module, "RoundToNearest", MPFR_RNDN) < 0)
         INITERROR;
@@ -1073,60 +1185,8 @@ PyMODINIT_FUNC initgmpy2(void)
     }
 
     /* Add support for pickling. */
-#ifdef PY3
-    copy_reg_module = PyImport_ImportModule("copyreg");
-    if (copy_reg_module) {
-        char* enable_pickle =
-            "def gmpy2_reducer(x): return (gmpy2.from_binary, (gmpy2.to_binary(x),))\n"
-            "copyreg.pickle(type(gmpy2.mpz(0)), gmpy2_reducer)\n"
-            "copyreg.pickle(type(gmpy2.xmpz(0)), gmpy2_reducer)\n"
-            "copyreg.pickle(type(gmpy2.mpq(0)), gmpy2_reducer)\n"
-            "copyreg.pickle(type(gmpy2.mpfr(0)), gmpy2_reducer)\n"
-            "copyreg.pickle(type(gmpy2.mpc(0,0)), gmpy2_reducer)\n";
-        PyObject* namespace = PyDict_New();
-        PyObject* result = NULL;
-        PyDict_SetItemString(namespace, "copyreg", copy_reg_module);
-        PyDict_SetItemString(namespace, "gmpy2", gmpy_module);
-        PyDict_SetItemString(namespace, "type", (PyObject*)&PyType_Type);
-        result = PyRun_String(enable_pickle, Py_file_input,
-                              namespace, namespace);
-        if (!result)
-            PyErr_Clear();
-        Py_DECREF(namespace);
-        Py_DECREF(copy_reg_module);
-        Py_XDECREF(result);
-    }
-    else {
-        PyErr_Clear();
-    }
-#else
-    copy_reg_module = PyImport_ImportModule("copy_reg");
-    if (copy_reg_module) {
-        char* enable_pickle =
-            "def gmpy2_reducer(x): return (gmpy2.from_binary, (gmpy2.to_binary(x),))\n"
-            "copy_reg.pickle(type(gmpy2.mpz(0)), gmpy2_reducer)\n"
-            "copy_reg.pickle(type(gmpy2.xmpz(0)), gmpy2_reducer)\n"
-            "copy_reg.pickle(type(gmpy2.mpq(0)), gmpy2_reducer)\n"
-            "copy_reg.pickle(type(gmpy2.mpfr(0)), gmpy2_reducer)\n"
-            "copy_reg.pickle(type(gmpy2.mpc(0,0)), gmpy2_reducer)\n";
-        PyObject* namespace = PyDict_New();
-        PyObject* result = NULL;
-
-        PyDict_SetItemString(namespace, "copy_reg", copy_reg_module);
-        PyDict_SetItemString(namespace, "gmpy2", gmpy_module);
-        PyDict_SetItemString(namespace, "type", (PyObject*)&PyType_Type);
-        result = PyRun_String(enable_pickle, Py_file_input,
-                              namespace, namespace);
-        if (!result)
-            PyErr_Clear();
-        Py_DECREF(namespace);
-        Py_DECREF(copy_reg_module);
-        Py_XDECREF(result);
-    }
-    else {
-        PyErr_Clear();
-    }
-#endif
+    if (GMPy_Pickle_Init(gmpy_module) < 0)
+        INITERROR;
 
 #ifdef PY3
     return gmpy_module;
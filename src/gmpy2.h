@@ -167,6 +167,43 @@ typedef unsigned long Py_uhash_t;
  * here. The default value is 100.*/
 #define MAX_CACHE 1000
 
+/* The mpz_t, mpz, and xmpz caches are divided into size classes. Bin k
+ * holds objects with a limb capacity of at least 2**k and less than
+ * 2**(k+1) (bin 0 also holds objects with no limbs allocated). A request
+ * for n limbs searches the first bin that only holds objects with room for
+ * n limbs, and the next GMPY_CACHE_SEARCH bins. The mpfr and mpc caches
+ * use the same bins but only search the bin of the requested precision.
+ */
+#define GMPY_CACHE_BINS 15
+#define GMPY_CACHE_SEARCH 2
+
+typedef struct {
+    int in_cache;            /* number of objects in the bin */
+    int limit;               /* maximum number of objects in the bin */
+    size_t hits;             /* requests satisfied from the bin */
+    size_t misses;           /* requests for the bin that were not satisfied */
+} GMPy_Cache_Bin;
+
+/* GMPY_TLS declares a variable with a separate value in each thread. It is
+ * not defined if the compiler does not support thread-local storage or
+ * Python was built without threads. With glibc, the initial-exec model
+ * avoids a call to __tls_get_addr() for every access; glibc reserves space
+ * for a few such variables in modules that are loaded with dlopen().
+ */
+#ifndef WITHOUT_THREADS
+#  if defined(_MSC_VER)
+#    define GMPY_TLS __declspec(thread)
+#  elif defined(__GLIBC__) && (defined(__GNUC__) || defined(__clang__))
+#    define GMPY_TLS __thread __attribute__((tls_model("initial-exec")))
+#  elif defined(__GNUC__) || defined(__clang__)
+#    define GMPY_TLS __thread
+#  endif
+#endif
+
+#ifdef GMPY_TLS
+#  include "pythread.h"
+#endif
+
 /* Choose which memory manager is used: Python or C.
  * NOTE: The use of PyMem is not compatible with Sage, therefore it is
  *       disabled by default.
@@ -205,6 +242,73 @@ typedef unsigned long Py_uhash_t;
 #  define TEMP_FREE(B, S) GMPY_FREE(B)
 #endif
 
+/* The GIL is released around long running GMP functions when the size of
+ * the operands (in limbs) is at least global.gil_threshold. A threshold of
+ * 0 disables the release of the GIL. Only GMP functions may be called
+ * between GMPY_MAYBE_BEGIN_ALLOW_THREADS and GMPY_MAYBE_END_ALLOW_THREADS;
+ * the object caches and the Python API must not be used. The operands must
+ * not be xmpz instances since another thread could modify them.
+ *
+ * The size passed to GMPY_MAYBE_BEGIN_ALLOW_THREADS is an estimate of the
+ * work required. For mpz_powm, the product of the exponent and modulus
+ * sizes is used.
+ *
+ * NOTE: The GIL is never released when USE_PYMEM is defined.
+ */
+
+#define GMPY_DEFAULT_GIL_THRESHOLD 1024
+
+/* Return the combined size of two mpz operands, or 0 if either operand
+ * may be an xmpz.
+ */
+
+#define GMPY_GIL_SIZE(X, Y) \
+    ((MPZ_Check(X) && MPZ_Check(Y)) ? mpz_size(MPZ(X)) + mpz_size(MPZ(Y)) : 0)
+
+#if defined(WITHOUT_THREADS) || defined(USE_PYMEM)
+#  define GMPY_MAYBE_BEGIN_ALLOW_THREADS(SIZE) {
+#  define GMPY_MAYBE_END_ALLOW_THREADS }
+#else
+#  define GMPY_MAYBE_BEGIN_ALLOW_THREADS(SIZE) \
+    { \
+        PyThreadState *_save = NULL; \
+        if (global.gil_threshold && (size_t)(SIZE) >= (size_t)global.gil_threshold) \
+            _save = PyEval_SaveThread();
+#  define GMPY_MAYBE_END_ALLOW_THREADS \
+        if (_save) \
+            PyEval_RestoreThread(_save); \
+    }
+#endif
+
+/* Use the METH_FASTCALL calling convention when it is available (Python
+ * 3.7 and later). The positional arguments are passed as a C array instead
+ * of a tuple. Functions that are listed with GMPY_METH_FASTCALL are defined
+ * with GMPY_FASTCALL_ARGS and access the arguments with GMPY_NARGS and
+ * GMPY_ARG(i). Functions that also accept keyword arguments are defined
+ * with GMPY_FASTCALL_KWARGS and parse the keywords with
+ * GMPy_ParseArgsAndKeywords(GMPY_FASTCALL_PASS, ...). On older versions of
+ * Python, the same code uses METH_VARARGS.
+ */
+
+#if PY_VERSION_HEX >= 0x03070000
+#  define GMPY_FASTCALL
+#  define GMPY_METH_FASTCALL METH_FASTCALL
+#  define GMPY_FASTCALL_ARGS PyObject * const *args, Py_ssize_t nargs
+#  define GMPY_FASTCALL_KWARGS PyObject * const *args, Py_ssize_t nargs, PyObject *kwnames
+#  define GMPY_FASTCALL_PASS args, nargs, kwnames
+#  define GMPY_NARGS nargs
+#  define GMPY_NKWARGS (kwnames ? PyTuple_GET_SIZE(kwnames) : 0)
+#  define GMPY_ARG(i) (args[i])
+#else
+#  define GMPY_METH_FASTCALL METH_VARARGS
+#  define GMPY_FASTCALL_ARGS PyObject *args
+#  define GMPY_FASTCALL_KWARGS PyObject *args, PyObject *kwnames
+#  define GMPY_FASTCALL_PASS args, kwnames
+#  define GMPY_NARGS PyTuple_GET_SIZE(args)
+#  define GMPY_NKWARGS (kwnames ? PyDict_Size(kwnames) : 0)
+#  define GMPY_ARG(i) PyTuple_GET_ITEM(args, i)
+#endif
+
 /* Various defs to mask differences between Python versions. */
 
 #define Py_RETURN_NOTIMPLEMENTED\
@@ -224,6 +328,7 @@ typedef unsigned long Py_uhash_t;
 #include "mpfr.h"
 #include "mpc.h"
 
+#include "gmpy2_capi.h"
 #include "gmpy2_macros.h"
 
 #include "gmpy2_context.h"
@@ -255,6 +360,10 @@ typedef unsigned long Py_uhash_t;
 #include "gmpy2_convert_mpfr.h"
 #include "gmpy2_convert_mpc.h"
 
+/* Support for the memory functions used by GMP, MPFR, and MPC. */
+
+#include "gmpy2_alloc.h"
+
 /* Support object caching, creation, and deletion. */
 
 #include "gmpy2_cache.h"
@@ -266,6 +375,7 @@ typedef unsigned long Py_uhash_t;
 /* Support conversion to/from binary format. */
 
 #include "gmpy2_binary.h"
+#include "gmpy2_pickle.h"
 
 /* Support random number generators. */
 
@@ -307,6 +417,12 @@ typedef unsigned long Py_uhash_t;
 #include "gmpy2_mpq_misc.h"
 #include "gmpy2_mpz_misc.h"
 #include "gmpy2_xmpz_misc.h"
+#include "gmpy2_mpz_vector.h"
+#include "gmpy2_mpz_tree.h"
+#include "gmpy2_modcontext.h"
+#include "gmpy2_fixedbase.h"
+#include "gmpy2_crt.h"
+#include "gmpy2_mpz_table.h"
 
 #ifdef __cplusplus
 }
@@ -53,7 +53,7 @@
 static PyObject *
 GMPy_Integer_Abs(PyObject *x, CTXT_Object *context)
 {
-    MPZ_Object *result = NULL;
+    MPZ_Object *result = NULL, *tempx;
 
     if (MPZ_Check(x)) {
         if (mpz_sgn(MPZ(x)) >= 0) {
@@ -67,18 +67,19 @@ GMPy_Integer_Abs(PyObject *x, CTXT_Object *context)
         }
     }
 
-    /* This is safe because result is not an incremented reference to an
-     * existing value. Why?
-     *   1) No values are interned like Python's integers.
-     *   2) MPZ is already handled so GMPy_MPZ_From_Integer() can't return
-     *      an incremented reference to an existing value (which it would do
-     *      if passed an MPZ).
+    /* GMPy_MPZ_From_Integer() may return an interned value, so it must not
+     * be modified.
      */
 
-    if ((result = GMPy_MPZ_From_Integer(x, context))) {
-        mpz_abs(result->z, result->z);
-    }
+    if (!(tempx = GMPy_MPZ_From_Integer(x, context)))
+        return NULL;
 
+    if (mpz_sgn(tempx->z) >= 0)
+        return (PyObject*)tempx;
+
+    if ((result = GMPy_MPZ_New(context)))
+        mpz_abs(result->z, tempx->z);
+    Py_DECREF((PyObject*)tempx);
     return (PyObject*)result;
 }
 
@@ -60,8 +60,14 @@ static PyObject *
 GMPy_Integer_Add(PyObject *x, PyObject *y, CTXT_Object *context)
 {
     MPZ_Object *result;
+    long a, b, r;
 
-    if (!(result = GMPy_MPZ_New(context)))
+    if (GMPy_Integer_AsWord(x, &a) && GMPy_Integer_AsWord(y, &b) &&
+        !GMPY_ADD_OVERFLOW(a, b, &r)) {
+        return (PyObject*)GMPy_MPZ_From_SI(r, context);
+    }
+
+    if (!(result = GMPy_MPZ_NewSize(GMPY_ADD_SIZE(x, y), context)))
         return NULL;
 
     if (CHECK_MPZANY(x)) {
@@ -151,8 +157,14 @@ GMPy_MPZ_Add_Slot(PyObject *x, PyObject *y)
 {
     if (CHECK_MPZANY(x) && CHECK_MPZANY(y)) {
         MPZ_Object *result;
+        long a, b, r;
+
+        if (GMPy_Integer_AsWord(x, &a) && GMPy_Integer_AsWord(y, &b) &&
+            !GMPY_ADD_OVERFLOW(a, b, &r)) {
+            return (PyObject*)GMPy_MPZ_From_SI(r, NULL);
+        }
 
-        if ((result = GMPy_MPZ_New(NULL))) {
+        if ((result = GMPy_MPZ_NewSize(GMPY_ADD_SIZE(x, y), NULL))) {
             mpz_add(result->z, MPZ(x), MPZ(y));
         }
         return (PyObject*)result;
@@ -491,11 +503,11 @@ PyDoc_STRVAR(GMPy_doc_context_add,
 "Return x + y.");
 
 static PyObject *
-GMPy_Context_Add(PyObject *self, PyObject *args)
+GMPy_Context_Add(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("add() requires 2 arguments.");
         return NULL;
     }
@@ -507,6 +519,6 @@ GMPy_Context_Add(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Add(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context);
+    return GMPy_Number_Add(GMPY_ARG(0), GMPY_ARG(1), context);
 }
 
@@ -0,0 +1,396 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_alloc.c                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* This file contains the memory functions used by GMP, MPFR, and MPC, and
+ * the optional per-thread arena allocator (see gmpy2_alloc.h).
+ */
+
+static int gmpy_allocator = GMPY_ALLOCATOR_SYSTEM;
+
+#ifdef GMPY_HAVE_ARENA
+
+static GMPY_TLS GMPy_Arena *gmpy_arena = NULL;
+
+/* All live arenas, and the counters of the arenas of threads that have
+ * exited. Both are protected by gmpy_arena_lock.
+ */
+static GMPy_Arena *gmpy_arena_list = NULL;
+static GMPy_Arena gmpy_arena_retired;
+static PyThread_type_lock gmpy_arena_lock = NULL;
+
+#ifdef _WIN32
+static DWORD gmpy_arena_key = FLS_OUT_OF_INDEXES;
+#else
+static pthread_key_t gmpy_arena_key;
+#endif
+
+/* Return the free list used for a block of size bytes, or -1 if blocks of
+ * that size are not cached.
+ */
+#define GMPY_ARENA_CLASS(size) \
+    (((size) >= sizeof(void*) && (size) % sizeof(mp_limb_t) == 0 && \
+      (size) <= GMPY_ARENA_CLASSES * sizeof(mp_limb_t)) ? \
+     (int)((size) / sizeof(mp_limb_t)) - 1 : -1)
+
+/* Remove a block from free list k. The list must not be empty. */
+
+static void *
+GMPy_Arena_Pop(GMPy_Arena *arena, int k, size_t size)
+{
+    void *res = arena->head[k];
+
+    arena->head[k] = *(void**)res;
+    arena->count[k]--;
+    arena->bytes -= size;
+    return res;
+}
+
+/* Add a block of size bytes to the matching free list. Returns 0 if the
+ * block cannot be cached.
+ */
+
+static int
+GMPy_Arena_Push(GMPy_Arena *arena, void *ptr, size_t size)
+{
+    int k = GMPY_ARENA_CLASS(size);
+
+    if (k < 0 || arena->count[k] >= GMPY_ARENA_DEPTH ||
+        arena->bytes + size > GMPY_ARENA_MAX_BYTES)
+        return 0;
+
+    *(void**)ptr = arena->head[k];
+    arena->head[k] = ptr;
+    arena->count[k]++;
+    arena->bytes += size;
+    return 1;
+}
+
+/* Return all the cached blocks to the system allocator. */
+
+static void
+GMPy_Arena_Flush(GMPy_Arena *arena)
+{
+    void *ptr;
+    int k;
+
+    for (k = 0; k < GMPY_ARENA_CLASSES; k++) {
+        while ((ptr = arena->head[k])) {
+            arena->head[k] = *(void**)ptr;
+            GMPY_FREE(ptr);
+        }
+        arena->count[k] = 0;
+    }
+    arena->bytes = 0;
+}
+
+/* Called when a thread that used the arena allocator exits. */
+
+static void
+GMPy_Arena_Release(void *ptr)
+{
+    GMPy_Arena *arena = (GMPy_Arena*)ptr;
+
+    if (!arena)
+        return;
+
+    GMPy_Arena_Flush(arena);
+
+    PyThread_acquire_lock(gmpy_arena_lock, WAIT_LOCK);
+    if (arena->prev)
+        arena->prev->next = arena->next;
+    else
+        gmpy_arena_list = arena->next;
+    if (arena->next)
+        arena->next->prev = arena->prev;
+    gmpy_arena_retired.allocs += arena->allocs;
+    gmpy_arena_retired.reallocs += arena->reallocs;
+    gmpy_arena_retired.frees += arena->frees;
+    gmpy_arena_retired.hits += arena->hits;
+    gmpy_arena_retired.misses += arena->misses;
+    PyThread_release_lock(gmpy_arena_lock);
+
+    if (gmpy_arena == arena)
+        gmpy_arena = NULL;
+    free(arena);
+}
+
+#ifdef _WIN32
+static VOID WINAPI
+GMPy_Arena_Release_Callback(PVOID ptr)
+{
+    GMPy_Arena_Release(ptr);
+}
+#endif
+
+/* Return the arena of the current thread, creating it if needed. Returns
+ * NULL if the arena cannot be created; the caller then uses the system
+ * allocator. The Python API is not used so this can be called without
+ * holding the GIL.
+ */
+
+static GMPy_Arena *
+GMPy_Arena_Get(void)
+{
+    GMPy_Arena *arena;
+
+    if ((arena = gmpy_arena))
+        return arena;
+
+    if (!(arena = calloc(1, sizeof(GMPy_Arena))))
+        return NULL;
+
+#ifdef _WIN32
+    if (!FlsSetValue(gmpy_arena_key, arena)) {
+        free(arena);
+        return NULL;
+    }
+#else
+    if (pthread_setspecific(gmpy_arena_key, arena)) {
+        free(arena);
+        return NULL;
+    }
+#endif
+
+    PyThread_acquire_lock(gmpy_arena_lock, WAIT_LOCK);
+    arena->next = gmpy_arena_list;
+    if (gmpy_arena_list)
+        gmpy_arena_list->prev = arena;
+    gmpy_arena_list = arena;
+    PyThread_release_lock(gmpy_arena_lock);
+
+    gmpy_arena = arena;
+    return arena;
+}
+
+#endif /* GMPY_HAVE_ARENA */
+
+static void *
+gmpy_allocate(size_t size)
+{
+    void *res;
+
+#ifdef GMPY_HAVE_ARENA
+    GMPy_Arena *arena;
+    int k;
+
+    if (gmpy_allocator == GMPY_ALLOCATOR_ARENA && (arena = GMPy_Arena_Get())) {
+        arena->allocs++;
+        if ((k = GMPY_ARENA_CLASS(size)) >= 0 && arena->head[k]) {
+            arena->hits++;
+            return GMPy_Arena_Pop(arena, k, size);
+        }
+        arena->misses++;
+    }
+#endif
+
+    if (!(res = GMPY_MALLOC(size)))
+        Py_FatalError("Insufficient memory");
+
+    return res;
+}
+
+static void *
+gmpy_reallocate(void *ptr, size_t old_size, size_t new_size)
+{
+    void *res;
+
+#ifdef GMPY_HAVE_ARENA
+    GMPy_Arena *arena;
+    int k;
+
+    if (gmpy_allocator == GMPY_ALLOCATOR_ARENA && (arena = GMPy_Arena_Get())) {
+        arena->reallocs++;
+        if ((k = GMPY_ARENA_CLASS(new_size)) >= 0 && arena->head[k]) {
+            arena->hits++;
+            res = GMPy_Arena_Pop(arena, k, new_size);
+            memcpy(res, ptr, old_size < new_size ? old_size : new_size);
+            if (!GMPy_Arena_Push(arena, ptr, old_size))
+                GMPY_FREE(ptr);
+            return res;
+        }
+        arena->misses++;
+    }
+#endif
+
+    if (!(res = GMPY_REALLOC(ptr, new_size)))
+        Py_FatalError("Insufficient memory");
+
+    return res;
+}
+
+static void
+gmpy_free(void *ptr, size_t size)
+{
+#ifdef GMPY_HAVE_ARENA
+    GMPy_Arena *arena = gmpy_arena;
+
+    if (gmpy_allocator == GMPY_ALLOCATOR_ARENA) {
+        if (arena || (arena = GMPy_Arena_Get())) {
+            arena->frees++;
+            if (GMPy_Arena_Push(arena, ptr, size))
+                return;
+        }
+    }
+    else if (arena && arena->bytes) {
+        /* The arena allocator was disabled by another thread. */
+        GMPy_Arena_Flush(arena);
+    }
+#endif
+
+    GMPY_FREE(ptr);
+}
+
+/* Prepare the allocator before the memory functions are installed. The
+ * arena allocator is enabled if the environment variable GMPY2_ALLOCATOR
+ * is set to "arena". Returns -1 (with an exception set) on failure.
+ */
+
+static int
+GMPy_Allocator_Init(void)
+{
+#ifdef GMPY_HAVE_ARENA
+    const char *name;
+
+    if (!(gmpy_arena_lock = PyThread_allocate_lock())) {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+#ifdef _WIN32
+    if ((gmpy_arena_key = FlsAlloc(GMPy_Arena_Release_Callback)) == FLS_OUT_OF_INDEXES) {
+#else
+    if (pthread_key_create(&gmpy_arena_key, GMPy_Arena_Release)) {
+#endif
+        SYSTEM_ERROR("could not create the thread-local key for the allocator");
+        return -1;
+    }
+
+    if ((name = getenv("GMPY2_ALLOCATOR")) && !strcmp(name, "arena"))
+        gmpy_allocator = GMPY_ALLOCATOR_ARENA;
+#endif
+
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_get_allocator,
+"get_allocator() -> str\n\n\
+Return the name of the allocator used for the limbs of all gmpy2 objects:\n\
+'system' or 'arena'.");
+
+static PyObject *
+GMPy_get_allocator(PyObject *self, PyObject *args)
+{
+    return Py_BuildValue("s", gmpy_allocator == GMPY_ALLOCATOR_ARENA ? "arena" : "system");
+}
+
+PyDoc_STRVAR(GMPy_doc_set_allocator,
+"set_allocator(name)\n\n\
+Select the allocator used for the limbs of gmpy2 objects. 'system' uses\n\
+malloc() and free(). 'arena' keeps a cache of freed blocks of up to 128\n\
+limbs in a separate arena for each thread. The allocator can also be\n\
+selected at import by setting the environment variable GMPY2_ALLOCATOR.\n\
+Raises ValueError if the arena allocator is not available.");
+
+static PyObject *
+GMPy_set_allocator(PyObject *self, PyObject *other)
+{
+    const char *name;
+
+    if (!PyArg_Parse(other, "s", &name))
+        return NULL;
+
+    if (!strcmp(name, "system")) {
+        gmpy_allocator = GMPY_ALLOCATOR_SYSTEM;
+#ifdef GMPY_HAVE_ARENA
+        /* Other threads release their cached blocks on their next call to
+         * gmpy_free() or when they exit.
+         */
+        if (gmpy_arena)
+            GMPy_Arena_Flush(gmpy_arena);
+#endif
+    }
+    else if (!strcmp(name, "arena")) {
+#ifdef GMPY_HAVE_ARENA
+        gmpy_allocator = GMPY_ALLOCATOR_ARENA;
+#else
+        VALUE_ERROR("the arena allocator is not available");
+        return NULL;
+#endif
+    }
+    else {
+        VALUE_ERROR("allocator must be 'system' or 'arena'");
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(GMPy_doc_allocator_stats,
+"allocator_stats() -> dict\n\n\
+Return statistics for the arena allocator, summed over all threads:\n\
+the number of live arenas, the number of calls to allocate, reallocate,\n\
+and free memory, the number of requests served from ('hits') or passed\n\
+to ('misses') the system allocator, and the number of bytes cached. The\n\
+counts of threads that are running are approximate.");
+
+static PyObject *
+GMPy_allocator_stats(PyObject *self, PyObject *args)
+{
+    size_t arenas = 0;
+    GMPy_Arena total;
+#ifdef GMPY_HAVE_ARENA
+    GMPy_Arena *arena;
+#endif
+
+    memset(&total, 0, sizeof(total));
+
+#ifdef GMPY_HAVE_ARENA
+    PyThread_acquire_lock(gmpy_arena_lock, WAIT_LOCK);
+    total = gmpy_arena_retired;
+    for (arena = gmpy_arena_list; arena; arena = arena->next) {
+        arenas++;
+        total.allocs += arena->allocs;
+        total.reallocs += arena->reallocs;
+        total.frees += arena->frees;
+        total.hits += arena->hits;
+        total.misses += arena->misses;
+        total.bytes += arena->bytes;
+    }
+    PyThread_release_lock(gmpy_arena_lock);
+#endif
+
+    return Py_BuildValue("{sssnsnsnsnsnsnsn}",
+                         "allocator",
+                         gmpy_allocator == GMPY_ALLOCATOR_ARENA ? "arena" : "system",
+                         "arenas", (Py_ssize_t)arenas,
+                         "allocations", (Py_ssize_t)total.allocs,
+                         "reallocations", (Py_ssize_t)total.reallocs,
+                         "frees", (Py_ssize_t)total.frees,
+                         "hits", (Py_ssize_t)total.hits,
+                         "misses", (Py_ssize_t)total.misses,
+                         "cached_bytes", (Py_ssize_t)total.bytes);
+}
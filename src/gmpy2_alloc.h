@@ -0,0 +1,88 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_alloc.h                                                           *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef GMPY_ALLOC_H
+#define GMPY_ALLOC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* gmpy2 installs its own memory functions for GMP, MPFR, and MPC. The
+ * "system" allocator passes every request to GMPY_MALLOC, GMPY_REALLOC, and
+ * GMPY_FREE. The optional "arena" allocator keeps a free list for each
+ * block size of 1 to GMPY_ARENA_CLASSES limbs in a separate arena for each
+ * thread, so most limb allocations do not reach the system allocator and
+ * threads that run with the GIL released do not contend for it.
+ *
+ * A freed block is only reused for a request of exactly the same size, so
+ * blocks allocated before the arena was enabled (or by other users of GMP)
+ * can safely be placed on the free lists.
+ */
+
+#if defined(GMPY_TLS) && !defined(USE_PYMEM)
+#  define GMPY_HAVE_ARENA 1
+#  ifdef _WIN32
+#    include <windows.h>
+#  else
+#    include <pthread.h>
+#  endif
+#endif
+
+#define GMPY_ALLOCATOR_SYSTEM 0
+#define GMPY_ALLOCATOR_ARENA  1
+
+#define GMPY_ARENA_CLASSES    128       /* largest cached block in limbs */
+#define GMPY_ARENA_DEPTH      32        /* maximum blocks in each free list */
+#define GMPY_ARENA_MAX_BYTES  (1 << 20) /* maximum bytes cached by each thread */
+
+typedef struct GMPy_Arena {
+    void *head[GMPY_ARENA_CLASSES];     /* free list for each block size */
+    int count[GMPY_ARENA_CLASSES];      /* length of each free list */
+    size_t bytes;                       /* bytes held in the free lists */
+    size_t allocs;                      /* calls to allocate */
+    size_t reallocs;                    /* calls to reallocate */
+    size_t frees;                       /* calls to free */
+    size_t hits;                        /* requests served from a free list */
+    size_t misses;                      /* requests passed to the system */
+    struct GMPy_Arena *prev, *next;     /* list of all arenas */
+} GMPy_Arena;
+
+static void *     gmpy_allocate(size_t size);
+static void *     gmpy_reallocate(void *ptr, size_t old_size, size_t new_size);
+static void       gmpy_free(void *ptr, size_t size);
+static int        GMPy_Allocator_Init(void);
+
+static PyObject * GMPy_get_allocator(PyObject *self, PyObject *args);
+static PyObject * GMPy_set_allocator(PyObject *self, PyObject *other);
+static PyObject * GMPy_allocator_stats(PyObject *self, PyObject *args);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
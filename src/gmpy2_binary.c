@@ -30,6 +30,22 @@
  * with GMPY 1.x. Methods to read the old format are provided.
  */
 
+/* Return -1 if the limbs are stored little-endian and 1 if they are
+ * stored big-endian, as for the endian argument of mpz_import().
+ */
+
+static int
+GMPy_Limb_Endian(void)
+{
+    union {
+        mp_limb_t limb;
+        unsigned char bytes[sizeof(mp_limb_t)];
+    } test;
+
+    test.limb = 1;
+    return test.bytes[0] ? -1 : 1;
+}
+
 /* Provide functions to access the old binary formats. */
 
 PyDoc_STRVAR(doc_mpz_from_old_binary,
@@ -233,67 +249,53 @@ GMPy_MPFR_From_Old_Binary(PyObject *self, PyObject *other)
  * byte[2]+: value
  */
 
-static PyObject *
-GMPy_MPZ_To_Binary(MPZ_Object *self)
-{
-    size_t size = 2;
-    int sgn;
-    char *buffer;
-    PyObject *result;
+/* The size and writer functions are shared by to_binary() and
+ * to_binary_many(), which writes the records directly into its output.
+ */
 
-    sgn = mpz_sgn(self->z);
-    if (sgn == 0) {
-        TEMP_ALLOC(buffer, size);
-        buffer[0] = 0x01;
-        buffer[1] = 0x00;
-        goto done;
-    }
+static size_t
+GMPy_MPZ_Binary_Size(mpz_srcptr z)
+{
+    if (mpz_sgn(z) == 0)
+        return 2;
+    return ((mpz_sizeinbase(z, 2) + 7) / 8) + 2;
+}
 
-    size = ((mpz_sizeinbase(self->z, 2) + 7) / 8) + 2;
+static void
+GMPy_MPZ_Binary_Write(char *buffer, char tag, mpz_srcptr z)
+{
+    int sgn = mpz_sgn(z);
 
-    TEMP_ALLOC(buffer, size);
-    buffer[0] = 0x01;
-    if (sgn > 0)
+    buffer[0] = tag;
+    if (sgn == 0)
+        buffer[1] = 0x00;
+    else if (sgn > 0)
         buffer[1] = 0x01;
     else
         buffer[1] = 0x02;
-    mpz_export(buffer+2, NULL, -1, sizeof(char), 0, 0, self->z);
-
-  done:
-    result = PyBytes_FromStringAndSize(buffer, size);
-    TEMP_FREE(buffer, size);
-    return result;
+    if (sgn != 0)
+        mpz_export(buffer+2, NULL, -1, sizeof(char), 0, 0, z);
 }
 
 static PyObject *
-GMPy_XMPZ_To_Binary(XMPZ_Object *self)
+GMPy_MPZ_To_Binary(MPZ_Object *self)
 {
-    size_t size = 2;
-    int sgn;
-    char *buffer;
     PyObject *result;
 
-    sgn = mpz_sgn(self->z);
-    if (sgn == 0) {
-        TEMP_ALLOC(buffer, size);
-        buffer[0] = 0x02;
-        buffer[1] = 0x00;
-        goto done;
-    }
+    /* Export directly into the bytes object to avoid a second copy. */
 
-    size = ((mpz_sizeinbase(self->z, 2) + 7) / 8) + 2;
+    if ((result = PyBytes_FromStringAndSize(NULL, GMPy_MPZ_Binary_Size(self->z))))
+        GMPy_MPZ_Binary_Write(PyBytes_AS_STRING(result), 0x01, self->z);
+    return result;
+}
 
-    TEMP_ALLOC(buffer, size);
-    buffer[0] = 0x02;
-    if (sgn > 0)
-        buffer[1] = 0x01;
-    else
-        buffer[1] = 0x02;
-    mpz_export(buffer+2, NULL, -1, sizeof(char), 0, 0, self->z);
+static PyObject *
+GMPy_XMPZ_To_Binary(XMPZ_Object *self)
+{
+    PyObject *result;
 
-  done:
-    result = PyBytes_FromStringAndSize(buffer, size);
-    TEMP_FREE(buffer, size);
+    if ((result = PyBytes_FromStringAndSize(NULL, GMPy_MPZ_Binary_Size(self->z))))
+        GMPy_MPZ_Binary_Write(PyBytes_AS_STRING(result), 0x02, self->z);
     return result;
 }
 
@@ -314,36 +316,43 @@ GMPy_XMPZ_To_Binary(XMPZ_Object *self)
  * byte[2+n]+:  numerator, followed by denominator
  */
 
-static PyObject *
-GMPy_MPQ_To_Binary(MPQ_Object *self)
+static size_t
+GMPy_MPQ_Binary_Size(mpq_srcptr q)
+{
+    size_t sizenum, sizeden;
+
+    if (mpq_sgn(q) == 0)
+        return 2;
+
+    sizenum = (mpz_sizeinbase(mpq_numref(q), 2) + 7) / 8;
+    sizeden = (mpz_sizeinbase(mpq_denref(q), 2) + 7) / 8;
+
+    /* Check if sizenum larger than 32 bits. */
+    if ((sizenum >> 16) >> 16)
+        return sizenum + sizeden + 2 + 8;
+    return sizenum + sizeden + 2 + 4;
+}
+
+static void
+GMPy_MPQ_Binary_Write(char *buffer, mpq_srcptr q)
 {
-    size_t sizenum, sizeden, sizesize = 4, size = 2, sizetemp, i;
-    size_t count = 0;
+    size_t sizenum, sizesize = 4, sizetemp, i;
     int sgn;
-    char *buffer, large = 0x00;
-    PyObject *result = 0;
+    char large = 0x00;
 
-    sgn = mpq_sgn(self->q);
+    buffer[0] = 0x03;
+    sgn = mpq_sgn(q);
     if (sgn == 0) {
-        TEMP_ALLOC(buffer, size);
-        buffer[0] = 0x03;
         buffer[1] = 0x00;
-        goto done;
+        return;
     }
 
-    sizenum = (mpz_sizeinbase(mpq_numref(self->q), 2) + 7) / 8;
-    sizeden = (mpz_sizeinbase(mpq_denref(self->q), 2) + 7) / 8;
-    size = sizenum + sizeden + 2;
-
-    /* Check if sizenum larger than 32 bits. */
+    sizenum = (mpz_sizeinbase(mpq_numref(q), 2) + 7) / 8;
     if ((sizenum >> 16) >> 16) {
         large = 0x04;
         sizesize = 8;
     }
-    size += sizesize;
 
-    TEMP_ALLOC(buffer, size);
-    buffer[0] = 0x03;
     if (sgn > 0)
         buffer[1] = 0x01 | large;
     else
@@ -356,26 +365,19 @@ GMPy_MPQ_To_Binary(MPQ_Object *self)
         sizetemp >>= 8;
     }
 
-    mpz_export(buffer+sizesize+2, &count, -1,
-               sizeof(char), 0, 0, mpq_numref(self->q));
-    if (count != sizenum) {
-        SYSTEM_ERROR("internal error in Pympq_To_Binary");
-        TEMP_FREE(buffer, size);
-        return NULL;
-    }
-    count = 0;
-    mpz_export(buffer+sizenum+sizesize+2, &count, -1,
-               sizeof(char), 0, 0, mpq_denref(self->q));
-    if (count != sizeden) {
-        SYSTEM_ERROR("internal error in Pympq_To_Binary");
-        TEMP_FREE(buffer, size);
-        return NULL;
-    }
+    mpz_export(buffer+sizesize+2, NULL, -1,
+               sizeof(char), 0, 0, mpq_numref(q));
+    mpz_export(buffer+sizenum+sizesize+2, NULL, -1,
+               sizeof(char), 0, 0, mpq_denref(q));
+}
 
+static PyObject *
+GMPy_MPQ_To_Binary(MPQ_Object *self)
+{
+    PyObject *result;
 
-  done:
-    result = PyBytes_FromStringAndSize(buffer, size);
-    TEMP_FREE(buffer, size);
+    if ((result = PyBytes_FromStringAndSize(NULL, GMPy_MPQ_Binary_Size(self->q))))
+        GMPy_MPQ_Binary_Write(PyBytes_AS_STRING(result), self->q);
     return result;
 }
 
@@ -627,8 +629,6 @@ PyDoc_STRVAR(doc_from_binary,
 static PyObject *
 GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
 {
-    unsigned char *buffer, *cp;
-    Py_ssize_t len;
     CTXT_Object *context = NULL;
 
     CHECK_CONTEXT(context);
@@ -638,12 +638,73 @@ GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
         return NULL;
     }
 
-    len = PyBytes_Size(other);
+    return GMPy_MPANY_From_Binary_Record((unsigned char*)PyBytes_AS_STRING(other),
+                                         PyBytes_GET_SIZE(other), context);
+}
+
+/* Check the mpfr value at the start of a 0x04 record, or at the start of
+ * either part of a 0x05 record. Returns the number of bytes it uses, or 0
+ * with an exception set if it does not fit in avail bytes or the precision
+ * is out of range. A special value stores no mantissa, so its precision
+ * must not exceed GMPY_MAX_RECORD_PREC.
+ */
+
+static size_t
+GMPy_MPFR_Record_Size(const unsigned char *cp, size_t avail)
+{
+    size_t sizesize = 4, limbsize = 4, i, size;
+    unsigned PY_LONG_LONG precision = 0;
+
+    if (avail < 4)
+        goto tooshort;
+    if (cp[1] & 0x04) sizesize = 8;
+    if (avail < 4 + sizesize)
+        goto tooshort;
+
+    for (i=sizesize; i>0; --i) {
+        precision = (precision << 8) + cp[i+3];
+    }
+    if (precision > (unsigned PY_LONG_LONG)MPFR_PREC_MAX) {
+        VALUE_ERROR("byte sequence invalid for from_binary()");
+        return 0;
+    }
+
+    /* Special values do not store an exponent or a mantissa. */
+    if (!(cp[1] & 0x01)) {
+        if (precision > (unsigned PY_LONG_LONG)GMPY_MAX_RECORD_PREC) {
+            VALUE_ERROR("byte sequence invalid for from_binary()");
+            return 0;
+        }
+        size = 4 + sizesize;
+    }
+    else {
+        if (cp[1] & 0x40) limbsize = 8;
+        size = 4 + 2 * sizesize +
+               limbsize * (size_t)((precision + 8 * limbsize - 1) / (8 * limbsize));
+    }
+    if (avail < size)
+        goto tooshort;
+    return size;
+
+  tooshort:
+    VALUE_ERROR("byte sequence too short for from_binary()");
+    return 0;
+}
+
+/* Decode a single record of len bytes. Used by from_binary() and by the
+ * bulk readers.
+ */
+
+static PyObject *
+GMPy_MPANY_From_Binary_Record(unsigned char *buffer, Py_ssize_t len,
+                              CTXT_Object *context)
+{
+    unsigned char *cp;
+
     if (len < 2) {
         VALUE_ERROR("byte sequence too short for from_binary()");
         return NULL;
     }
-    buffer = (unsigned char*)PyBytes_AsString(other);
     cp = buffer;
 
     switch (cp[0]) {
@@ -691,8 +752,9 @@ GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
             if (cp[1] & 0x04)
                 sizesize = 8;
 
-            if (len < 2 + sizesize) {
+            if (len < 3 + sizesize) {
                 VALUE_ERROR("byte sequence too short for from_binary()");
+                Py_DECREF((PyObject*)result);
                 return NULL;
             }
 
@@ -700,8 +762,9 @@ GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
                 numlen = (numlen << 8) + cp[i+1];
             }
 
-            if (len < 2 + sizesize + numlen + 1) {
+            if (numlen > (size_t)len - 2 - sizesize - 1) {
                 VALUE_ERROR("byte sequence too short for from_binary()");
+                Py_DECREF((PyObject*)result);
                 return NULL;
             }
 
@@ -711,6 +774,13 @@ GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
                        sizeof(char), 0, 0, cp+sizesize+2);
             mpz_import(den, len-numlen-sizesize-2, -1,
                        sizeof(char), 0, 0, cp+sizesize+numlen+2);
+            if (mpz_sgn(den) == 0) {
+                mpz_cloc(num);
+                mpz_cloc(den);
+                VALUE_ERROR("byte sequence invalid for from_binary()");
+                Py_DECREF((PyObject*)result);
+                return NULL;
+            }
             mpq_set_num(result->q, num);
             mpq_set_den(result->q, den);
             mpq_canonicalize(result->q);
@@ -731,10 +801,8 @@ GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
             int sgn = 1, expsgn = 1, limbsize = 4;
             int newlimbsize = (mp_bits_per_limb >> 3);
 
-            if (len < 4) {
-                VALUE_ERROR("byte sequence too short for from_binary()");
+            if (!GMPy_MPFR_Record_Size(cp, (size_t)len))
                 return NULL;
-            }
 
             /* Get size of values. */
             if (cp[1] & 0x04) sizesize = 8;
@@ -789,11 +857,6 @@ GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
                 exponent = (exponent << 8) + cp[i];
             }
 
-            if (len < 2 + sizesize) {
-                VALUE_ERROR("byte sequence too short for from_binary()");
-                return NULL;
-            }
-
             /* Check if the mantissa occupies the same number of bytes
              * on both the source and target system. */
             if (limbsize * sizemant == newmant * newlimbsize) {
@@ -900,10 +963,8 @@ GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
             int newlimbsize = (mp_bits_per_limb >> 3);
             unsigned char *tempbuf;
 
-            if (len < 4) {
-                VALUE_ERROR("byte sequence too short for from_binary()");
+            if (!GMPy_MPFR_Record_Size(cp, (size_t)len))
                 return NULL;
-            }
             /* read the real part first */
             if (cp[1] & 0x04) sizesize = 8;
             for (i=sizesize; i>0; --i) {
@@ -1024,6 +1085,10 @@ GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
             limbsize = 4;
 
             /* Done reading the real part. The next byte should be 0x05. */
+            if (!GMPy_MPFR_Record_Size(cp, (size_t)(len - (cp - buffer)))) {
+                Py_DECREF((PyObject*)real);
+                return NULL;
+            }
             if (!(cp[0] == 0x05)) {
                 VALUE_ERROR("byte sequence invalid for from_binary()");
                 Py_DECREF((PyObject*)real);
@@ -1036,8 +1101,10 @@ GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
             if (cp[1] & 0x02) sgn = -1;
             if (cp[1] & 0x20) expsgn = -1;
             if (cp[1] & 0x40) limbsize = 8;
-            if (!(imag = GMPy_MPFR_New(precision, context)))
+            if (!(imag = GMPy_MPFR_New(precision, context))) {
+                Py_DECREF((PyObject*)real);
                 return NULL;
+            }
             if (cp[2] == 0)      imag->rc = 0;
             else if (cp[2] == 1) imag->rc = 1;
             else                 imag->rc = -1;
@@ -1148,6 +1215,11 @@ GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
             Py_DECREF((PyObject*)imag);
             return (PyObject*)result;
         }
+        case 0x06:
+        case 0x07:
+        case 0x08:
+        case 0x09:
+            return GMPy_MPANY_From_Compact_Record(buffer, len, context);
         default: {
             TYPE_ERROR("from_binary() argument type not supported");
             return NULL;
@@ -1155,13 +1227,7 @@ GMPy_MPANY_From_Binary(PyObject *self, PyObject *other)
     }
 }
 
-PyDoc_STRVAR(doc_to_binary,
-"to_binary(x) -> bytes\n"
-"Return a Python byte sequence that is a portable binary\n"
-"representation of a gmpy2 object x. The byte sequence can\n"
-"be passed to gmpy2.from_binary() to obtain an exact copy of\n"
-"x's value. Works with mpz, xmpz, mpq, mpfr, and mpc types. \n"
-"Raises TypeError if x is not a gmpy2 object.");
+/* Return the regular record for x. Used by to_binary() and pickling. */
 
 static PyObject *
 GMPy_MPANY_To_Binary(PyObject *self, PyObject *other)
@@ -1180,3 +1246,1187 @@ GMPy_MPANY_To_Binary(PyObject *self, PyObject *other)
     return NULL;
 }
 
+
+/* Zero-copy access to the limbs of an mpz. An mpz is immutable, so it can
+ * export its limb array directly as a read-only buffer; the view keeps a
+ * reference to the mpz so the limbs stay valid until the buffer is
+ * released. The shape is stored in view->internal. Python 2 memoryviews
+ * copy the Py_buffer and release each copy, so the shape is kept in
+ * view->smalltable instead.
+ */
+
+static int
+GMPy_MPZ_GetBuffer(MPZ_Object *self, Py_buffer *view, int flags)
+{
+    Py_ssize_t *shape;
+
+    if (flags & PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "mpz is read-only");
+        return -1;
+    }
+
+#ifdef PY2
+    shape = view->smalltable;
+#else
+    if (!(shape = PyMem_Malloc(sizeof(Py_ssize_t)))) {
+        PyErr_NoMemory();
+        return -1;
+    }
+#endif
+    shape[0] = (Py_ssize_t)mpz_size(self->z);
+
+    view->buf = self->z->_mp_d;
+    view->obj = (PyObject*)self;
+    Py_INCREF(self);
+    view->len = shape[0] * (Py_ssize_t)sizeof(mp_limb_t);
+    view->readonly = 1;
+    view->itemsize = sizeof(mp_limb_t);
+    view->format = NULL;
+    if (flags & PyBUF_FORMAT) {
+        if (sizeof(mp_limb_t) == sizeof(unsigned long))
+            view->format = "L";
+        else if (sizeof(mp_limb_t) == sizeof(unsigned PY_LONG_LONG))
+            view->format = "Q";
+        else
+            view->format = "I";
+    }
+    view->ndim = 1;
+    view->shape = (flags & PyBUF_ND) ? shape : NULL;
+    view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? &view->itemsize : NULL;
+    view->suboffsets = NULL;
+#ifdef PY2
+    view->internal = NULL;
+#else
+    view->internal = shape;
+#endif
+    return 0;
+}
+
+static void
+GMPy_MPZ_ReleaseBuffer(MPZ_Object *self, Py_buffer *view)
+{
+#ifndef PY2
+    PyMem_Free(view->internal);
+#endif
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_method_limbs,
+"x.limbs() -> memoryview\n\n"
+"Return a read-only memoryview of the absolute value of x as an array\n"
+"of native-endian limbs, least significant first. For an mpz no data is\n"
+"copied; an xmpz is copied first since it can change. The sign is not\n"
+"included; see sign() and from_limbs().");
+
+static PyObject *
+GMPy_MPZ_Method_Limbs(PyObject *self, PyObject *other)
+{
+    PyObject *temp, *result;
+
+    if (MPZ_Check(self)) {
+        return PyMemoryView_FromObject(self);
+    }
+
+    if (!(temp = (PyObject*)GMPy_MPZ_From_XMPZ((XMPZ_Object*)self, NULL)))
+        return NULL;
+    result = PyMemoryView_FromObject(temp);
+    Py_DECREF(temp);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_function_from_limbs,
+"from_limbs(buffer, sign=1) -> mpz\n\n"
+"Return an mpz from an object supporting the buffer protocol. The\n"
+"buffer is read as an array of native-endian unsigned words of its item\n"
+"size, least significant first, so x == from_limbs(x.limbs(), sign(x)).\n"
+"The result is negative if sign is negative. Raises TypeError if the\n"
+"buffer has a format other than B, H, I, L, or Q.");
+
+static PyObject *
+GMPy_MPZ_Function_From_Limbs(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    Py_buffer view;
+    MPZ_Object *result;
+    long sign = 1;
+    size_t itemsize;
+
+    if (GMPY_NARGS < 1 || GMPY_NARGS > 2) {
+        TYPE_ERROR("from_limbs() requires 1 or 2 arguments");
+        return NULL;
+    }
+
+    if (GMPY_NARGS == 2) {
+        sign = c_long_From_Integer(GMPY_ARG(1));
+        if (sign == -1 && PyErr_Occurred())
+            return NULL;
+    }
+
+    if (PyObject_GetBuffer(GMPY_ARG(0), &view, PyBUF_ND | PyBUF_FORMAT) < 0)
+        return NULL;
+
+    /* Only native unsigned integers can be read as words. */
+    if (view.format) {
+        const char *format = view.format;
+
+        if (*format == '@')
+            format++;
+        if (!format[0] || format[1] || !strchr("BHILQ", format[0])) {
+            PyBuffer_Release(&view);
+            TYPE_ERROR("from_limbs() requires a buffer of unsigned integers");
+            return NULL;
+        }
+    }
+
+    itemsize = view.itemsize > 0 ? (size_t)view.itemsize : 1;
+    if (view.len % itemsize) {
+        PyBuffer_Release(&view);
+        VALUE_ERROR("from_limbs() buffer length is not a multiple of its item size");
+        return NULL;
+    }
+
+    if ((result = GMPy_MPZ_New(NULL))) {
+        mpz_import(result->z, view.len / itemsize, -1, itemsize, 0, 0, view.buf);
+        if (sign < 0)
+            mpz_neg(result->z, result->z);
+    }
+    PyBuffer_Release(&view);
+    return (PyObject*)result;
+}
+
+/* Bulk serialization. A stream is a sequence of records, each preceded by
+ * its length as an unsigned LEB128 varint: seven bits per byte, least
+ * significant group first, with the high bit set on all but the last
+ * byte. The records use the to_binary() format.
+ *
+ * A stream written with compact=True stores consecutive small integers as
+ * a run instead: a 0x00 byte (no record has length 0), the compact tag
+ * (0x06 for mpz or 0x07 for xmpz), the number of values as a varint, and
+ * then each value as a zigzag varint with no tag or length. Other values
+ * are written as compact records.
+ */
+
+static size_t
+GMPy_Varint_Size(unsigned PY_LONG_LONG value)
+{
+    size_t n = 1;
+
+    while (value >>= 7)
+        n++;
+    return n;
+}
+
+static size_t
+GMPy_Varint_Write(unsigned char *buffer, unsigned PY_LONG_LONG value)
+{
+    size_t n = 0;
+
+    while (value >= 0x80) {
+        buffer[n++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    buffer[n++] = (unsigned char)value;
+    return n;
+}
+
+/* Read a varint starting at buffer[*pos]. Returns 1 and advances *pos on
+ * success, 0 if the buffer ends inside the varint, and -1 if the value does
+ * not fit in 64 bits.
+ */
+
+static int
+GMPy_Varint_Read64(const unsigned char *buffer, Py_ssize_t len, Py_ssize_t *pos,
+                   unsigned PY_LONG_LONG *value)
+{
+    unsigned PY_LONG_LONG result = 0;
+    unsigned int shift = 0;
+    Py_ssize_t i = *pos;
+
+    while (i < len) {
+        unsigned PY_LONG_LONG c = buffer[i++];
+
+        if (shift >= 64 || ((c & 0x7f) << shift) >> shift != (c & 0x7f))
+            return -1;
+        result |= (c & 0x7f) << shift;
+        if (!(c & 0x80)) {
+            *value = result;
+            *pos = i;
+            return 1;
+        }
+        shift += 7;
+    }
+    return 0;
+}
+
+/* Read a varint that is used as a length; -1 is also returned if the value
+ * does not fit in a Py_ssize_t.
+ */
+
+static int
+GMPy_Varint_Read(const unsigned char *buffer, Py_ssize_t len, Py_ssize_t *pos,
+                 size_t *value)
+{
+    unsigned PY_LONG_LONG result;
+    Py_ssize_t i = *pos;
+    int status;
+
+    if ((status = GMPy_Varint_Read64(buffer, len, &i, &result)) != 1)
+        return status;
+    if (result > (unsigned PY_LONG_LONG)PY_SSIZE_T_MAX)
+        return -1;
+    *value = (size_t)result;
+    *pos = i;
+    return 1;
+}
+
+/* Compact records. to_binary(x, compact=True) uses a shorter format with
+ * its own type tags:
+ *
+ * byte[0]:      6 => mpz
+ *               7 => xmpz
+ *               8 => mpq
+ *               9 => mpfr
+ *
+ * An mpz or xmpz is followed by its value as a zigzag varint: n >= 0 is
+ * stored as 2*n and n < 0 as -2*n-1, so small values of either sign take
+ * one or two bytes. An mpq is followed by its numerator as a zigzag varint
+ * and its denominator as a varint. Integers and rationals that do not fit
+ * in 64 bits or are not shorter in this format, and mpc values, use the
+ * regular format.
+ *
+ * An mpfr is followed by:
+ *
+ * byte[1:0]:    sign bit
+ * byte[1:1-2]:  0 => value is 0
+ *               1 => regular value
+ *               2 => value is NaN
+ *               3 => value is Inf
+ * byte[1:3-4]:  0 => rc = 0
+ *               1 => rc > 0
+ *               2 => rc < 0
+ * byte[2]+:     precision, as a varint
+ *               for a regular value, the exponent as a zigzag varint and
+ *               then the mantissa, most significant byte first, without
+ *               its trailing zero bytes
+ */
+
+static unsigned PY_LONG_LONG
+GMPy_Zigzag_Encode(PY_LONG_LONG value)
+{
+    if (value < 0)
+        return 2 * (unsigned PY_LONG_LONG)(-(value + 1)) + 1;
+    return 2 * (unsigned PY_LONG_LONG)value;
+}
+
+static PY_LONG_LONG
+GMPy_Zigzag_Decode(unsigned PY_LONG_LONG value)
+{
+    if (value & 1)
+        return -(PY_LONG_LONG)(value >> 1) - 1;
+    return (PY_LONG_LONG)(value >> 1);
+}
+
+/* Set *value to the absolute value of z if it fits in 64 bits. */
+
+static int
+GMPy_MPZ_Abs_64(mpz_srcptr z, unsigned PY_LONG_LONG *value)
+{
+    if (mpz_sizeinbase(z, 2) > 64)
+        return 0;
+    *value = mpz_getlimbn(z, 0);
+#if GMP_NUMB_BITS < 64
+    *value |= (unsigned PY_LONG_LONG)mpz_getlimbn(z, 1) << GMP_NUMB_BITS;
+#endif
+    return 1;
+}
+
+/* Set *value to z if it fits in a signed 64-bit integer. */
+
+static int
+GMPy_MPZ_To_LL(mpz_srcptr z, PY_LONG_LONG *value)
+{
+    unsigned PY_LONG_LONG mag;
+
+    if (!GMPy_MPZ_Abs_64(z, &mag))
+        return 0;
+    if (mpz_sgn(z) < 0) {
+        if (mag > (unsigned PY_LONG_LONG)PY_LLONG_MAX + 1)
+            return 0;
+        *value = -(PY_LONG_LONG)(mag - 1) - 1;
+    }
+    else {
+        if (mag > (unsigned PY_LONG_LONG)PY_LLONG_MAX)
+            return 0;
+        *value = (PY_LONG_LONG)mag;
+    }
+    return 1;
+}
+
+static void
+GMPy_MPZ_Set_ULL(mpz_ptr z, unsigned PY_LONG_LONG value)
+{
+    if (value <= ULONG_MAX)
+        mpz_set_ui(z, (unsigned long)value);
+    else
+        mpz_import(z, 1, -1, sizeof(value), 0, 0, &value);
+}
+
+static void
+GMPy_MPZ_Set_LL(mpz_ptr z, PY_LONG_LONG value)
+{
+    if (value >= LONG_MIN && value <= LONG_MAX) {
+        mpz_set_si(z, (long)value);
+    }
+    else {
+        GMPy_MPZ_Set_ULL(z, value < 0 ? 0 - (unsigned PY_LONG_LONG)value
+                                      : (unsigned PY_LONG_LONG)value);
+        if (value < 0)
+            mpz_neg(z, z);
+    }
+}
+
+/* Return the mpz (tag 0x06) or xmpz (tag 0x07) stored as a zigzag varint.
+ * Small mpz values come from the cache of interned values.
+ */
+
+static PyObject *
+GMPy_Binary_Zigzag_Object(int tag, unsigned PY_LONG_LONG value, CTXT_Object *context)
+{
+    PY_LONG_LONG temp = GMPy_Zigzag_Decode(value);
+    PyObject *result;
+
+    if (tag == 0x06) {
+        if (temp >= LONG_MIN && temp <= LONG_MAX)
+            return (PyObject*)GMPy_MPZ_From_SI((long)temp, context);
+        result = (PyObject*)GMPy_MPZ_New(context);
+    }
+    else {
+        result = (PyObject*)GMPy_XMPZ_New(context);
+    }
+    if (result)
+        GMPy_MPZ_Set_LL(MPZ(result), temp);
+    return result;
+}
+
+/* Return the number of bytes in the mantissa of a regular mpfr, without
+ * its trailing zero bytes.
+ */
+
+static size_t
+GMPy_MPFR_Compact_Mantissa_Size(mpfr_srcptr f)
+{
+    size_t nlimbs = (mpfr_get_prec(f) + mp_bits_per_limb - 1) / mp_bits_per_limb;
+    size_t i = 0, zero;
+    mp_limb_t limb;
+
+    /* The most significant limb is never 0. */
+    while (f->_mpfr_d[i] == 0)
+        i++;
+    limb = f->_mpfr_d[i];
+    zero = i * sizeof(mp_limb_t);
+    while (!(limb & 0xff)) {
+        limb >>= 8;
+        zero++;
+    }
+    return nlimbs * sizeof(mp_limb_t) - zero;
+}
+
+/* Return the size of the compact record for x, or 0 if x uses the regular
+ * format.
+ */
+
+static size_t
+GMPy_MPANY_Compact_Size(PyObject *x)
+{
+    PY_LONG_LONG value;
+    unsigned PY_LONG_LONG den;
+    size_t size;
+
+    /* Integers and rationals use the shorter of the two formats. */
+
+    if (CHECK_MPZANY(x)) {
+        if (!GMPy_MPZ_To_LL(MPZ(x), &value))
+            return 0;
+        size = 1 + GMPy_Varint_Size(GMPy_Zigzag_Encode(value));
+        return size < GMPy_MPZ_Binary_Size(MPZ(x)) ? size : 0;
+    }
+
+    if (MPQ_Check(x)) {
+        if (!GMPy_MPZ_To_LL(mpq_numref(MPQ(x)), &value) ||
+            !GMPy_MPZ_Abs_64(mpq_denref(MPQ(x)), &den)) {
+            return 0;
+        }
+        size = 1 + GMPy_Varint_Size(GMPy_Zigzag_Encode(value)) + GMPy_Varint_Size(den);
+        return size < GMPy_MPQ_Binary_Size(MPQ(x)) ? size : 0;
+    }
+
+    /* The reader limits the precision of a compact mpfr record, since it
+     * may omit most of the mantissa. */
+
+    if (MPFR_Check(x)) {
+        if (mpfr_get_prec(MPFR(x)) > GMPY_MAX_RECORD_PREC)
+            return 0;
+        size = 2 + GMPy_Varint_Size(mpfr_get_prec(MPFR(x)));
+        if (mpfr_regular_p(MPFR(x))) {
+            size += GMPy_Varint_Size(GMPy_Zigzag_Encode(mpfr_get_exp(MPFR(x))));
+            size += GMPy_MPFR_Compact_Mantissa_Size(MPFR(x));
+        }
+        return size;
+    }
+
+    return 0;
+}
+
+/* Write the compact record for x, which must have a nonzero
+ * GMPy_MPANY_Compact_Size(). Returns 0 on success, or -1 with an exception
+ * set if x has no compact form.
+ */
+
+static int
+GMPy_MPANY_Compact_Write(unsigned char *buffer, PyObject *x)
+{
+    PY_LONG_LONG value;
+    unsigned PY_LONG_LONG den;
+    unsigned char *cp = buffer;
+
+    if (CHECK_MPZANY(x)) {
+        if (!GMPy_MPZ_To_LL(MPZ(x), &value))
+            goto nocompact;
+        *cp++ = MPZ_Check(x) ? 0x06 : 0x07;
+        GMPy_Varint_Write(cp, GMPy_Zigzag_Encode(value));
+    }
+    else if (MPQ_Check(x)) {
+        if (!GMPy_MPZ_To_LL(mpq_numref(MPQ(x)), &value) ||
+            !GMPy_MPZ_Abs_64(mpq_denref(MPQ(x)), &den)) {
+            goto nocompact;
+        }
+        *cp++ = 0x08;
+        cp += GMPy_Varint_Write(cp, GMPy_Zigzag_Encode(value));
+        GMPy_Varint_Write(cp, den);
+    }
+    else if (MPFR_Check(x)) {
+        mpfr_srcptr f = MPFR(x);
+        MPFR_Object *obj = (MPFR_Object*)x;
+        size_t nbytes, mant, i, j;
+
+        *cp++ = 0x09;
+        *cp = mpfr_signbit(f) ? 0x01 : 0x00;
+        if (mpfr_regular_p(f))  *cp |= 0x02;
+        else if (mpfr_nan_p(f)) *cp |= 0x04;
+        else if (mpfr_inf_p(f)) *cp |= 0x06;
+        if (obj->rc > 0)        *cp |= 0x08;
+        else if (obj->rc < 0)   *cp |= 0x10;
+        cp++;
+        cp += GMPy_Varint_Write(cp, mpfr_get_prec(f));
+        if (mpfr_regular_p(f)) {
+            cp += GMPy_Varint_Write(cp, GMPy_Zigzag_Encode(mpfr_get_exp(f)));
+            nbytes = ((mpfr_get_prec(f) + mp_bits_per_limb - 1) / mp_bits_per_limb) *
+                     sizeof(mp_limb_t);
+            mant = GMPy_MPFR_Compact_Mantissa_Size(f);
+            for (i = 0; i < mant; i++) {
+                j = nbytes - 1 - i;
+                cp[i] = (unsigned char)(f->_mpfr_d[j / sizeof(mp_limb_t)] >>
+                                        (8 * (j % sizeof(mp_limb_t))));
+            }
+        }
+    }
+    else {
+        goto nocompact;
+    }
+    return 0;
+
+  nocompact:
+    SYSTEM_ERROR("value has no compact binary form");
+    return -1;
+}
+
+/* Return x as a compact record, or as a regular record if it has no
+ * compact form.
+ */
+
+static PyObject *
+GMPy_MPANY_To_Compact_Binary(PyObject *x)
+{
+    PyObject *result;
+    size_t size;
+
+    if (!(size = GMPy_MPANY_Compact_Size(x)))
+        return GMPy_MPANY_To_Binary(NULL, x);
+
+    if ((result = PyBytes_FromStringAndSize(NULL, size)) &&
+        GMPy_MPANY_Compact_Write((unsigned char*)PyBytes_AS_STRING(result), x) < 0) {
+        Py_DECREF(result);
+        return NULL;
+    }
+    return result;
+}
+
+PyDoc_STRVAR(doc_to_binary,
+"to_binary(x, compact=False) -> bytes\n"
+"Return a Python byte sequence that is a portable binary\n"
+"representation of a gmpy2 object x. The byte sequence can\n"
+"be passed to gmpy2.from_binary() to obtain an exact copy of\n"
+"x's value. Works with mpz, xmpz, mpq, mpfr, and mpc types. \n"
+"If compact is true, a shorter format is used for integers and\n"
+"rationals that fit in 64 bits and for mpfr values.\n"
+"Raises TypeError if x is not a gmpy2 object.");
+
+static PyObject *
+GMPy_MPANY_To_Binary_Function(PyObject *self, GMPY_FASTCALL_KWARGS)
+{
+    PyObject *x, *compact = NULL;
+    int flag = 0;
+    static char *kwlist[] = {"x", "compact", NULL};
+
+    if (GMPY_NARGS == 1 && !GMPY_NKWARGS)
+        return GMPy_MPANY_To_Binary(NULL, GMPY_ARG(0));
+
+    if (!GMPy_ParseArgsAndKeywords(GMPY_FASTCALL_PASS, "O|O", kwlist, &x, &compact))
+        return NULL;
+    if (compact && (flag = PyObject_IsTrue(compact)) < 0)
+        return NULL;
+
+    if (flag)
+        return GMPy_MPANY_To_Compact_Binary(x);
+    return GMPy_MPANY_To_Binary(NULL, x);
+}
+
+/* Decode a compact record of len bytes. Called by
+ * GMPy_MPANY_From_Binary_Record() for tags 0x06 to 0x09.
+ */
+
+static PyObject *
+GMPy_MPANY_From_Compact_Record(unsigned char *buffer, Py_ssize_t len,
+                               CTXT_Object *context)
+{
+    Py_ssize_t pos = 1;
+    unsigned PY_LONG_LONG value, den, prec, exp;
+    unsigned char flags;
+
+    if (buffer[0] == 0x06 || buffer[0] == 0x07) {
+        if (GMPy_Varint_Read64(buffer, len, &pos, &value) != 1 || pos != len)
+            goto invalid;
+        return GMPy_Binary_Zigzag_Object(buffer[0], value, context);
+    }
+
+    if (buffer[0] == 0x08) {
+        MPQ_Object *result;
+
+        if (GMPy_Varint_Read64(buffer, len, &pos, &value) != 1 ||
+            GMPy_Varint_Read64(buffer, len, &pos, &den) != 1 ||
+            pos != len || den == 0) {
+            goto invalid;
+        }
+        if (!(result = GMPy_MPQ_New(context)))
+            return NULL;
+        GMPy_MPZ_Set_LL(mpq_numref(result->q), GMPy_Zigzag_Decode(value));
+        GMPy_MPZ_Set_ULL(mpq_denref(result->q), den);
+        mpq_canonicalize(result->q);
+        return (PyObject*)result;
+    }
+
+    /* An mpfr. */
+    {
+        MPFR_Object *result;
+        PY_LONG_LONG exponent = 0;
+        Py_ssize_t mant = 0;
+        size_t nlimbs, i, j;
+        int unused;
+
+        flags = buffer[1];
+        pos = 2;
+        if ((flags & 0xe0) || (flags & 0x18) == 0x18 ||
+            GMPy_Varint_Read64(buffer, len, &pos, &prec) != 1 ||
+            prec < MPFR_PREC_MIN || prec > (unsigned PY_LONG_LONG)GMPY_MAX_RECORD_PREC) {
+            goto invalid;
+        }
+
+        if ((flags & 0x06) == 0x02) {
+            if (GMPy_Varint_Read64(buffer, len, &pos, &exp) != 1)
+                goto invalid;
+            exponent = GMPy_Zigzag_Decode(exp);
+            mant = len - pos;
+            if (exponent < mpfr_get_emin_min() || exponent > mpfr_get_emax_max() ||
+                mant == 0 || (unsigned PY_LONG_LONG)mant > (prec + 7) / 8 ||
+                !(buffer[pos] & 0x80)) {
+                goto invalid;
+            }
+        }
+        else if (pos != len) {
+            goto invalid;
+        }
+
+        /* GMPy_MPFR_New() treats precisions 0 and 1 as the context
+         * precision. */
+        if (!(result = GMPy_MPFR_New(prec < 2 ? 2 : (mpfr_prec_t)prec, context)))
+            return NULL;
+        if (prec < 2)
+            mpfr_set_prec(result->f, (mpfr_prec_t)prec);
+
+        switch (flags & 0x06) {
+            case 0x00:
+                mpfr_set_zero(result->f, (flags & 0x01) ? -1 : 1);
+                break;
+            case 0x04:
+                /* The sign of a recycled NaN is left unchanged. */
+                mpfr_set_nan(result->f);
+                mpfr_setsign(result->f, result->f, flags & 0x01, MPFR_RNDN);
+                break;
+            case 0x06:
+                mpfr_set_inf(result->f, (flags & 0x01) ? -1 : 1);
+                break;
+            default:
+                /* Fill the limbs from the most significant byte down. */
+                mpfr_set_ui(result->f, 1, MPFR_RNDN);
+                nlimbs = (mpfr_get_prec(result->f) + mp_bits_per_limb - 1) / mp_bits_per_limb;
+                memset(result->f->_mpfr_d, 0, nlimbs * sizeof(mp_limb_t));
+                for (i = 0; i < (size_t)mant; i++) {
+                    j = nlimbs * sizeof(mp_limb_t) - 1 - i;
+                    result->f->_mpfr_d[j / sizeof(mp_limb_t)] |=
+                        (mp_limb_t)buffer[pos + i] << (8 * (j % sizeof(mp_limb_t)));
+                }
+                /* The bits below the precision must be 0. */
+                unused = (int)(nlimbs * mp_bits_per_limb - mpfr_get_prec(result->f));
+                if (result->f->_mpfr_d[0] & (((mp_limb_t)1 << unused) - 1)) {
+                    Py_DECREF((PyObject*)result);
+                    goto invalid;
+                }
+                result->f->_mpfr_exp = (mpfr_exp_t)exponent;
+                if (flags & 0x01)
+                    mpfr_neg(result->f, result->f, MPFR_RNDN);
+                break;
+        }
+
+        if (flags & 0x08)      result->rc = 1;
+        else if (flags & 0x10) result->rc = -1;
+        return (PyObject*)result;
+    }
+
+  invalid:
+    VALUE_ERROR("byte sequence invalid for from_binary()");
+    return NULL;
+}
+
+/* Make room for need more bytes in the bytes object *result, which holds
+ * used bytes. The allocation grows geometrically.
+ */
+
+static int
+GMPy_Binary_Reserve(PyObject **result, Py_ssize_t used, size_t need)
+{
+    Py_ssize_t alloc = PyBytes_GET_SIZE(*result);
+
+    if (need > (size_t)(PY_SSIZE_T_MAX - used)) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (used + (Py_ssize_t)need <= alloc)
+        return 0;
+
+    alloc = alloc < PY_SSIZE_T_MAX / 2 ? alloc * 2 : PY_SSIZE_T_MAX;
+    if (alloc < used + (Py_ssize_t)need)
+        alloc = used + (Py_ssize_t)need;
+    return _PyBytes_Resize(result, alloc);
+}
+
+PyDoc_STRVAR(GMPy_doc_function_to_binary_many,
+"to_binary_many(iterable, compact=False) -> bytes\n\n"
+"Return the gmpy2 objects in iterable as one byte sequence. Each value\n"
+"is stored as its to_binary() record preceded by the record length as a\n"
+"varint. If compact is true, the compact records of to_binary() are\n"
+"used and consecutive integers that fit in 64 bits are stored in runs\n"
+"without a length or type for each value. Use from_binary_many() or\n"
+"from_binary_iter() to read it back.");
+
+/* Space reserved for the count of a run; it is the longest 64-bit varint.
+ * The values are moved down when the run ends and the count is known.
+ */
+
+#define GMPY_BINARY_RUN_COUNT 10
+
+static void
+GMPy_Binary_End_Run(PyObject *result, Py_ssize_t start, Py_ssize_t *used,
+                    size_t count)
+{
+    unsigned char *cp = (unsigned char*)PyBytes_AS_STRING(result) + start;
+    size_t n;
+
+    n = GMPy_Varint_Write(cp, count);
+    memmove(cp + n, cp + GMPY_BINARY_RUN_COUNT,
+            *used - start - GMPY_BINARY_RUN_COUNT);
+    *used -= GMPY_BINARY_RUN_COUNT - n;
+}
+
+static PyObject *
+GMPy_MPANY_To_Binary_Many(PyObject *self, GMPY_FASTCALL_KWARGS)
+{
+    PyObject *iterable, *compact = NULL, *iter, *item, *temp, *result;
+    Py_ssize_t used = 0, run_start = 0;
+    size_t size, run_count = 0;
+    PY_LONG_LONG value;
+    unsigned PY_LONG_LONG code;
+    unsigned char *cp;
+    int flag = 0, tag, run_tag = 0;
+    static char *kwlist[] = {"iterable", "compact", NULL};
+
+    if (!GMPy_ParseArgsAndKeywords(GMPY_FASTCALL_PASS, "O|O", kwlist, &iterable, &compact))
+        return NULL;
+    if (compact && (flag = PyObject_IsTrue(compact)) < 0)
+        return NULL;
+
+    if (!(iter = PyObject_GetIter(iterable)))
+        return NULL;
+
+    if (!(result = PyBytes_FromStringAndSize(NULL, 256))) {
+        Py_DECREF(iter);
+        return NULL;
+    }
+
+    while ((item = PyIter_Next(iter))) {
+        temp = NULL;
+
+        if (flag && CHECK_MPZANY(item) && GMPy_MPZ_To_LL(MPZ(item), &value)) {
+            tag = MPZ_Check(item) ? 0x06 : 0x07;
+            if (run_count && run_tag != tag) {
+                GMPy_Binary_End_Run(result, run_start, &used, run_count);
+                run_count = 0;
+            }
+            code = GMPy_Zigzag_Encode(value);
+            if (GMPy_Binary_Reserve(&result, used,
+                                    2 + GMPY_BINARY_RUN_COUNT + GMPy_Varint_Size(code)) < 0) {
+                Py_DECREF(item);
+                goto err;
+            }
+            cp = (unsigned char*)PyBytes_AS_STRING(result);
+            if (!run_count) {
+                cp[used++] = 0x00;
+                cp[used++] = (unsigned char)tag;
+                run_start = used;
+                run_tag = tag;
+                used += GMPY_BINARY_RUN_COUNT;
+            }
+            used += GMPy_Varint_Write(cp + used, code);
+            run_count++;
+            Py_DECREF(item);
+            continue;
+        }
+
+        if (run_count) {
+            GMPy_Binary_End_Run(result, run_start, &used, run_count);
+            run_count = 0;
+        }
+
+        if (flag && (size = GMPy_MPANY_Compact_Size(item))) {
+            tag = -1;
+        }
+        else if (CHECK_MPZANY(item)) {
+            size = GMPy_MPZ_Binary_Size(MPZ(item));
+            tag = MPZ_Check(item) ? 0x01 : 0x02;
+        }
+        else if (MPQ_Check(item)) {
+            size = GMPy_MPQ_Binary_Size(MPQ(item));
+            tag = 0x03;
+        }
+        else {
+            /* mpfr and mpc records are built by to_binary() and copied. */
+            if (!(temp = GMPy_MPANY_To_Binary(NULL, item))) {
+                Py_DECREF(item);
+                goto err;
+            }
+            size = PyBytes_GET_SIZE(temp);
+            tag = 0;
+        }
+
+        if (GMPy_Binary_Reserve(&result, used, GMPy_Varint_Size(size) + size) < 0) {
+            Py_XDECREF(temp);
+            Py_DECREF(item);
+            goto err;
+        }
+
+        cp = (unsigned char*)PyBytes_AS_STRING(result) + used;
+        cp += GMPy_Varint_Write(cp, size);
+        if (temp) {
+            memcpy(cp, PyBytes_AS_STRING(temp), size);
+        }
+        else if (tag < 0) {
+            if (GMPy_MPANY_Compact_Write(cp, item) < 0) {
+                Py_DECREF(item);
+                goto err;
+            }
+        }
+        else if (tag == 0x03) {
+            GMPy_MPQ_Binary_Write((char*)cp, MPQ(item));
+        }
+        else {
+            GMPy_MPZ_Binary_Write((char*)cp, (char)tag, MPZ(item));
+        }
+        used = (Py_ssize_t)(cp - (unsigned char*)PyBytes_AS_STRING(result)) + size;
+
+        Py_XDECREF(temp);
+        Py_DECREF(item);
+    }
+    if (PyErr_Occurred())
+        goto err;
+
+    if (run_count)
+        GMPy_Binary_End_Run(result, run_start, &used, run_count);
+
+    Py_DECREF(iter);
+    if (_PyBytes_Resize(&result, used) < 0)
+        return NULL;
+    return result;
+
+  err:
+    Py_DECREF(iter);
+    Py_XDECREF(result);
+    return NULL;
+}
+
+/* Read the record, or the next value of a run, at buffer[*pos] and advance
+ * *pos past it. run holds the state of the current run. Returns NULL
+ * without an exception set if *pos is at the end of the buffer.
+ */
+
+static PyObject *
+GMPy_Binary_Next_Record(unsigned char *buffer, Py_ssize_t len, Py_ssize_t *pos,
+                        GMPy_Binary_Run *run, CTXT_Object *context)
+{
+    Py_ssize_t start = *pos;
+    size_t size, left = run->left;
+    unsigned PY_LONG_LONG value;
+    int tag = run->tag;
+    PyObject *result;
+
+    if (start >= len) {
+        if (left) {
+            VALUE_ERROR("byte sequence truncated in from_binary_many()");
+        }
+        return NULL;
+    }
+
+    if (!left && buffer[start] == 0x00) {
+        /* The start of a run. */
+        if (len - start < 2) {
+            VALUE_ERROR("byte sequence truncated in from_binary_many()");
+            return NULL;
+        }
+        tag = buffer[start + 1];
+        start += 2;
+        switch (GMPy_Varint_Read(buffer, len, &start, &left)) {
+            case 1:
+                break;
+            case 0:
+                VALUE_ERROR("byte sequence truncated in from_binary_many()");
+                return NULL;
+            default:
+                left = 0;
+        }
+        if ((tag != 0x06 && tag != 0x07) || left == 0) {
+            VALUE_ERROR("invalid run in from_binary_many()");
+            return NULL;
+        }
+    }
+
+    if (left) {
+        switch (GMPy_Varint_Read64(buffer, len, &start, &value)) {
+            case 1:
+                break;
+            case 0:
+                VALUE_ERROR("byte sequence truncated in from_binary_many()");
+                return NULL;
+            default:
+                VALUE_ERROR("invalid value in from_binary_many()");
+                return NULL;
+        }
+        if ((result = GMPy_Binary_Zigzag_Object(tag, value, context))) {
+            *pos = start;
+            run->left = left - 1;
+            run->tag = tag;
+        }
+        return result;
+    }
+
+    switch (GMPy_Varint_Read(buffer, len, &start, &size)) {
+        case 1:
+            break;
+        case 0:
+            VALUE_ERROR("byte sequence truncated in from_binary_many()");
+            return NULL;
+        default:
+            VALUE_ERROR("invalid record length in from_binary_many()");
+            return NULL;
+    }
+    if ((Py_ssize_t)size > len - start) {
+        VALUE_ERROR("byte sequence truncated in from_binary_many()");
+        return NULL;
+    }
+
+    if ((result = GMPy_MPANY_From_Binary_Record(buffer + start, (Py_ssize_t)size, context)))
+        *pos = start + (Py_ssize_t)size;
+    return result;
+}
+
+/* Check whether the next record or run value at buffer[pos] is complete.
+ * Returns 1 if it is, -1 if it is invalid, and 0 if more data is needed;
+ * *need is then the number of bytes known to be missing, or 0.
+ */
+
+static int
+GMPy_Binary_Probe(unsigned char *buffer, Py_ssize_t len, Py_ssize_t pos,
+                  GMPy_Binary_Run *run, Py_ssize_t *need)
+{
+    unsigned PY_LONG_LONG value;
+    size_t size;
+    int status;
+
+    *need = 0;
+    if (pos >= len)
+        return 0;
+
+    if (run->left || buffer[pos] == 0x00) {
+        if (!run->left) {
+            if (len - pos < 2)
+                return 0;
+            pos += 2;
+            if ((status = GMPy_Varint_Read(buffer, len, &pos, &size)) != 1)
+                return status;
+        }
+        return GMPy_Varint_Read64(buffer, len, &pos, &value);
+    }
+
+    if ((status = GMPy_Varint_Read(buffer, len, &pos, &size)) != 1)
+        return status;
+    if ((Py_ssize_t)size <= len - pos)
+        return 1;
+    *need = (Py_ssize_t)size - (len - pos);
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_function_from_binary_many,
+"from_binary_many(buffer) -> list\n\n"
+"Return a list of the gmpy2 objects stored in a byte sequence created\n"
+"by to_binary_many(). Any object supporting the buffer protocol is\n"
+"accepted.");
+
+static PyObject *
+GMPy_MPANY_From_Binary_Many(PyObject *self, PyObject *other)
+{
+    Py_buffer view;
+    Py_ssize_t pos = 0;
+    GMPy_Binary_Run run = {0, 0};
+    PyObject *result, *item;
+    CTXT_Object *context = NULL;
+
+    CHECK_CONTEXT(context);
+
+    if (PyObject_GetBuffer(other, &view, PyBUF_SIMPLE) < 0)
+        return NULL;
+
+    if (!(result = PyList_New(0))) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    while ((item = GMPy_Binary_Next_Record((unsigned char*)view.buf, view.len,
+                                           &pos, &run, context))) {
+        if (PyList_Append(result, item) < 0) {
+            Py_DECREF(item);
+            break;
+        }
+        Py_DECREF(item);
+    }
+    PyBuffer_Release(&view);
+
+    if (PyErr_Occurred()) {
+        Py_DECREF(result);
+        return NULL;
+    }
+    return result;
+}
+
+/* from_binary_iter() returns a GMPy_BinaryIter_Object. The records are read
+ * from view, which covers either the source buffer or, for a file, the
+ * current chunk. When a file is read, the unread tail of the chunk is
+ * joined with the next read.
+ */
+
+#define GMPY_BINARY_CHUNK 65536
+
+static PyObject *
+GMPy_BinaryIter_Next(GMPy_BinaryIter_Object *self)
+{
+    PyObject *data, *joined;
+    Py_ssize_t pos, avail, want, need = 0;
+    int status;
+    CTXT_Object *context = NULL;
+
+    CHECK_CONTEXT(context);
+
+    if (!self->have_view)
+        return NULL;
+
+    while (1) {
+        /* Without a file, the buffer holds the whole stream. */
+        if (!self->file) {
+            return GMPy_Binary_Next_Record((unsigned char*)self->view.buf,
+                                           self->view.len, &self->pos,
+                                           &self->run, context);
+        }
+
+        /* Decode the next record if it is complete in this chunk or if it
+         * is invalid. Otherwise read at least the rest of it.
+         */
+        pos = self->pos;
+        avail = self->view.len - pos;
+        status = GMPy_Binary_Probe((unsigned char*)self->view.buf,
+                                   self->view.len, pos, &self->run, &need);
+        if (status != 0) {
+            return GMPy_Binary_Next_Record((unsigned char*)self->view.buf,
+                                           self->view.len, &self->pos,
+                                           &self->run, context);
+        }
+
+        want = GMPY_BINARY_CHUNK;
+        if (need > want)
+            want = need;
+
+        if (!(data = PyObject_CallMethod(self->file, "read", "n", want)))
+            return NULL;
+        if (!PyBytes_Check(data)) {
+            Py_DECREF(data);
+            TYPE_ERROR("from_binary_iter() requires a file opened in binary mode");
+            return NULL;
+        }
+        if (PyBytes_GET_SIZE(data) == 0) {
+            Py_DECREF(data);
+            if (avail > 0 || self->run.left) {
+                /* Report the error for the incomplete record. */
+                return GMPy_Binary_Next_Record((unsigned char*)self->view.buf,
+                                               self->view.len, &self->pos,
+                                               &self->run, context);
+            }
+            return NULL;
+        }
+
+        if (avail > 0) {
+            joined = PyBytes_FromStringAndSize(NULL, avail + PyBytes_GET_SIZE(data));
+            if (!joined) {
+                Py_DECREF(data);
+                return NULL;
+            }
+            memcpy(PyBytes_AS_STRING(joined), (char*)self->view.buf + self->pos, avail);
+            memcpy(PyBytes_AS_STRING(joined) + avail, PyBytes_AS_STRING(data),
+                   PyBytes_GET_SIZE(data));
+            Py_DECREF(data);
+            data = joined;
+        }
+
+        PyBuffer_Release(&self->view);
+        self->have_view = 0;
+        if (PyObject_GetBuffer(data, &self->view, PyBUF_SIMPLE) < 0) {
+            Py_DECREF(data);
+            return NULL;
+        }
+        /* The view holds the reference to data. */
+        Py_DECREF(data);
+        self->have_view = 1;
+        self->pos = 0;
+    }
+}
+
+static void
+GMPy_BinaryIter_Dealloc(GMPy_BinaryIter_Object *self)
+{
+    if (self->have_view)
+        PyBuffer_Release(&self->view);
+    Py_XDECREF(self->file);
+    PyObject_Del(self);
+}
+
+static PyTypeObject GMPy_BinaryIter_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                  /* ob_size          */
+#endif
+    "gmpy2 binary iterator",                /* tp_name          */
+    sizeof(GMPy_BinaryIter_Object),         /* tp_basicsize     */
+        0,                                  /* tp_itemsize      */
+    (destructor) GMPy_BinaryIter_Dealloc,   /* tp_dealloc       */
+        0,                                  /* tp_print         */
+        0,                                  /* tp_getattr       */
+        0,                                  /* tp_setattr       */
+        0,                                  /* tp_reserved      */
+        0,                                  /* tp_repr          */
+        0,                                  /* tp_as_number     */
+        0,                                  /* tp_as_sequence   */
+        0,                                  /* tp_as_mapping    */
+        0,                                  /* tp_hash          */
+        0,                                  /* tp_call          */
+        0,                                  /* tp_str           */
+        0,                                  /* tp_getattro      */
+        0,                                  /* tp_setattro      */
+        0,                                  /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                     /* tp_flags         */
+    "GMPY2 Binary Iterator Object",         /* tp_doc           */
+        0,                                  /* tp_traverse      */
+        0,                                  /* tp_clear         */
+        0,                                  /* tp_richcompare   */
+        0,                                  /* tp_weaklistoffset*/
+    PyObject_SelfIter,                      /* tp_iter          */
+    (iternextfunc)GMPy_BinaryIter_Next,     /* tp_iternext      */
+};
+
+PyDoc_STRVAR(GMPy_doc_function_from_binary_iter,
+"from_binary_iter(source) -> iterator\n\n"
+"Return an iterator over the gmpy2 objects in a stream created by\n"
+"to_binary_many(). source is either an object supporting the buffer\n"
+"protocol or a file opened in binary mode; a file is read in chunks, so\n"
+"the whole stream need not fit in memory. Streams written by several\n"
+"calls to to_binary_many() can be concatenated.");
+
+static PyObject *
+GMPy_MPANY_From_Binary_Iter(PyObject *self, PyObject *other)
+{
+    GMPy_BinaryIter_Object *result;
+    PyObject *empty;
+
+    if (!(result = PyObject_New(GMPy_BinaryIter_Object, &GMPy_BinaryIter_Type)))
+        return NULL;
+    result->file = NULL;
+    result->pos = 0;
+    result->run.left = 0;
+    result->run.tag = 0;
+    result->have_view = 0;
+
+    if (PyObject_CheckBuffer(other)) {
+        if (PyObject_GetBuffer(other, &result->view, PyBUF_SIMPLE) < 0) {
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        result->have_view = 1;
+        return (PyObject*)result;
+    }
+
+    if (!PyObject_HasAttrString(other, "read")) {
+        Py_DECREF((PyObject*)result);
+        TYPE_ERROR("from_binary_iter() requires a buffer or a binary file");
+        return NULL;
+    }
+
+    /* Start with an empty chunk. */
+    if (!(empty = PyBytes_FromStringAndSize(NULL, 0))) {
+        Py_DECREF((PyObject*)result);
+        return NULL;
+    }
+    if (PyObject_GetBuffer(empty, &result->view, PyBUF_SIMPLE) < 0) {
+        Py_DECREF(empty);
+        Py_DECREF((PyObject*)result);
+        return NULL;
+    }
+    Py_DECREF(empty);
+    result->have_view = 1;
+    Py_INCREF(other);
+    result->file = other;
+    return (PyObject*)result;
+}
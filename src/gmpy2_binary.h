@@ -37,12 +37,15 @@ extern "C" {
  * with GMPY 1.x. Methods to read the old format are provided.
  */
 
+static int GMPy_Limb_Endian(void);
+
 static PyObject * GMPy_MPZ_From_Old_Binary(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPQ_From_Old_Binary(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPFR_From_Old_Binary(PyObject *self, PyObject *other);
 
 static PyObject * GMPy_MPANY_From_Binary(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPANY_To_Binary(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPANY_To_Binary_Function(PyObject *self, GMPY_FASTCALL_KWARGS);
 
 static PyObject * GMPy_MPZ_To_Binary(MPZ_Object *self);
 static PyObject * GMPy_XMPZ_To_Binary(XMPZ_Object *self);
@@ -50,6 +53,49 @@ static PyObject * GMPy_MPQ_To_Binary(MPQ_Object *self);
 static PyObject * GMPy_MPFR_To_Binary(MPFR_Object *self);
 static PyObject * GMPy_MPC_To_Binary(MPC_Object *self);
 
+/* Largest precision accepted from a record that does not store the whole
+ * mantissa: a special value, or a compact mpfr record. The precision of
+ * any other record is limited by the length of its mantissa.
+ */
+
+#define GMPY_MAX_RECORD_PREC ((mpfr_prec_t)1 << 24)
+
+/* Compact records for small values. */
+
+static PyObject * GMPy_MPANY_From_Compact_Record(unsigned char *buffer, Py_ssize_t len,
+                                                 CTXT_Object *context);
+
+/* Bulk serialization of many objects into one length-prefixed stream. */
+
+typedef struct {
+    size_t left;           /* values left in the current run of integers */
+    int tag;               /* compact tag of the values in the run */
+} GMPy_Binary_Run;
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *file;        /* source file, or NULL for a buffer */
+    Py_buffer view;        /* the buffer, or the current chunk of the file */
+    Py_ssize_t pos;        /* offset of the next record in view */
+    GMPy_Binary_Run run;
+    int have_view;
+} GMPy_BinaryIter_Object;
+
+static PyTypeObject GMPy_BinaryIter_Type;
+
+static PyObject * GMPy_MPANY_From_Binary_Record(unsigned char *buffer, Py_ssize_t len,
+                                                CTXT_Object *context);
+static PyObject * GMPy_MPANY_To_Binary_Many(PyObject *self, GMPY_FASTCALL_KWARGS);
+static PyObject * GMPy_MPANY_From_Binary_Many(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPANY_From_Binary_Iter(PyObject *self, PyObject *other);
+
+/* Zero-copy access to the limbs of an mpz. */
+
+static int        GMPy_MPZ_GetBuffer(MPZ_Object *self, Py_buffer *view, int flags);
+static void       GMPy_MPZ_ReleaseBuffer(MPZ_Object *self, Py_buffer *view);
+static PyObject * GMPy_MPZ_Method_Limbs(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPZ_Function_From_Limbs(PyObject *self, GMPY_FASTCALL_ARGS);
+
 #ifdef __cplusplus
 }
 #endif
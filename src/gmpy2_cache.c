@@ -31,72 +31,623 @@
  * object caches used in gmpy2.
  *
  * "zcache" is used to cache mpz_t objects. The cache is accessed via the
- * functions mpz_inoc/mpz_cloc. The function set_zcache is used to change
- * the size of the array used to store the cached objects.
+ * functions mpz_inoc/mpz_cloc.
  *
- * The "py???cache" is used to cache Py??? objects. The cache is accessed
- * via Py???_new/Py???_dealloc. The functions set_py???cache and
- * set_py???cache are used to change the size of the array used to the store
- * the cached objects.
+ * The object caches are used to cache Py??? objects. They are accessed via
+ * GMPy_???_New/GMPy_???_Dealloc.
+ *
+ * The zcache and the mpz and xmpz caches are divided into size classes (see
+ * GMPY_CACHE_BINS in gmpy2.h) so a request for a large result is given an
+ * object that already has enough limbs instead of one that must be
+ * reallocated. GMPy_MPZ_NewSize() and mpz_inoc_size() accept the expected
+ * number of limbs in the result.
+ *
+ * The mpfr and mpc caches are keyed by the number of limbs in the mantissa.
+ * A new mantissa is allocated with the largest number of limbs in its size
+ * class and an object is only reused for a precision in the same size
+ * class, so mpfr_set_prec() never needs to reallocate it. The mpq cache
+ * only uses bin 0.
+ *
+ * Each thread has its own set of caches (a GMPy_Cache) reached through a
+ * thread-local pointer, so the fast path does not depend on the GIL. When
+ * a cache bin is full, freed objects are passed to a bounded global pool
+ * that is protected by a lock; when a bin is empty, objects are taken from
+ * the pool. This lets objects freed by one thread be reused by another.
+ * When a thread exits, its objects are moved to the pool. set_cache()
+ * changes gmpy_cache_generation and each thread resizes its own caches the
+ * next time it uses them.
+ */
+
+/* Return the bin that holds an object with a capacity of alloc limbs. */
+
+static int
+GMPy_Cache_BinIndex(size_t alloc)
+{
+    int k = 0;
+
+    while (alloc > 1 && k < GMPY_CACHE_BINS - 1) {
+        alloc >>= 1;
+        k++;
+    }
+    return k;
+}
+
+/* Return the first bin that only holds objects with room for size limbs,
+ * or GMPY_CACHE_BINS if no bin is large enough.
+ */
+
+static int
+GMPy_Cache_FitIndex(size_t size)
+{
+    int k = 0;
+
+    while (k < GMPY_CACHE_BINS && ((size_t)1 << k) < size)
+        k++;
+    return k;
+}
+
+/* Return the maximum number of objects kept in bin k. The bins for objects
+ * with fewer than 16 limbs hold up to cache_size objects. Larger bins hold
+ * half as many objects as the previous bin, so each of them holds about
+ * the same number of limbs. Bins for objects larger than cache_obsize are
+ * not used. Caches that are not divided into size classes only use bin 0.
+ */
+
+static int
+GMPy_Cache_BinLimit(int binned, int k)
+{
+    int limit;
+
+    if (!binned)
+        return k ? 0 : global.cache_size;
+
+    if (((size_t)1 << k) > (size_t)global.cache_obsize)
+        return 0;
+
+    limit = (k > 3) ? global.cache_size >> (k - 3) : global.cache_size;
+    if (limit == 0 && global.cache_size > 0)
+        limit = 1;
+    return limit;
+}
+
+/* Return the range of bins that are searched for an object with room for
+ * size limbs. Returns 0 if no bin is large enough. If size is 0, all bins
+ * are searched, starting with the smallest.
+ */
+
+static int
+GMPy_Cache_Range(size_t size, int *first, int *last)
+{
+    if (size == 0) {
+        *first = 0;
+        *last = GMPY_CACHE_BINS - 1;
+        return 1;
+    }
+
+    if ((*first = GMPy_Cache_FitIndex(size)) >= GMPY_CACHE_BINS)
+        return 0;
+
+    *last = *first + GMPY_CACHE_SEARCH;
+    if (*last >= GMPY_CACHE_BINS)
+        *last = GMPY_CACHE_BINS - 1;
+    return 1;
+}
+
+/* Free an object that is removed from a cache. */
+
+static void
+GMPy_Cache_Discard(size_t which, void *obj)
+{
+    if (which == GMPY_CACHE_MPZ)
+        mpz_clear(((MPZ_Object*)obj)->z);
+    else if (which == GMPY_CACHE_XMPZ)
+        mpz_clear(((XMPZ_Object*)obj)->z);
+    else if (which == GMPY_CACHE_MPQ)
+        mpq_clear(((MPQ_Object*)obj)->q);
+    else if (which == GMPY_CACHE_MPFR)
+        mpfr_clear(((MPFR_Object*)obj)->f);
+    else
+        mpc_clear(((MPC_Object*)obj)->c);
+    PyObject_Del(obj);
+}
+
+static const size_t gmpy_cache_kinds[] = {
+    GMPY_CACHE_MPZ, GMPY_CACHE_XMPZ, GMPY_CACHE_MPQ, GMPY_CACHE_MPFR, GMPY_CACHE_MPC
+};
+
+#define GMPY_CACHE_BINNED(which) ((which) != GMPY_CACHE_MPQ)
+
+/* Resize every bin of cache to the current limits. Objects that no longer
+ * fit are freed. Returns -1 if memory could not be allocated; the affected
+ * bins are then disabled.
  */
 
+static int
+GMPy_Cache_Resize(GMPy_Cache *cache)
+{
+    GMPy_Object_Cache *oc;
+    size_t which;
+    void **items;
+    mpz_t *zitems;
+    int i, k, limit, result = 0;
+
+    cache->generation = gmpy_cache_generation;
+
+    for (k = 0; k < GMPY_CACHE_BINS; k++) {
+        limit = GMPy_Cache_BinLimit(1, k);
+        while (cache->z.bin[k].in_cache > limit)
+            mpz_clear(cache->z.items[k][--cache->z.bin[k].in_cache]);
+        if (!(zitems = GMPY_REALLOC(cache->z.items[k], sizeof(mpz_t) * (limit ? limit : 1)))) {
+            limit = 0;
+            result = -1;
+        }
+        else {
+            cache->z.items[k] = zitems;
+        }
+        cache->z.bin[k].limit = limit;
+    }
+
+    for (i = 0; i < (int)(sizeof(gmpy_cache_kinds) / sizeof(size_t)); i++) {
+        which = gmpy_cache_kinds[i];
+        oc = GMPY_OBJECT_CACHE(cache, which);
+        for (k = 0; k < GMPY_CACHE_BINS; k++) {
+            limit = GMPy_Cache_BinLimit(GMPY_CACHE_BINNED(which), k);
+            while (oc->bin[k].in_cache > limit)
+                GMPy_Cache_Discard(which, oc->items[k][--oc->bin[k].in_cache]);
+            if (!(items = GMPY_REALLOC(oc->items[k], sizeof(void*) * (limit ? limit : 1)))) {
+                limit = 0;
+                result = -1;
+            }
+            else {
+                oc->items[k] = items;
+            }
+            oc->bin[k].limit = limit;
+        }
+    }
+    return result;
+}
+
+/* Free every object in cache and the arrays used by cache. */
+
 static void
-set_zcache(void)
+GMPy_Cache_Clear(GMPy_Cache *cache)
 {
-    if (in_zcache > global.cache_size) {
-        int i;
-        for(i = global.cache_size; i < in_zcache; ++i)
-            mpz_clear(zcache[i]);
-        in_zcache = global.cache_size;
+    GMPy_Object_Cache *oc;
+    int i, k;
+
+    for (k = 0; k < GMPY_CACHE_BINS; k++) {
+        while (cache->z.bin[k].in_cache)
+            mpz_clear(cache->z.items[k][--cache->z.bin[k].in_cache]);
+        GMPY_FREE(cache->z.items[k]);
+        cache->z.items[k] = NULL;
+    }
+
+    for (i = 0; i < (int)(sizeof(gmpy_cache_kinds) / sizeof(size_t)); i++) {
+        oc = GMPY_OBJECT_CACHE(cache, gmpy_cache_kinds[i]);
+        for (k = 0; k < GMPY_CACHE_BINS; k++) {
+            while (oc->bin[k].in_cache)
+                GMPy_Cache_Discard(gmpy_cache_kinds[i], oc->items[k][--oc->bin[k].in_cache]);
+            GMPY_FREE(oc->items[k]);
+            oc->items[k] = NULL;
+        }
     }
-    zcache = GMPY_REALLOC(zcache, sizeof(mpz_t) * global.cache_size);
 }
 
+#ifdef GMPY_TLS
+
+/* Move the objects of an exiting thread to the global pool and free the
+ * remaining objects. Called by the destructor of the capsule stored in
+ * the thread state dictionary, with the GIL held.
+ */
+
 static void
-mpz_inoc(mpz_t newo)
+GMPy_Cache_Release(PyObject *capsule)
+{
+    GMPy_Cache *cache = (GMPy_Cache*)PyCapsule_GetPointer(capsule, NULL);
+    GMPy_Object_Cache *oc, *pool;
+    int i, k;
+
+    if (!cache)
+        return;
+
+    PyThread_acquire_lock(gmpy_cache_lock, WAIT_LOCK);
+    for (i = 0; i < (int)(sizeof(gmpy_cache_kinds) / sizeof(size_t)); i++) {
+        oc = GMPY_OBJECT_CACHE(cache, gmpy_cache_kinds[i]);
+        pool = GMPY_OBJECT_CACHE(&gmpy_cache_pool, gmpy_cache_kinds[i]);
+        for (k = 0; k < GMPY_CACHE_BINS; k++) {
+            while (oc->bin[k].in_cache && pool->bin[k].in_cache < pool->bin[k].limit)
+                pool->items[k][pool->bin[k].in_cache++] = oc->items[k][--oc->bin[k].in_cache];
+        }
+    }
+    PyThread_release_lock(gmpy_cache_lock);
+
+    GMPy_Cache_Clear(cache);
+    if (gmpy_cache_tls == cache)
+        gmpy_cache_tls = NULL;
+    free(cache);
+}
+
+#endif
+
+/* Return the caches of the current thread after creating them or updating
+ * their limits. Returns NULL if the caches cannot be created; the caller
+ * then does not use a cache. Must be called with the GIL held. Any
+ * pending exception is preserved.
+ */
+
+static GMPy_Cache *
+GMPy_Cache_Refresh(void)
+{
+    GMPy_Cache *cache;
+    PyObject *type, *value, *traceback;
+
+#ifdef GMPY_TLS
+    PyObject *dict, *capsule;
+
+    if (!(cache = gmpy_cache_tls)) {
+        if (!(cache = calloc(1, sizeof(GMPy_Cache))))
+            return NULL;
+
+        /* The capsule in the thread state dictionary releases the caches
+         * when the thread exits.
+         */
+        PyErr_Fetch(&type, &value, &traceback);
+        if (!(dict = PyThreadState_GetDict()) ||
+            !(capsule = PyCapsule_New(cache, NULL, GMPy_Cache_Release))) {
+            PyErr_Restore(type, value, traceback);
+            free(cache);
+            return NULL;
+        }
+        if (PyDict_SetItem(dict, gmpy_cache_key, capsule) < 0) {
+            PyErr_Clear();
+            PyErr_Restore(type, value, traceback);
+            PyCapsule_SetDestructor(capsule, NULL);
+            Py_DECREF(capsule);
+            free(cache);
+            return NULL;
+        }
+        Py_DECREF(capsule);
+        PyErr_Restore(type, value, traceback);
+        gmpy_cache_tls = cache;
+    }
+#else
+    cache = &gmpy_cache_main;
+#endif
+
+    PyErr_Fetch(&type, &value, &traceback);
+    GMPy_Cache_Resize(cache);
+    PyErr_Restore(type, value, traceback);
+    return cache;
+}
+
+/* Return the caches of the current thread, or NULL. */
+
+static GMPy_Cache *
+GMPy_Cache_Get(void)
+{
+#ifdef GMPY_TLS
+    GMPy_Cache *cache = gmpy_cache_tls;
+#else
+    GMPy_Cache *cache = &gmpy_cache_main;
+#endif
+
+    if (cache && cache->generation == gmpy_cache_generation)
+        return cache;
+    return GMPy_Cache_Refresh();
+}
+
+/* Remove an object from bins first to last of a cache of the current
+ * thread, or of the global pool. Returns NULL if there is none. The hit or
+ * miss is recorded in the cache of the current thread.
+ */
+
+static void *
+GMPy_Cache_Take(GMPy_Cache *cache, size_t which, int first, int last)
+{
+    GMPy_Object_Cache *oc = GMPY_OBJECT_CACHE(cache, which);
+    void *obj = NULL;
+    int k;
+
+    for (k = first; k <= last; k++) {
+        if (oc->bin[k].in_cache) {
+            oc->bin[k].hits++;
+            return oc->items[k][--oc->bin[k].in_cache];
+        }
+    }
+
+#ifdef GMPY_TLS
+    {
+        GMPy_Object_Cache *pool = GMPY_OBJECT_CACHE(&gmpy_cache_pool, which);
+
+        /* Check without the lock first; the pool is usually empty. */
+        for (k = first; k <= last && !pool->bin[k].in_cache; k++);
+        if (k <= last) {
+            PyThread_acquire_lock(gmpy_cache_lock, WAIT_LOCK);
+            for (; k <= last; k++) {
+                if (pool->bin[k].in_cache) {
+                    obj = pool->items[k][--pool->bin[k].in_cache];
+                    break;
+                }
+            }
+            PyThread_release_lock(gmpy_cache_lock);
+            if (obj) {
+                oc->bin[k].hits++;
+                return obj;
+            }
+        }
+    }
+#endif
+
+    oc->bin[first].misses++;
+    if (global.cache_autotune && ++cache->tune_misses >= GMPY_CACHE_TUNE_WINDOW)
+        GMPy_Cache_Tune(cache);
+    return NULL;
+}
+
+/* Add an object to bin k of a cache of the current thread or, if that bin
+ * is full, of the global pool. Returns 0 if the object was not cached.
+ */
+
+static int
+GMPy_Cache_Put(GMPy_Cache *cache, size_t which, int k, void *obj)
+{
+    GMPy_Object_Cache *oc = GMPY_OBJECT_CACHE(cache, which);
+    int result = 0;
+
+    if (oc->bin[k].in_cache < oc->bin[k].limit) {
+        oc->items[k][oc->bin[k].in_cache++] = obj;
+        return 1;
+    }
+
+#ifdef GMPY_TLS
+    {
+        GMPy_Object_Cache *pool = GMPY_OBJECT_CACHE(&gmpy_cache_pool, which);
+
+        if (pool->bin[k].in_cache < pool->bin[k].limit) {
+            PyThread_acquire_lock(gmpy_cache_lock, WAIT_LOCK);
+            if (pool->bin[k].in_cache < pool->bin[k].limit) {
+                pool->items[k][pool->bin[k].in_cache++] = obj;
+                result = 1;
+            }
+            PyThread_release_lock(gmpy_cache_lock);
+        }
+    }
+#endif
+
+    if (!result) {
+        oc->full++;
+        cache->tune_full++;
+    }
+    return result;
+}
+
+/* Apply new cache limits. The caches of the current thread and the global
+ * pool are resized immediately; other threads resize their caches the next
+ * time they use them.
+ */
+
+static void
+set_cache_limits(void)
+{
+    gmpy_cache_generation++;
+#ifdef GMPY_TLS
+    PyThread_acquire_lock(gmpy_cache_lock, WAIT_LOCK);
+    GMPy_Cache_Resize(&gmpy_cache_pool);
+    PyThread_release_lock(gmpy_cache_lock);
+#endif
+    GMPy_Cache_Get();
+}
+
+/* Return the number of hits in all caches of a thread. */
+
+static size_t
+GMPy_Cache_Hits(GMPy_Cache *cache)
+{
+    GMPy_Object_Cache *oc;
+    size_t hits = 0;
+    int i, k;
+
+    for (k = 0; k < GMPY_CACHE_BINS; k++)
+        hits += cache->z.bin[k].hits;
+
+    for (i = 0; i < (int)(sizeof(gmpy_cache_kinds) / sizeof(size_t)); i++) {
+        oc = GMPY_OBJECT_CACHE(cache, gmpy_cache_kinds[i]);
+        for (k = 0; k < GMPY_CACHE_BINS; k++)
+            hits += oc->bin[k].hits;
+    }
+    return hits;
+}
+
+/* Called by a thread after GMPY_CACHE_TUNE_WINDOW misses when auto-tuning
+ * is enabled. If more than a quarter of the requests since the last check
+ * missed and objects were freed because a cache was full, cache_size is
+ * doubled, up to MAX_CACHE. Misses that occur while the number of live
+ * objects grows cannot be avoided by a larger cache and are ignored.
+ */
+
+static void
+GMPy_Cache_Tune(GMPy_Cache *cache)
 {
-    if (in_zcache) {
-        newo[0] = (zcache[--in_zcache])[0];
+    size_t hits = GMPy_Cache_Hits(cache);
+    size_t misses = cache->tune_misses;
+    size_t requests = hits - cache->tune_hits + misses;
+    size_t full = cache->tune_full;
+    int newsize;
+
+    cache->tune_hits = hits;
+    cache->tune_misses = 0;
+    cache->tune_full = 0;
+
+    if (misses * 4 <= requests || !full || global.cache_size >= MAX_CACHE)
+        return;
+
+    newsize = global.cache_size < 8 ? 16 : global.cache_size * 2;
+    global.cache_size = newsize < MAX_CACHE ? newsize : MAX_CACHE;
+    set_cache_limits();
+}
+
+/* Record that an object was freed instead of cached because it is larger
+ * than cache_obsize.
+ */
+
+static void
+GMPy_Cache_Oversize(size_t which)
+{
+    GMPy_Cache *cache;
+
+    if ((cache = GMPy_Cache_Get()))
+        GMPY_OBJECT_CACHE(cache, which)->oversize++;
+}
+
+/* Return the approximate number of bytes used by a cached object,
+ * including its limbs.
+ */
+
+static size_t
+GMPy_Cache_Bytes(size_t which, void *obj)
+{
+    size_t limbs;
+
+    if (which == GMPY_CACHE_MPZ)
+        return sizeof(MPZ_Object) + ((MPZ_Object*)obj)->z->_mp_alloc * sizeof(mp_limb_t);
+    if (which == GMPY_CACHE_XMPZ)
+        return sizeof(XMPZ_Object) + ((XMPZ_Object*)obj)->z->_mp_alloc * sizeof(mp_limb_t);
+    if (which == GMPY_CACHE_MPQ) {
+        limbs = mpq_numref(((MPQ_Object*)obj)->q)->_mp_alloc +
+                mpq_denref(((MPQ_Object*)obj)->q)->_mp_alloc;
+        return sizeof(MPQ_Object) + limbs * sizeof(mp_limb_t);
+    }
+    if (which == GMPY_CACHE_MPFR)
+        return sizeof(MPFR_Object) + mpfr_custom_get_size(mpfr_get_prec(((MPFR_Object*)obj)->f));
+    return sizeof(MPC_Object) +
+           mpfr_custom_get_size(mpfr_get_prec(mpc_realref(((MPC_Object*)obj)->c))) +
+           mpfr_custom_get_size(mpfr_get_prec(mpc_imagref(((MPC_Object*)obj)->c)));
+}
+
+/* Clear the hit, miss, oversize, and full counts of the caches of a
+ * thread.
+ */
+
+static void
+GMPy_Cache_Reset_Stats(GMPy_Cache *cache)
+{
+    GMPy_Object_Cache *oc;
+    int i, k;
+
+    for (k = 0; k < GMPY_CACHE_BINS; k++)
+        cache->z.bin[k].hits = cache->z.bin[k].misses = 0;
+    cache->z.oversize = cache->z.full = 0;
+
+    for (i = 0; i < (int)(sizeof(gmpy_cache_kinds) / sizeof(size_t)); i++) {
+        oc = GMPY_OBJECT_CACHE(cache, gmpy_cache_kinds[i]);
+        for (k = 0; k < GMPY_CACHE_BINS; k++)
+            oc->bin[k].hits = oc->bin[k].misses = 0;
+        oc->oversize = oc->full = 0;
+    }
+    cache->tune_hits = cache->tune_misses = cache->tune_full = 0;
+}
+
+static int
+GMPy_Cache_Init(void)
+{
+#ifdef GMPY_TLS
+    if (!(gmpy_cache_lock = PyThread_allocate_lock())) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    if (!(gmpy_cache_key = PyUnicode_FromString("__GMPY2_CACHE__")))
+        return -1;
+    if (GMPy_Cache_Resize(&gmpy_cache_pool) < 0) {
+        PyErr_NoMemory();
+        return -1;
+    }
+#endif
+    return 0;
+}
+
+/* Initialize newo with room for at least size limbs. size is only a hint;
+ * use 0 if the size is not known. If newo must be allocated and is small
+ * enough to be cached, the size is rounded up to the smallest size in its
+ * bin so newo can be reused for the same request later. The zcache of each
+ * thread does not use the global pool.
+ */
+
+static void
+mpz_inoc_size(mpz_t newo, size_t size)
+{
+    GMPy_Cache *cache;
+    int k, first, last;
+
+    if ((cache = GMPy_Cache_Get()) && GMPy_Cache_Range(size, &first, &last)) {
+        for (k = first; k <= last; k++) {
+            if (cache->z.bin[k].in_cache) {
+                cache->z.bin[k].hits++;
+                newo[0] = (cache->z.items[k][--cache->z.bin[k].in_cache])[0];
+                return;
+            }
+        }
+        cache->z.bin[first].misses++;
+        if (global.cache_autotune && ++cache->tune_misses >= GMPY_CACHE_TUNE_WINDOW)
+            GMPy_Cache_Tune(cache);
+    }
+
+    if (size > 1) {
+        k = GMPy_Cache_FitIndex(size);
+        if (k < GMPY_CACHE_BINS && ((size_t)1 << k) <= (size_t)global.cache_obsize)
+            size = (size_t)1 << k;
+        mpz_init2(newo, (mp_bitcnt_t)size * GMP_NUMB_BITS);
     }
     else {
         mpz_init(newo);
     }
 }
 
+static void
+mpz_inoc(mpz_t newo)
+{
+    mpz_inoc_size(newo, 0);
+}
+
 static void
 mpz_cloc(mpz_t oldo)
 {
-    if (in_zcache<global.cache_size && oldo->_mp_alloc <= global.cache_obsize) {
-        (zcache[in_zcache++])[0] = oldo[0];
+    GMPy_Cache *cache;
+    int k = GMPy_Cache_BinIndex(oldo->_mp_alloc);
+
+    if (!(cache = GMPy_Cache_Get())) {
+        mpz_clear(oldo);
+    }
+    else if (oldo->_mp_alloc > global.cache_obsize) {
+        cache->z.oversize++;
+        mpz_clear(oldo);
+    }
+    else if (cache->z.bin[k].in_cache < cache->z.bin[k].limit) {
+        (cache->z.items[k][cache->z.bin[k].in_cache++])[0] = oldo[0];
     }
     else {
+        cache->z.full++;
+        cache->tune_full++;
         mpz_clear(oldo);
     }
 }
 
 /* Caching logic for Pympz. */
 
-static void
-set_gmpympzcache(void)
-{
-    if (in_gmpympzcache > global.cache_size) {
-        int i;
-        for (i = global.cache_size; i < in_gmpympzcache; ++i) {
-            mpz_cloc(gmpympzcache[i]->z);
-            PyObject_Del(gmpympzcache[i]);
-        }
-        in_gmpympzcache = global.cache_size;
-    }
-    gmpympzcache = GMPY_REALLOC(gmpympzcache, sizeof(MPZ_Object)*global.cache_size);
-}
+/* Return a new mpz with room for at least size limbs. size is only a hint;
+ * use 0 if the size of the result is not known.
+ */
 
 static MPZ_Object *
-GMPy_MPZ_New(CTXT_Object *context)
+GMPy_MPZ_NewSize(size_t size, CTXT_Object *context)
 {
-    MPZ_Object *result;
+    MPZ_Object *result = NULL;
+    GMPy_Cache *cache;
+    int first, last;
 
-    if (in_gmpympzcache) {
-        result = gmpympzcache[--in_gmpympzcache];
+    if ((cache = GMPy_Cache_Get()) && GMPy_Cache_Range(size, &first, &last))
+        result = (MPZ_Object*)GMPy_Cache_Take(cache, GMPY_CACHE_MPZ, first, last);
+
+    if (result) {
         /* Py_INCREF does not set the debugging pointers, so need to use
          * _Py_NewReference instead. */
         _Py_NewReference((PyObject*)result);
@@ -104,48 +655,86 @@ GMPy_MPZ_New(CTXT_Object *context)
     else {
         if (!(result = PyObject_New(MPZ_Object, &MPZ_Type)))
             return NULL;
-        mpz_inoc(result->z);
+        mpz_inoc_size(result->z, size);
     }
     result->hash_cache = -1;
     return result;
 }
 
+static MPZ_Object *
+GMPy_MPZ_New(CTXT_Object *context)
+{
+    return GMPy_MPZ_NewSize(0, context);
+}
+
+/* Return an mpz with the value of a C long. Small values are interned. */
+
+static MPZ_Object *
+GMPy_MPZ_From_SI(long value, CTXT_Object *context)
+{
+    MPZ_Object *result;
+
+    if (GMPY_IS_SMALL_MPZ(value)) {
+        result = gmpy_small_mpz[value - GMPY_SMALL_MPZ_MIN];
+        Py_INCREF((PyObject*)result);
+        return result;
+    }
+
+    if ((result = GMPy_MPZ_New(context)))
+        mpz_set_si(result->z, value);
+    return result;
+}
+
+/* Create the interned mpz values. Returns -1 (with an exception set) on
+ * failure.
+ */
+
+static int
+GMPy_MPZ_Small_Init(void)
+{
+    long i;
+
+    for (i = GMPY_SMALL_MPZ_MIN; i <= GMPY_SMALL_MPZ_MAX; i++) {
+        if (!gmpy_small_mpz[i - GMPY_SMALL_MPZ_MIN]) {
+            if (!(gmpy_small_mpz[i - GMPY_SMALL_MPZ_MIN] = GMPy_MPZ_New(NULL)))
+                return -1;
+            mpz_set_si(gmpy_small_mpz[i - GMPY_SMALL_MPZ_MIN]->z, i);
+        }
+    }
+    return 0;
+}
+
 static void
 GMPy_MPZ_Dealloc(MPZ_Object *self)
 {
-    if (in_gmpympzcache < global.cache_size &&
-        self->z->_mp_alloc <= global.cache_obsize) {
-        gmpympzcache[in_gmpympzcache++] = self;
+    GMPy_Cache *cache;
+
+    if (self->z->_mp_alloc > global.cache_obsize) {
+        GMPy_Cache_Oversize(GMPY_CACHE_MPZ);
+        mpz_clear(self->z);
+    }
+    else if ((cache = GMPy_Cache_Get()) &&
+             GMPy_Cache_Put(cache, GMPY_CACHE_MPZ, GMPy_Cache_BinIndex(self->z->_mp_alloc), self)) {
+        return;
     }
     else {
         mpz_cloc(self->z);
-        PyObject_Del(self);
     }
+    PyObject_Del(self);
 }
 
 /* Caching logic for Pyxmpz. */
 
-static void
-set_gmpyxmpzcache(void)
-{
-    if (in_gmpyxmpzcache > global.cache_size) {
-        int i;
-        for (i = global.cache_size; i < in_gmpyxmpzcache; ++i) {
-            mpz_cloc(gmpyxmpzcache[i]->z);
-            PyObject_Del(gmpyxmpzcache[i]);
-        }
-        in_gmpyxmpzcache = global.cache_size;
-    }
-    gmpyxmpzcache = GMPY_REALLOC(gmpyxmpzcache, sizeof(XMPZ_Object)*global.cache_size);
-}
-
 static XMPZ_Object *
 GMPy_XMPZ_New(CTXT_Object *context)
 {
-    XMPZ_Object *result;
+    XMPZ_Object *result = NULL;
+    GMPy_Cache *cache;
+
+    if ((cache = GMPy_Cache_Get()))
+        result = (XMPZ_Object*)GMPy_Cache_Take(cache, GMPY_CACHE_XMPZ, 0, GMPY_CACHE_BINS - 1);
 
-    if (in_gmpyxmpzcache) {
-        result = gmpyxmpzcache[--in_gmpyxmpzcache];
+    if (result) {
         /* Py_INCREF does not set the debugging pointers, so need to use
          * _Py_NewReference instead. */
         _Py_NewReference((PyObject*)result);
@@ -161,39 +750,34 @@ GMPy_XMPZ_New(CTXT_Object *context)
 static void
 GMPy_XMPZ_Dealloc(XMPZ_Object *obj)
 {
-    if (in_gmpyxmpzcache < global.cache_size &&
-        obj->z->_mp_alloc <= global.cache_obsize) {
-        gmpyxmpzcache[in_gmpyxmpzcache++] = obj;
+    GMPy_Cache *cache;
+
+    if (obj->z->_mp_alloc > global.cache_obsize) {
+        GMPy_Cache_Oversize(GMPY_CACHE_XMPZ);
+        mpz_clear(obj->z);
+    }
+    else if ((cache = GMPy_Cache_Get()) &&
+             GMPy_Cache_Put(cache, GMPY_CACHE_XMPZ, GMPy_Cache_BinIndex(obj->z->_mp_alloc), obj)) {
+        return;
     }
     else {
         mpz_cloc(obj->z);
-        PyObject_Del((PyObject*)obj);
     }
+    PyObject_Del((PyObject*)obj);
 }
 
 /* Caching logic for Pympq. */
 
-static void
-set_gmpympqcache(void)
-{
-    if (in_gmpympqcache > global.cache_size) {
-        int i;
-        for (i = global.cache_size; i < in_gmpympqcache; ++i) {
-            mpq_clear(gmpympqcache[i]->q);
-            PyObject_Del(gmpympqcache[i]);
-        }
-        in_gmpympqcache = global.cache_size;
-    }
-    gmpympqcache = GMPY_REALLOC(gmpympqcache, sizeof(MPQ_Object)*global.cache_size);
-}
-
 static MPQ_Object *
 GMPy_MPQ_New(CTXT_Object *context)
 {
-    MPQ_Object *result;
+    MPQ_Object *result = NULL;
+    GMPy_Cache *cache;
+
+    if ((cache = GMPy_Cache_Get()))
+        result = (MPQ_Object*)GMPy_Cache_Take(cache, GMPY_CACHE_MPQ, 0, 0);
 
-    if (in_gmpympqcache) {
-        result = gmpympqcache[--in_gmpympqcache];
+    if (result) {
         /* Py_INCREF does not set the debugging pointers, so need to use
            _Py_NewReference instead. */
         _Py_NewReference((PyObject*)result);
@@ -210,37 +794,55 @@ GMPy_MPQ_New(CTXT_Object *context)
 static void
 GMPy_MPQ_Dealloc(MPQ_Object *self)
 {
-    if (in_gmpympqcache<global.cache_size &&
-        mpq_numref(self->q)->_mp_alloc <= global.cache_obsize &&
-        mpq_denref(self->q)->_mp_alloc <= global.cache_obsize) {
-        gmpympqcache[in_gmpympqcache++] = self;
+    GMPy_Cache *cache;
+
+    if (mpq_numref(self->q)->_mp_alloc > global.cache_obsize ||
+        mpq_denref(self->q)->_mp_alloc > global.cache_obsize) {
+        GMPy_Cache_Oversize(GMPY_CACHE_MPQ);
     }
-    else {
-        mpq_clear(self->q);
-        PyObject_Del(self);
+    else if ((cache = GMPy_Cache_Get()) &&
+             GMPy_Cache_Put(cache, GMPY_CACHE_MPQ, 0, self)) {
+        return;
     }
+    mpq_clear(self->q);
+    PyObject_Del(self);
 }
 
 /* Caching logic for Pympfr. */
 
+/* Return the size class of a mantissa with a precision of bits. */
+
+#define GMPY_MPFR_BIN(bits) \
+    GMPy_Cache_FitIndex(((size_t)(bits) + mp_bits_per_limb - 1) / mp_bits_per_limb)
+
+/* True if the objects in size class k are larger than cache_obsize. */
+
+#define GMPY_CACHE_OVERSIZE(k) \
+    ((k) >= GMPY_CACHE_BINS || ((size_t)1 << (k)) > (size_t)global.cache_obsize)
+
+/* Initialize f with a precision of bits. If objects of size class k are
+ * cached, the mantissa is allocated with the largest number of limbs in
+ * the size class so f can later be reused for any precision in it.
+ */
+
 static void
-set_gmpympfrcache(void)
+mpfr_init_bin(mpfr_ptr f, mpfr_prec_t bits, int k)
 {
-    if (in_gmpympfrcache > global.cache_size) {
-        int i;
-        for (i = global.cache_size; i < in_gmpympfrcache; ++i) {
-            mpfr_clear(gmpympfrcache[i]->f);
-            PyObject_Del(gmpympfrcache[i]);
-        }
-        in_gmpympfrcache = global.cache_size;
+    if (k < GMPY_CACHE_BINS && GMPy_Cache_BinLimit(1, k)) {
+        mpfr_init2(f, (mpfr_prec_t)mp_bits_per_limb << k);
+        mpfr_set_prec(f, bits);
+    }
+    else {
+        mpfr_init2(f, bits);
     }
-    gmpympfrcache = GMPY_REALLOC(gmpympfrcache, sizeof(MPFR_Object)*global.cache_size);
 }
 
 static MPFR_Object *
 GMPy_MPFR_New(mpfr_prec_t bits, CTXT_Object *context)
 {
-    MPFR_Object *result;
+    MPFR_Object *result = NULL;
+    GMPy_Cache *cache;
+    int k;
 
     if (bits == 0 || bits == 1)
         bits = GET_MPFR_PREC(context) + bits * GET_GUARD_BITS(context);
@@ -250,8 +852,11 @@ GMPy_MPFR_New(mpfr_prec_t bits, CTXT_Object *context)
         return NULL;
     }
 
-    if (in_gmpympfrcache) {
-        result = gmpympfrcache[--in_gmpympfrcache];
+    k = GMPY_MPFR_BIN(bits);
+    if (k < GMPY_CACHE_BINS && (cache = GMPy_Cache_Get()))
+        result = (MPFR_Object*)GMPy_Cache_Take(cache, GMPY_CACHE_MPFR, k, k);
+
+    if (result) {
         /* Py_INCREF does not set the debugging pointers, so need to use
            _Py_NewReference instead. */
         _Py_NewReference((PyObject*)result);
@@ -260,7 +865,7 @@ GMPy_MPFR_New(mpfr_prec_t bits, CTXT_Object *context)
     else {
         if (!(result = PyObject_New(MPFR_Object, &MPFR_Type)))
             return NULL;
-        mpfr_init2(result->f, bits);
+        mpfr_init_bin(result->f, bits, k);
     }
     result->hash_cache = -1;
     result->rc = 0;
@@ -270,39 +875,32 @@ GMPy_MPFR_New(mpfr_prec_t bits, CTXT_Object *context)
 static void
 GMPy_MPFR_Dealloc(MPFR_Object *self)
 {
-    size_t msize;
+    GMPy_Cache *cache;
+    int k = GMPY_MPFR_BIN(mpfr_get_prec(self->f));
 
-    /* Calculate the number of limbs in the mantissa. */
-    msize = (self->f->_mpfr_prec + mp_bits_per_limb - 1) / mp_bits_per_limb;
-    if (in_gmpympfrcache < global.cache_size &&
-        msize <= (size_t)global.cache_obsize) {
-        gmpympfrcache[in_gmpympfrcache++] = self;
+    if (GMPY_CACHE_OVERSIZE(k)) {
+        GMPy_Cache_Oversize(GMPY_CACHE_MPFR);
     }
-    else {
-        mpfr_clear(self->f);
-        PyObject_Del(self);
+    else if ((cache = GMPy_Cache_Get()) &&
+             GMPy_Cache_Put(cache, GMPY_CACHE_MPFR, k, self)) {
+        return;
     }
+    mpfr_clear(self->f);
+    PyObject_Del(self);
 }
 
-static void
-set_gmpympccache(void)
-{
-    if (in_gmpympccache > global.cache_size) {
-        int i;
-        for (i = global.cache_size; i < in_gmpympccache; ++i) {
-            mpc_clear(gmpympccache[i]->c);
-            PyObject_Del(gmpympccache[i]);
-        }
-        in_gmpympccache = global.cache_size;
-    }
-    gmpympccache = GMPY_REALLOC(gmpympccache, sizeof(MPC_Object)*global.cache_size);
-}
+/* Caching logic for Pympc. */
 
+/* An mpc is kept in the size class of the larger of its two parts. Both
+ * parts are allocated with the largest number of limbs in that size class.
+ */
 
 static MPC_Object *
 GMPy_MPC_New(mpfr_prec_t rprec, mpfr_prec_t iprec, CTXT_Object *context)
 {
-    MPC_Object *self;
+    MPC_Object *self = NULL;
+    GMPy_Cache *cache;
+    int k;
 
     CHECK_CONTEXT_SET_EXPONENT(context);
 
@@ -316,23 +914,23 @@ GMPy_MPC_New(mpfr_prec_t rprec, mpfr_prec_t iprec, CTXT_Object *context)
         VALUE_ERROR("invalid value for precision");
         return NULL;
     }
-    if (in_gmpympccache) {
-        self = gmpympccache[--in_gmpympccache];
+
+    k = GMPY_MPFR_BIN(rprec > iprec ? rprec : iprec);
+    if (k < GMPY_CACHE_BINS && (cache = GMPy_Cache_Get()))
+        self = (MPC_Object*)GMPy_Cache_Take(cache, GMPY_CACHE_MPC, k, k);
+
+    if (self) {
         /* Py_INCREF does not set the debugging pointers, so need to use
            _Py_NewReference instead. */
         _Py_NewReference((PyObject*)self);
-        if (rprec == iprec) {
-            mpc_set_prec(self->c, rprec);
-        }
-        else {
-            mpc_clear(self->c);
-            mpc_init3(self->c, rprec, iprec);
-        }
+        mpfr_set_prec(mpc_realref(self->c), rprec);
+        mpfr_set_prec(mpc_imagref(self->c), iprec);
     }
     else {
         if (!(self = PyObject_New(MPC_Object, &MPC_Type)))
             return NULL;
-        mpc_init3(self->c, rprec, iprec);
+        mpfr_init_bin(mpc_realref(self->c), rprec, k);
+        mpfr_init_bin(mpc_imagref(self->c), iprec, k);
     }
     self->hash_cache = -1;
     self->rc = 0;
@@ -342,18 +940,18 @@ GMPy_MPC_New(mpfr_prec_t rprec, mpfr_prec_t iprec, CTXT_Object *context)
 static void
 GMPy_MPC_Dealloc(MPC_Object *self)
 {
-    size_t msize;
+    GMPy_Cache *cache;
+    mpfr_prec_t rprec = mpfr_get_prec(mpc_realref(self->c));
+    mpfr_prec_t iprec = mpfr_get_prec(mpc_imagref(self->c));
+    int k = GMPY_MPFR_BIN(rprec > iprec ? rprec : iprec);
 
-    /* Calculate the number of limbs in the mantissa. */
-    msize = (mpc_realref(self->c)->_mpfr_prec + mp_bits_per_limb - 1) / mp_bits_per_limb;
-    msize += (mpc_imagref(self->c)->_mpfr_prec + mp_bits_per_limb - 1) / mp_bits_per_limb;
-    if (in_gmpympccache < global.cache_size &&
-        msize <= (size_t)global.cache_obsize) {
-        gmpympccache[in_gmpympccache++] = self;
+    if (GMPY_CACHE_OVERSIZE(k)) {
+        GMPy_Cache_Oversize(GMPY_CACHE_MPC);
     }
-    else {
-        mpc_clear(self->c);
-        PyObject_Del(self);
+    else if ((cache = GMPy_Cache_Get()) &&
+             GMPy_Cache_Put(cache, GMPY_CACHE_MPC, k, self)) {
+        return;
     }
+    mpc_clear(self->c);
+    PyObject_Del(self);
 }
-
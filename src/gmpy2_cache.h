@@ -26,20 +26,6 @@
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
 
-/* gmpy2 caches objects so they can be reused quickly without involving a new
- * memory allocation or object construction. There are two different types of
- * object caches used in gmpy2.
- *
- * "zcache" is used to cache mpz_t objects. The cache is accessed via the
- * functions mpz_inoc/mpz_cloc. The function set_zcache is used to change
- * the size of the array used to store the cached objects.
- *
- * The "py???cache" is used to cache Py??? objects. The cache is accessed
- * via Py???_new/Py???_dealloc. The functions set_py???cache and
- * set_py???cache are used to change the size of the array used to the store
- * the cached objects.
- */
-
 #ifndef GMPY_CACHE_H
 #define GMPY_CACHE_H
 
@@ -47,27 +33,106 @@
 extern "C" {
 #endif
 
-static void          set_zcache(void);
+/* Return the number of limbs in x if it is an mpz or xmpz, or 0. Used to
+ * estimate the size of a result for GMPy_MPZ_NewSize().
+ */
+#define GMPY_MPZ_SIZE(x) (CHECK_MPZANY(x) ? mpz_size(MPZ(x)) : 0)
+
+/* Estimate the number of limbs needed for x + y and x // y. */
+#define GMPY_ADD_SIZE(x, y) \
+    ((GMPY_MPZ_SIZE(x) > GMPY_MPZ_SIZE(y) ? GMPY_MPZ_SIZE(x) : GMPY_MPZ_SIZE(y)) + 1)
+#define GMPY_DIV_SIZE(x, y) \
+    (GMPY_MPZ_SIZE(x) > GMPY_MPZ_SIZE(y) ? GMPY_MPZ_SIZE(x) - GMPY_MPZ_SIZE(y) + 1 : 0)
+
+/* The caches used by one thread. Each object cache stores pointers to
+ * objects of a single type; the mpq cache only uses bin 0.
+ * A cache is resized when its generation differs from
+ * gmpy_cache_generation.
+ */
+
+typedef struct {
+    void **items[GMPY_CACHE_BINS];
+    GMPy_Cache_Bin bin[GMPY_CACHE_BINS];
+    size_t oversize;         /* objects freed because of cache_obsize */
+    size_t full;             /* objects freed because the cache was full */
+} GMPy_Object_Cache;
+
+typedef struct {
+    mpz_t *items[GMPY_CACHE_BINS];
+    GMPy_Cache_Bin bin[GMPY_CACHE_BINS];
+    size_t oversize;         /* values freed because of cache_obsize */
+    size_t full;             /* values freed because the cache was full */
+} GMPy_ZCache;
+
+typedef struct {
+    GMPy_ZCache z;
+    GMPy_Object_Cache mpz;
+    GMPy_Object_Cache xmpz;
+    GMPy_Object_Cache mpq;
+    GMPy_Object_Cache mpfr;
+    GMPy_Object_Cache mpc;
+    int generation;
+    size_t tune_hits;        /* hits when the miss rate was last checked */
+    size_t tune_misses;      /* misses since the miss rate was last checked */
+    size_t tune_full;        /* objects freed since then because a cache was full */
+} GMPy_Cache;
+
+/* When auto-tuning is enabled, the miss rate of the caches of a thread is
+ * checked after every GMPY_CACHE_TUNE_WINDOW misses.
+ */
+#define GMPY_CACHE_TUNE_WINDOW 1024
+
+#define GMPY_CACHE_MPZ  offsetof(GMPy_Cache, mpz)
+#define GMPY_CACHE_XMPZ offsetof(GMPy_Cache, xmpz)
+#define GMPY_CACHE_MPQ  offsetof(GMPy_Cache, mpq)
+#define GMPY_CACHE_MPFR offsetof(GMPy_Cache, mpfr)
+#define GMPY_CACHE_MPC  offsetof(GMPy_Cache, mpc)
+#define GMPY_OBJECT_CACHE(cache, which) \
+    ((GMPy_Object_Cache*)((char*)(cache) + (which)))
+
+static int           GMPy_Cache_BinIndex(size_t alloc);
+static int           GMPy_Cache_FitIndex(size_t size);
+static int           GMPy_Cache_BinLimit(int binned, int k);
+static int           GMPy_Cache_Range(size_t size, int *first, int *last);
+static GMPy_Cache *  GMPy_Cache_Get(void);
+static void *        GMPy_Cache_Take(GMPy_Cache *cache, size_t which, int first, int last);
+static int           GMPy_Cache_Put(GMPy_Cache *cache, size_t which, int k, void *obj);
+static int           GMPy_Cache_Init(void);
+static void          GMPy_Cache_Tune(GMPy_Cache *cache);
+static void          GMPy_Cache_Oversize(size_t which);
+static size_t        GMPy_Cache_Bytes(size_t which, void *obj);
+static void          GMPy_Cache_Reset_Stats(GMPy_Cache *cache);
+static void          set_cache_limits(void);
+
 static void          mpz_inoc(mpz_t newo);
+static void          mpz_inoc_size(mpz_t newo, size_t size);
 static void          mpz_cloc(mpz_t oldo);
 
-static void          set_gmpympzcache(void);
+/* Values in the range GMPY_SMALL_MPZ_MIN to GMPY_SMALL_MPZ_MAX are interned,
+ * like the small integers of CPython. GMPy_MPZ_From_SI() and the
+ * conversion of a Python integer return a new reference to the shared
+ * object, so an mpz returned by GMPy_MPZ_From_Integer() or
+ * GMPy_MPZ_From_Number() must never be modified.
+ */
+#define GMPY_SMALL_MPZ_MIN (-5)
+#define GMPY_SMALL_MPZ_MAX 256
+#define GMPY_IS_SMALL_MPZ(v) ((v) >= GMPY_SMALL_MPZ_MIN && (v) <= GMPY_SMALL_MPZ_MAX)
+
 static MPZ_Object *  GMPy_MPZ_New(CTXT_Object *context);
+static MPZ_Object *  GMPy_MPZ_From_SI(long value, CTXT_Object *context);
+static int           GMPy_MPZ_Small_Init(void);
+static MPZ_Object *  GMPy_MPZ_NewSize(size_t size, CTXT_Object *context);
 static void          GMPy_MPZ_Dealloc(MPZ_Object *self);
 
-static void          set_gmpyxmpzcache(void);
 static XMPZ_Object * GMPy_XMPZ_New(CTXT_Object *context);
 static void          GMPy_XMPZ_Dealloc(XMPZ_Object *self);
 
-static void          set_gmpympqcache(void);
 static MPQ_Object *  GMPy_MPQ_New(CTXT_Object *context);
 static void          GMPy_MPQ_Dealloc(MPQ_Object *self);
 
-static void          set_gmpympfrcache(void);
 static MPFR_Object * GMPy_MPFR_New(mpfr_prec_t bits, CTXT_Object *context);
 static void          GMPy_MPFR_Dealloc(MPFR_Object *self);
 
-static void          set_gmpympccache(void);
 static MPC_Object *  GMPy_MPC_New(mpfr_prec_t rprec, mpfr_prec_t iprec, CTXT_Object *context);
 static void          GMPy_MPC_Dealloc(MPC_Object *self);
 
@@ -0,0 +1,242 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_capi.h                                                            *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* gmpy2 C API extension header file.
+ *
+ * This file defines the layout of the gmpy2 objects and the table of
+ * pointers that is exported by gmpy2 as the capsule "gmpy2._C_API".
+ *
+ * gmpy2.c defines GMPY2_MODULE before including this file (via gmpy2.h).
+ * Other extensions must include Python.h, gmp.h (or mpir.h), mpfr.h, and
+ * mpc.h before including this file and then call import_gmpy2() from
+ * their module initialization function. For example:
+ *
+ *     if (import_gmpy2() < 0)
+ *         return NULL;
+ *
+ *     context = GMPy_current_context();
+ *     if ((result = GMPy_MPZ_New(context)))
+ *         mpz_set_ui(MPZ(result), 42);
+ *
+ * All the functions must be called while holding the GIL. Unless noted,
+ * the context argument must not be NULL; use GMPy_current_context() to get
+ * a borrowed reference to the current context. Objects returned by the
+ * functions are new references and are released with Py_DECREF. Only the
+ * objects returned by the GMPy_???_New functions may be modified; the
+ * conversion functions can return a reference to an existing object, such
+ * as an interned small mpz.
+ *
+ * The table is versioned. New entries are only appended to the end of the
+ * table and GMPY2_CAPI_VERSION is incremented when that happens.
+ * import_gmpy2() fails if the installed version of gmpy2 exports an older
+ * version of the table than the one the extension was compiled with.
+ *
+ * The capsule requires Python 2.7 or later.
+ */
+
+#ifndef GMPY2_CAPI_H
+#define GMPY2_CAPI_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GMPY2_CAPI_VERSION 1
+#define GMPY2_CAPI_NAME "gmpy2._C_API"
+
+#ifndef GMPY2_MODULE
+#  if PY_VERSION_HEX < 0x030200A4
+typedef long Py_hash_t;
+#  endif
+typedef struct GMPy_CTXT_Object CTXT_Object;
+#endif
+
+/* Object layouts. */
+
+typedef struct {
+    PyObject_HEAD
+    mpz_t z;
+    Py_hash_t hash_cache;
+} MPZ_Object;
+
+typedef struct {
+    PyObject_HEAD
+    mpz_t z;
+} XMPZ_Object;
+
+typedef struct {
+    PyObject_HEAD
+    mpq_t q;
+    Py_hash_t  hash_cache;
+} MPQ_Object;
+
+typedef struct {
+    PyObject_HEAD
+    mpfr_t f;
+    Py_hash_t hash_cache;
+    int rc;
+} MPFR_Object;
+
+typedef struct {
+    PyObject_HEAD
+    mpc_t c;
+    Py_hash_t hash_cache;
+    int rc;
+} MPC_Object;
+
+#define MPZ(obj) (((MPZ_Object*)(obj))->z)
+#define XMPZ(obj) (((XMPZ_Object*)(obj))->z)
+#define MPQ(obj) (((MPQ_Object *)(obj))->q)
+#define MPFR(obj) (((MPFR_Object *)(obj))->f)
+#define MPC(obj) (((MPC_Object *)(obj))->c)
+
+#define MPZ_Check(v) (((PyObject*)v)->ob_type == &MPZ_Type)
+#define XMPZ_Check(v) (((PyObject*)v)->ob_type == &XMPZ_Type)
+#define MPQ_Check(v) (((PyObject*)v)->ob_type == &MPQ_Type)
+#define MPFR_Check(v) (((PyObject*)v)->ob_type == &MPFR_Type)
+#define MPC_Check(v) (((PyObject*)v)->ob_type == &MPC_Type)
+#define CTXT_Check(v) (((PyObject*)v)->ob_type == &CTXT_Type)
+
+/* Indexes into the table. Entry 0 is the version of the table. */
+
+#define GMPy_CAPI_Version_NUM              0
+#define MPZ_Type_NUM                       1
+#define XMPZ_Type_NUM                      2
+#define MPQ_Type_NUM                       3
+#define MPFR_Type_NUM                      4
+#define MPC_Type_NUM                       5
+#define CTXT_Type_NUM                      6
+#define GMPy_current_context_NUM           7
+#define GMPy_MPZ_New_NUM                   8
+#define GMPy_XMPZ_New_NUM                  9
+#define GMPy_MPQ_New_NUM                  10
+#define GMPy_MPFR_New_NUM                 11
+#define GMPy_MPC_New_NUM                  12
+#define GMPy_MPZ_From_Integer_NUM         13
+#define GMPy_MPZ_From_Number_NUM          14
+#define GMPy_MPZ_From_PyStr_NUM           15
+#define GMPy_PyIntOrLong_From_MPZ_NUM     16
+#define GMPy_PyStr_From_MPZ_NUM           17
+#define GMPy_MPQ_From_Rational_NUM        18
+#define GMPy_MPQ_From_Number_NUM          19
+#define GMPy_MPQ_From_PyStr_NUM           20
+#define GMPy_PyStr_From_MPQ_NUM           21
+#define GMPy_MPFR_From_Real_NUM           22
+#define GMPy_MPFR_From_PyStr_NUM          23
+#define GMPy_MPZ_From_MPFR_NUM            24
+#define GMPy_MPQ_From_MPFR_NUM            25
+#define GMPy_PyFloat_From_MPFR_NUM        26
+#define GMPy_PyStr_From_MPFR_NUM          27
+
+#define GMPy_CAPI_SIZE                    28
+
+#ifndef GMPY2_MODULE
+
+static void **GMPy_C_API = NULL;
+
+#define MPZ_Type (*(PyTypeObject *)GMPy_C_API[MPZ_Type_NUM])
+#define XMPZ_Type (*(PyTypeObject *)GMPy_C_API[XMPZ_Type_NUM])
+#define MPQ_Type (*(PyTypeObject *)GMPy_C_API[MPQ_Type_NUM])
+#define MPFR_Type (*(PyTypeObject *)GMPy_C_API[MPFR_Type_NUM])
+#define MPC_Type (*(PyTypeObject *)GMPy_C_API[MPC_Type_NUM])
+#define CTXT_Type (*(PyTypeObject *)GMPy_C_API[CTXT_Type_NUM])
+
+/* Return a borrowed reference to the current context. */
+#define GMPy_current_context \
+    (*(CTXT_Object *(*)(void))GMPy_C_API[GMPy_current_context_NUM])
+
+/* Allocate new objects. The values are not initialized. A precision of 0
+ * uses the precision of the context.
+ */
+#define GMPy_MPZ_New \
+    (*(MPZ_Object *(*)(CTXT_Object *))GMPy_C_API[GMPy_MPZ_New_NUM])
+#define GMPy_XMPZ_New \
+    (*(XMPZ_Object *(*)(CTXT_Object *))GMPy_C_API[GMPy_XMPZ_New_NUM])
+#define GMPy_MPQ_New \
+    (*(MPQ_Object *(*)(CTXT_Object *))GMPy_C_API[GMPy_MPQ_New_NUM])
+#define GMPy_MPFR_New \
+    (*(MPFR_Object *(*)(mpfr_prec_t, CTXT_Object *))GMPy_C_API[GMPy_MPFR_New_NUM])
+#define GMPy_MPC_New \
+    (*(MPC_Object *(*)(mpfr_prec_t, mpfr_prec_t, CTXT_Object *))GMPy_C_API[GMPy_MPC_New_NUM])
+
+/* Conversions between Python objects and gmpy2 objects. */
+#define GMPy_MPZ_From_Integer \
+    (*(MPZ_Object *(*)(PyObject *, CTXT_Object *))GMPy_C_API[GMPy_MPZ_From_Integer_NUM])
+#define GMPy_MPZ_From_Number \
+    (*(MPZ_Object *(*)(PyObject *, CTXT_Object *))GMPy_C_API[GMPy_MPZ_From_Number_NUM])
+#define GMPy_MPZ_From_PyStr \
+    (*(MPZ_Object *(*)(PyObject *, int, CTXT_Object *))GMPy_C_API[GMPy_MPZ_From_PyStr_NUM])
+#define GMPy_PyIntOrLong_From_MPZ \
+    (*(PyObject *(*)(MPZ_Object *, CTXT_Object *))GMPy_C_API[GMPy_PyIntOrLong_From_MPZ_NUM])
+#define GMPy_PyStr_From_MPZ \
+    (*(PyObject *(*)(MPZ_Object *, int, int, CTXT_Object *))GMPy_C_API[GMPy_PyStr_From_MPZ_NUM])
+#define GMPy_MPQ_From_Rational \
+    (*(MPQ_Object *(*)(PyObject *, CTXT_Object *))GMPy_C_API[GMPy_MPQ_From_Rational_NUM])
+#define GMPy_MPQ_From_Number \
+    (*(MPQ_Object *(*)(PyObject *, CTXT_Object *))GMPy_C_API[GMPy_MPQ_From_Number_NUM])
+#define GMPy_MPQ_From_PyStr \
+    (*(MPQ_Object *(*)(PyObject *, int, CTXT_Object *))GMPy_C_API[GMPy_MPQ_From_PyStr_NUM])
+#define GMPy_PyStr_From_MPQ \
+    (*(PyObject *(*)(MPQ_Object *, int, int, CTXT_Object *))GMPy_C_API[GMPy_PyStr_From_MPQ_NUM])
+#define GMPy_MPFR_From_Real \
+    (*(MPFR_Object *(*)(PyObject *, mpfr_prec_t, CTXT_Object *))GMPy_C_API[GMPy_MPFR_From_Real_NUM])
+#define GMPy_MPFR_From_PyStr \
+    (*(MPFR_Object *(*)(PyObject *, int, mpfr_prec_t, CTXT_Object *))GMPy_C_API[GMPy_MPFR_From_PyStr_NUM])
+#define GMPy_MPZ_From_MPFR \
+    (*(MPZ_Object *(*)(MPFR_Object *, CTXT_Object *))GMPy_C_API[GMPy_MPZ_From_MPFR_NUM])
+#define GMPy_MPQ_From_MPFR \
+    (*(MPQ_Object *(*)(MPFR_Object *, CTXT_Object *))GMPy_C_API[GMPy_MPQ_From_MPFR_NUM])
+#define GMPy_PyFloat_From_MPFR \
+    (*(PyObject *(*)(MPFR_Object *, CTXT_Object *))GMPy_C_API[GMPy_PyFloat_From_MPFR_NUM])
+#define GMPy_PyStr_From_MPFR \
+    (*(PyObject *(*)(MPFR_Object *, int, int, CTXT_Object *))GMPy_C_API[GMPy_PyStr_From_MPFR_NUM])
+
+/* Import the gmpy2 C API. Returns 0 on success and -1 (with an exception
+ * set) on failure.
+ */
+static int
+import_gmpy2(void)
+{
+    GMPy_C_API = (void **)PyCapsule_Import(GMPY2_CAPI_NAME, 0);
+    if (!GMPy_C_API)
+        return -1;
+
+    if ((Py_ssize_t)GMPy_C_API[GMPy_CAPI_Version_NUM] < GMPY2_CAPI_VERSION) {
+        GMPy_C_API = NULL;
+        PyErr_SetString(PyExc_ImportError,
+                        "gmpy2 C API version is too old");
+        return -1;
+    }
+    return 0;
+}
+
+#endif /* !GMPY2_MODULE */
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* !GMPY2_CAPI_H */
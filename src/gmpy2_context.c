@@ -98,6 +98,12 @@ GMPy_CTXT_New(void)
 static void
 GMPy_CTXT_Dealloc(CTXT_Object *self)
 {
+#if !defined(WITHOUT_THREADS) && defined(GMPY_TLS)
+    /* The thread state dictionary of the current thread released its
+     * context, for example while the thread exits. */
+    if (tls_context == self)
+        tls_context = NULL;
+#endif
     PyObject_Del(self);
 };
 
@@ -130,13 +136,85 @@ GMPy_CTXT_Set(PyObject *self, PyObject *other)
 
 /* Begin support for thread local contexts. */
 
+/* On Python 3.7 and later, the current context is the value of the
+ * contextvars.ContextVar current_context_var, so each asyncio task (or
+ * other user of contextvars.Context) has its own context. Older versions
+ * store the context in the thread state dictionary.
+ *
+ * The context most recently used by the current thread is also kept in
+ * thread-local storage (tls_context) when the compiler supports it. With
+ * contextvars, the cached value is only valid while the context_ver
+ * counter of the thread state is unchanged. CPython only changes the
+ * counter when a contextvars.Context is entered or exited; it does not
+ * change it when a ContextVar is set. The cache is still correct because
+ * gmpy2 does not export current_context_var, and every place that sets
+ * it also calls current_context_cache() with the new value.
+ */
+
+/* Remember the context of the current thread. */
+static void
+current_context_cache(CTXT_Object *context)
+{
+#if defined(GMPY_TLS)
+    tls_context = context;
+    tls_tstate = PyThreadState_GET();
+#  ifdef GMPY_CONTEXTVAR
+    tls_context_ver = tls_tstate->context_ver;
+#  endif
+#elif !defined(GMPY_CONTEXTVAR)
+    PyThreadState *tstate;
+
+    /* Cache the context of the current thread, assuming that it
+     * will be accessed several times before a thread switch. */
+    cached_context = NULL;
+    tstate = PyThreadState_GET();
+    if (tstate) {
+        cached_context = context;
+        cached_context->tstate = tstate;
+    }
+#endif
+}
+
+#ifdef GMPY_CONTEXTVAR
+
+/* Get the context from the context variable. */
+static CTXT_Object *
+current_context_from_var(void)
+{
+    PyObject *tl_context, *token;
+
+    if (PyContextVar_Get(current_context_var, NULL, &tl_context) < 0) {
+        return NULL;
+    }
+
+    if (!tl_context) {
+        /* Set up a new context. */
+        tl_context = GMPy_CTXT_New();
+        if (!tl_context) {
+            return NULL;
+        }
+
+        if (!(token = PyContextVar_Set(current_context_var, tl_context))) {
+            Py_DECREF(tl_context);
+            return NULL;
+        }
+        Py_DECREF(token);
+    }
+
+    /* The contextvars.Context keeps a reference. */
+    Py_DECREF(tl_context);
+    current_context_cache((CTXT_Object*)tl_context);
+    return (CTXT_Object*)tl_context;
+}
+
+#else
+
 /* Get the context from the thread state dictionary. */
 static CTXT_Object *
 current_context_from_dict(void)
 {
     PyObject *dict;
     PyObject *tl_context;
-    PyThreadState *tstate;
 
     dict = PyThreadState_GetDict();
     if (dict == NULL) {
@@ -169,43 +247,66 @@ current_context_from_dict(void)
         Py_DECREF(tl_context);
     }
 
-    /* Cache the context of the current thread, assuming that it
-     * will be accessed several times before a thread switch. */
-    tstate = PyThreadState_GET();
-    if (tstate) {
-        cached_context = (CTXT_Object*)tl_context;
-        cached_context->tstate = tstate;
-    }
+    current_context_cache((CTXT_Object*)tl_context);
 
     /* Borrowed reference with refcount==1 */
     return (CTXT_Object*)tl_context;
 }
 
+#endif
+
 /* Return borrowed reference to thread local context. */
 static CTXT_Object *
 GMPy_current_context(void)
 {
+#if defined(GMPY_TLS)
+    /* The context of each thread is kept in thread-local storage, so the
+     * lookup does not depend on how the threads are interleaved. */
     PyThreadState *tstate = PyThreadState_GET();
-    
+
+    if (tls_context && tls_tstate == tstate
+#  ifdef GMPY_CONTEXTVAR
+        && tls_context_ver == tstate->context_ver
+#  endif
+        ) {
+        return tls_context;
+    }
+#elif !defined(GMPY_CONTEXTVAR)
+    PyThreadState *tstate = PyThreadState_GET();
+
     if (cached_context && cached_context->tstate == tstate) {
         return (CTXT_Object*)cached_context;
     }
+#endif
 
+#ifdef GMPY_CONTEXTVAR
+    return current_context_from_var();
+#else
     return current_context_from_dict();
+#endif
 }
 
 /* Set the thread local context to a new context, decrement old reference */
 static PyObject *
 GMPy_CTXT_Set(PyObject *self, PyObject *other)
 {
+#ifdef GMPY_CONTEXTVAR
+    PyObject *token;
+#else
     PyObject *dict;
-    PyThreadState *tstate;
+#endif
 
     if (!CTXT_Check(other)) {
         VALUE_ERROR("set_context() requires a context argument");
         return NULL;
     }
 
+#ifdef GMPY_CONTEXTVAR
+    if (!(token = PyContextVar_Set(current_context_var, other))) {
+        return NULL;
+    }
+    Py_DECREF(token);
+#else
     dict = PyThreadState_GetDict();
     if (dict == NULL) {
         RUNTIME_ERROR("cannot get thread state");
@@ -215,16 +316,9 @@ GMPy_CTXT_Set(PyObject *self, PyObject *other)
     if (PyDict_SetItem(dict, tls_context_key, other) < 0) {
         return NULL;
     }
+#endif
 
-    /* Cache the context of the current thread, assuming that it
-     * will be accessed several times before a thread switch. */
-    cached_context = NULL;
-    tstate = PyThreadState_GET();
-    if (tstate) {
-        cached_context = (CTXT_Object*)other;
-        cached_context->tstate = tstate;
-    }
-
+    current_context_cache((CTXT_Object*)other);
     Py_RETURN_NONE;
 }
 #endif
@@ -615,15 +709,18 @@ GMPy_CTXT_Local(PyObject *self, PyObject *args, PyObject *kwargs)
         Py_INCREF((PyObject*)(result->new_context));
     }
     else {
-        result->new_context = context;
-        Py_INCREF((PyObject*)(result->new_context));
+        /* Modify a copy of the current context. The current context may
+         * also be the current context of other asyncio tasks or
+         * contextvars.Context objects. */
+        result->new_context = (CTXT_Object*)GMPy_CTXT_Copy((PyObject*)context, NULL);
+        if (!(result->new_context)) {
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
     }
 
-    result->old_context = (CTXT_Object*)GMPy_CTXT_Copy((PyObject*)context, NULL);
-    if (!(result->old_context)) {
-        Py_DECREF((PyObject*)result);
-        return NULL;
-    }
+    result->old_context = context;
+    Py_INCREF((PyObject*)(result->old_context));
 
     if (!_parse_context_args(result->new_context, kwargs)) {
         /* There was an error parsing the keyword arguments. */
@@ -820,7 +917,7 @@ GMPy_CTXT_Manager_Enter(PyObject *self, PyObject *args)
 }
 
 static PyObject *
-GMPy_CTXT_Manager_Exit(PyObject *self, PyObject *args)
+GMPy_CTXT_Manager_Exit(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     PyObject *temp;
 
@@ -851,7 +948,7 @@ GMPy_CTXT_Enter(PyObject *self, PyObject *args)
 }
 
 static PyObject *
-GMPy_CTXT_Exit(PyObject *self, PyObject *args)
+GMPy_CTXT_Exit(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     PyObject *temp;
 
@@ -1248,14 +1345,14 @@ static PyMethodDef GMPyContext_methods[] =
     { "abs", GMPy_Context_Abs, METH_O, GMPy_doc_context_abs },
     { "acos", GMPy_Context_Acos, METH_O, GMPy_doc_context_acos },
     { "acosh", GMPy_Context_Acosh, METH_O, GMPy_doc_context_acosh },
-    { "add", GMPy_Context_Add, METH_VARARGS, GMPy_doc_context_add },
-    { "agm", GMPy_Context_AGM, METH_VARARGS, GMPy_doc_context_agm },
+    { "add", (PyCFunction)GMPy_Context_Add, GMPY_METH_FASTCALL, GMPy_doc_context_add },
+    { "agm", (PyCFunction)GMPy_Context_AGM, GMPY_METH_FASTCALL, GMPy_doc_context_agm },
     { "ai", GMPy_Context_Ai, METH_O, GMPy_doc_context_ai },
     { "asin", GMPy_Context_Asin, METH_O, GMPy_doc_context_asin },
     { "asinh", GMPy_Context_Asinh, METH_O, GMPy_doc_context_asinh },
     { "atan", GMPy_Context_Atan, METH_O, GMPy_doc_context_atan },
     { "atanh", GMPy_Context_Atanh, METH_O, GMPy_doc_context_atanh },
-    { "atan2", GMPy_Context_Atan2, METH_VARARGS, GMPy_doc_context_atan2 },
+    { "atan2", (PyCFunction)GMPy_Context_Atan2, GMPY_METH_FASTCALL, GMPy_doc_context_atan2 },
     { "clear_flags", GMPy_CTXT_Clear_Flags, METH_NOARGS, GMPy_doc_context_clear_flags },
     { "cbrt", GMPy_Context_Cbrt, METH_O, GMPy_doc_context_cbrt },
     { "ceil", GMPy_Context_Ceil, METH_O, GMPy_doc_context_ceil },
@@ -1273,9 +1370,9 @@ static PyMethodDef GMPyContext_methods[] =
     { "csch", GMPy_Context_Csch, METH_O, GMPy_doc_context_csch },
     { "degrees", GMPy_Context_Degrees, METH_O, GMPy_doc_context_degrees },
     { "digamma", GMPy_Context_Digamma, METH_O, GMPy_doc_context_digamma },
-    { "div", GMPy_Context_TrueDiv, METH_VARARGS, GMPy_doc_context_truediv },
-    { "div_mod", GMPy_Context_DivMod, METH_VARARGS, GMPy_doc_context_divmod },
-    { "div_2exp", GMPy_Context_Div_2exp, METH_VARARGS, GMPy_doc_context_div_2exp },
+    { "div", (PyCFunction)GMPy_Context_TrueDiv, GMPY_METH_FASTCALL, GMPy_doc_context_truediv },
+    { "div_mod", (PyCFunction)GMPy_Context_DivMod, GMPY_METH_FASTCALL, GMPy_doc_context_divmod },
+    { "div_2exp", (PyCFunction)GMPy_Context_Div_2exp, GMPY_METH_FASTCALL, GMPy_doc_context_div_2exp },
     { "eint", GMPy_Context_Eint, METH_O, GMPy_doc_context_eint },
     { "erf", GMPy_Context_Erf, METH_O, GMPy_doc_context_erf },
     { "erfc", GMPy_Context_Erfc, METH_O, GMPy_doc_context_erfc },
@@ -1284,16 +1381,16 @@ static PyMethodDef GMPyContext_methods[] =
     { "exp10", GMPy_Context_Exp10, METH_O, GMPy_doc_context_exp10 },
     { "exp2", GMPy_Context_Exp2, METH_O, GMPy_doc_context_exp2 },
     { "floor", GMPy_Context_Floor, METH_O, GMPy_doc_context_floor },
-    { "floor_div", GMPy_Context_FloorDiv, METH_VARARGS, GMPy_doc_context_floordiv },
-    { "fma", GMPy_Context_FMA, METH_VARARGS, GMPy_doc_context_fma },
-    { "fmod", GMPy_Context_Fmod, METH_VARARGS, GMPy_doc_context_fmod },
-    { "fms", GMPy_Context_FMS, METH_VARARGS, GMPy_doc_context_fms },
+    { "floor_div", (PyCFunction)GMPy_Context_FloorDiv, GMPY_METH_FASTCALL, GMPy_doc_context_floordiv },
+    { "fma", (PyCFunction)GMPy_Context_FMA, GMPY_METH_FASTCALL, GMPy_doc_context_fma },
+    { "fmod", (PyCFunction)GMPy_Context_Fmod, GMPY_METH_FASTCALL, GMPy_doc_context_fmod },
+    { "fms", (PyCFunction)GMPy_Context_FMS, GMPY_METH_FASTCALL, GMPy_doc_context_fms },
     { "factorial", GMPy_Context_Factorial, METH_O, GMPy_doc_context_factorial },
     { "frac", GMPy_Context_Frac, METH_O, GMPy_doc_context_frac },
     { "frexp", GMPy_Context_Frexp, METH_O, GMPy_doc_context_frexp },
     { "fsum", GMPy_Context_Fsum, METH_O, GMPy_doc_context_fsum },
     { "gamma", GMPy_Context_Gamma, METH_O, GMPy_doc_context_gamma },
-    { "hypot", GMPy_Context_Hypot, METH_VARARGS, GMPy_doc_context_hypot },
+    { "hypot", (PyCFunction)GMPy_Context_Hypot, GMPY_METH_FASTCALL, GMPy_doc_context_hypot },
     { "is_finite", GMPy_Context_Is_Finite, METH_O, GMPy_doc_context_is_finite },
     { "is_infinite", GMPy_Context_Is_Infinite, METH_O, GMPy_doc_context_is_infinite },
     { "is_integere", GMPy_Context_Is_Integer, METH_O, GMPy_doc_context_is_integer },
@@ -1301,7 +1398,7 @@ static PyMethodDef GMPyContext_methods[] =
     { "is_regular", GMPy_Context_Is_Regular, METH_O, GMPy_doc_context_is_regular },
     { "is_signed", GMPy_Context_Is_Signed, METH_O, GMPy_doc_context_is_signed },
     { "is_zero", GMPy_Context_Is_Zero, METH_O, GMPy_doc_context_is_zero },
-    { "jn", GMPy_Context_Jn, METH_VARARGS, GMPy_doc_context_jn },
+    { "jn", (PyCFunction)GMPy_Context_Jn, GMPY_METH_FASTCALL, GMPy_doc_context_jn },
     { "j0", GMPy_Context_J0, METH_O, GMPy_doc_context_j0 },
     { "j1", GMPy_Context_J1, METH_O, GMPy_doc_context_j1 },
     { "li2", GMPy_Context_Li2, METH_O, GMPy_doc_context_li2 },
@@ -1311,37 +1408,37 @@ static PyMethodDef GMPyContext_methods[] =
     { "log10", GMPy_Context_Log10, METH_O, GMPy_doc_context_log10 },
     { "log1p", GMPy_Context_Log1p, METH_O, GMPy_doc_context_log1p },
     { "log2", GMPy_Context_Log2, METH_O, GMPy_doc_context_log2 },
-    { "maxnum", GMPy_Context_Maxnum, METH_VARARGS, GMPy_doc_context_maxnum },
-    { "mpc", (PyCFunction)GMPy_MPC_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpc_factory },
-    { "mpfr", (PyCFunction)GMPy_MPFR_Factory, METH_VARARGS | METH_KEYWORDS, GMPy_doc_mpfr_factory },
-    { "minnum", GMPy_Context_Minnum, METH_VARARGS, GMPy_doc_context_minnum },
-    { "minus", GMPy_Context_Minus, METH_VARARGS, GMPy_doc_context_minus },
-    { "mod", GMPy_Context_Mod, METH_VARARGS, GMPy_doc_context_mod },
+    { "maxnum", (PyCFunction)GMPy_Context_Maxnum, GMPY_METH_FASTCALL, GMPy_doc_context_maxnum },
+    { "mpc", (PyCFunction)GMPy_MPC_Factory, GMPY_METH_FASTCALL | METH_KEYWORDS, GMPy_doc_mpc_factory },
+    { "mpfr", (PyCFunction)GMPy_MPFR_Factory, GMPY_METH_FASTCALL | METH_KEYWORDS, GMPy_doc_mpfr_factory },
+    { "minnum", (PyCFunction)GMPy_Context_Minnum, GMPY_METH_FASTCALL, GMPy_doc_context_minnum },
+    { "minus", (PyCFunction)GMPy_Context_Minus, GMPY_METH_FASTCALL, GMPy_doc_context_minus },
+    { "mod", (PyCFunction)GMPy_Context_Mod, GMPY_METH_FASTCALL, GMPy_doc_context_mod },
     { "modf", GMPy_Context_Modf, METH_O, GMPy_doc_context_modf },
-    { "mul", GMPy_Context_Mul, METH_VARARGS, GMPy_doc_context_mul },
-    { "mul_2exp", GMPy_Context_Mul_2exp, METH_VARARGS, GMPy_doc_context_mul_2exp },
+    { "mul", (PyCFunction)GMPy_Context_Mul, GMPY_METH_FASTCALL, GMPy_doc_context_mul },
+    { "mul_2exp", (PyCFunction)GMPy_Context_Mul_2exp, GMPY_METH_FASTCALL, GMPy_doc_context_mul_2exp },
     { "next_above", GMPy_Context_NextAbove, METH_O, GMPy_doc_context_next_above },
     { "next_below", GMPy_Context_NextBelow, METH_O, GMPy_doc_context_next_below },
-    { "next_toward", GMPy_Context_NextToward, METH_VARARGS, GMPy_doc_context_next_toward },
+    { "next_toward", (PyCFunction)GMPy_Context_NextToward, GMPY_METH_FASTCALL, GMPy_doc_context_next_toward },
     { "norm", GMPy_Context_Norm, METH_O, GMPy_doc_context_norm },
     { "phase", GMPy_Context_Phase, METH_O, GMPy_doc_context_phase },
-    { "plus", GMPy_Context_Plus, METH_VARARGS, GMPy_doc_context_plus },
+    { "plus", (PyCFunction)GMPy_Context_Plus, GMPY_METH_FASTCALL, GMPy_doc_context_plus },
     { "polar", GMPy_Context_Polar, METH_O, GMPy_doc_context_polar },
     { "proj", GMPy_Context_Proj, METH_O, GMPy_doc_context_proj },
-    { "pow", GMPy_Context_Pow, METH_VARARGS, GMPy_doc_context_pow },
+    { "pow", (PyCFunction)GMPy_Context_Pow, GMPY_METH_FASTCALL, GMPy_doc_context_pow },
     { "radians", GMPy_Context_Radians, METH_O, GMPy_doc_context_radians },
-    { "rect", GMPy_Context_Rect, METH_VARARGS, GMPy_doc_context_rect },
+    { "rect", (PyCFunction)GMPy_Context_Rect, GMPY_METH_FASTCALL, GMPy_doc_context_rect },
     { "rec_sqrt", GMPy_Context_RecSqrt, METH_O, GMPy_doc_context_rec_sqrt },
-    { "reldiff", GMPy_Context_RelDiff, METH_VARARGS, GMPy_doc_context_reldiff },
-    { "remainder", GMPy_Context_Remainder, METH_VARARGS, GMPy_doc_context_remainder },
-    { "remquo", GMPy_Context_RemQuo, METH_VARARGS, GMPy_doc_context_remquo },
+    { "reldiff", (PyCFunction)GMPy_Context_RelDiff, GMPY_METH_FASTCALL, GMPy_doc_context_reldiff },
+    { "remainder", (PyCFunction)GMPy_Context_Remainder, GMPY_METH_FASTCALL, GMPy_doc_context_remainder },
+    { "remquo", (PyCFunction)GMPy_Context_RemQuo, GMPY_METH_FASTCALL, GMPy_doc_context_remquo },
     { "rint", GMPy_Context_Rint, METH_O, GMPy_doc_context_rint },
     { "rint_ceil", GMPy_Context_RintCeil, METH_O, GMPy_doc_context_rint_ceil },
     { "rint_floor", GMPy_Context_RintFloor, METH_O, GMPy_doc_context_rint_floor },
     { "rint_round", GMPy_Context_RintRound, METH_O, GMPy_doc_context_rint_round },
     { "rint_trunc", GMPy_Context_RintTrunc, METH_O, GMPy_doc_context_rint_trunc },
-    { "root", GMPy_Context_Root, METH_VARARGS, GMPy_doc_context_root },
-    { "round2", GMPy_Context_Round2, METH_VARARGS, GMPy_doc_context_round2 },
+    { "root", (PyCFunction)GMPy_Context_Root, GMPY_METH_FASTCALL, GMPy_doc_context_root },
+    { "round2", (PyCFunction)GMPy_Context_Round2, GMPY_METH_FASTCALL, GMPy_doc_context_round2 },
     { "round_away", GMPy_Context_RoundAway, METH_O, GMPy_doc_context_round_away },
     { "sec", GMPy_Context_Sec, METH_O, GMPy_doc_context_sec },
     { "sech", GMPy_Context_Sech, METH_O, GMPy_doc_context_sech },
@@ -1351,16 +1448,16 @@ static PyMethodDef GMPyContext_methods[] =
     { "sinh_cosh", GMPy_Context_Sinh_Cosh, METH_O, GMPy_doc_context_sinh_cosh },
     { "sqrt", GMPy_Context_Sqrt, METH_O, GMPy_doc_context_sqrt },
     { "square", GMPy_Context_Square, METH_O, GMPy_doc_context_square },
-    { "sub", GMPy_Context_Sub, METH_VARARGS, GMPy_doc_context_sub },
+    { "sub", (PyCFunction)GMPy_Context_Sub, GMPY_METH_FASTCALL, GMPy_doc_context_sub },
     { "tan", GMPy_Context_Tan, METH_O, GMPy_doc_context_tan },
     { "tanh", GMPy_Context_Tanh, METH_O, GMPy_doc_context_tanh },
     { "trunc", GMPy_Context_Trunc, METH_O, GMPy_doc_context_trunc },
-    { "yn", GMPy_Context_Yn, METH_VARARGS, GMPy_doc_context_yn },
+    { "yn", (PyCFunction)GMPy_Context_Yn, GMPY_METH_FASTCALL, GMPy_doc_context_yn },
     { "y0", GMPy_Context_Y0, METH_O, GMPy_doc_context_y0 },
     { "y1", GMPy_Context_Y1, METH_O, GMPy_doc_context_y1 },
     { "zeta", GMPy_Context_Zeta, METH_O, GMPy_doc_context_zeta },
     { "__enter__", GMPy_CTXT_Enter, METH_NOARGS, NULL },
-    { "__exit__", GMPy_CTXT_Exit, METH_VARARGS, NULL },
+    { "__exit__", (PyCFunction)GMPy_CTXT_Exit, GMPY_METH_FASTCALL, NULL },
     { NULL, NULL, 1 }
 };
 
@@ -1406,7 +1503,7 @@ static PyTypeObject CTXT_Type =
 static PyMethodDef GMPyContextManager_methods[] =
 {
     { "__enter__", GMPy_CTXT_Manager_Enter, METH_NOARGS, NULL },
-    { "__exit__", GMPy_CTXT_Manager_Exit, METH_VARARGS, NULL },
+    { "__exit__", (PyCFunction)GMPy_CTXT_Manager_Exit, GMPY_METH_FASTCALL, NULL },
     { NULL, NULL, 1 }
 };
 
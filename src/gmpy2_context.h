@@ -66,7 +66,14 @@ typedef struct {
     int mpfr_divmod_exact;   /* if 1, divmod(mpfr, mpfr) uses mpq */
 } gmpy_context;
 
-typedef struct {
+/* On Python 3.7 and later, the current context is stored in a
+ * contextvars.ContextVar instead of the thread state dictionary.
+ */
+#if !defined(WITHOUT_THREADS) && PY_VERSION_HEX >= 0x03070000
+#  define GMPY_CONTEXTVAR 1
+#endif
+
+typedef struct GMPy_CTXT_Object {
     PyObject_HEAD
     gmpy_context ctx;
 #ifndef WITHOUT_THREADS
@@ -113,7 +120,6 @@ static PyTypeObject CTXT_Manager_Type;
 
 #define SET_EXPONENT(context) ;
 
-#define CTXT_Check(v) (((PyObject*)v)->ob_type == &CTXT_Type)
 #define CTXT_Manager_Check(v) (((PyObject*)v)->ob_type == &CTXT_Manager_Type)
 
 #define GET_MPFR_PREC(c) (c->ctx.mpfr_prec)
@@ -135,7 +141,7 @@ static PyObject *    GMPy_CTXT_Manager_New(void);
 static void          GMPy_CTXT_Manager_Dealloc(CTXT_Manager_Object *self);
 static PyObject *    GMPy_CTXT_Manager_Repr_Slot(CTXT_Manager_Object *self);
 static PyObject *    GMPy_CTXT_Manager_Enter(PyObject *self, PyObject *args);
-static PyObject *    GMPy_CTXT_Manager_Exit(PyObject *self, PyObject *args);
+static PyObject *    GMPy_CTXT_Manager_Exit(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject *    GMPy_CTXT_New(void);
 static void          GMPy_CTXT_Dealloc(CTXT_Object *self);
@@ -148,7 +154,7 @@ static PyObject *    GMPy_CTXT_Clear_Flags(PyObject *self, PyObject *args);
 static PyObject *    GMPy_CTXT_Copy(PyObject *self, PyObject *other);
 static PyObject *    GMPy_CTXT_ieee(PyObject *self, PyObject *other);
 static PyObject *    GMPy_CTXT_Enter(PyObject *self, PyObject *args);
-static PyObject *    GMPy_CTXT_Exit(PyObject *self, PyObject *args);
+static PyObject *    GMPy_CTXT_Exit(PyObject *self, GMPY_FASTCALL_ARGS);
 
 #ifndef WITHOUT_THREADS
 static CTXT_Object * GMPy_current_context(void);
@@ -44,9 +44,27 @@ static MPZ_Object *
 GMPy_MPZ_From_PyIntOrLong(PyObject *obj, CTXT_Object *context)
 {
     MPZ_Object *result;
+    long value;
 
     assert(PyIntOrLong_Check(obj));
 
+    /* Return an interned value for a small integer. */
+#ifdef PY2
+    if (PyInt_Check(obj)) {
+        value = PyInt_AS_LONG(obj);
+        if (GMPY_IS_SMALL_MPZ(value))
+            return GMPy_MPZ_From_SI(value, context);
+    }
+#else
+    if (Py_SIZE(obj) == 0)
+        return GMPy_MPZ_From_SI(0, context);
+    if (Py_SIZE(obj) == 1 || Py_SIZE(obj) == -1) {
+        value = Py_SIZE(obj) * (long)((PyLongObject*)obj)->ob_digit[0];
+        if (GMPY_IS_SMALL_MPZ(value))
+            return GMPy_MPZ_From_SI(value, context);
+    }
+#endif
+
     if(!(result = GMPy_MPZ_New(context)))
         return NULL;
 
@@ -136,6 +136,55 @@ GMPy_Integer_AsLongAndError(PyObject *vv, int *error)
     return 0;
 }
 
+/* Cheap test used by the arithmetic fast paths. An mpz is checked first
+ * because that is the common case; a single limb is accepted only if it
+ * fits in a long without reaching LONG_MIN.
+ */
+
+static int
+GMPy_Integer_AsWord(PyObject *x, long *value)
+{
+    int error;
+
+    if (CHECK_MPZANY(x)) {
+        mpz_srcptr z = MPZ(x);
+
+        if (z->_mp_size == 0) {
+            *value = 0;
+            return 1;
+        }
+        if ((z->_mp_size == 1 || z->_mp_size == -1) &&
+            z->_mp_d[0] <= (mp_limb_t)LONG_MAX) {
+            *value = z->_mp_size > 0 ? (long)z->_mp_d[0] : -(long)z->_mp_d[0];
+            return 1;
+        }
+        return 0;
+    }
+
+    if (PyIntOrLong_Check(x)) {
+        *value = GMPy_Integer_AsLongAndError(x, &error);
+        return !error;
+    }
+
+    return 0;
+}
+
+static int
+GMPy_Word_FDivMod(long a, long b, long *q, long *r)
+{
+    if (b == 0 || (b == -1 && a == LONG_MIN))
+        return 0;
+
+    /* C division truncates; adjust toward negative infinity. */
+    *q = a / b;
+    *r = a % b;
+    if (*r != 0 && ((*r < 0) != (b < 0))) {
+        *q -= 1;
+        *r += b;
+    }
+    return 1;
+}
+
 static unsigned long
 GMPy_Integer_AsUnsignedLongAndError(PyObject *vv, int *error)
 {
@@ -41,6 +41,33 @@ static unsigned long         GMPy_Integer_AsUnsignedLongAndError(PyObject *vv, i
 static long                  c_long_From_Integer(PyObject *obj);
 static unsigned long         c_ulong_From_Integer(PyObject *obj);
 
+/* Word-sized fast paths. GMPy_Integer_AsWord() returns 1 and stores the
+ * value if x is an mpz, xmpz, or Python integer that fits in a C long, and
+ * returns 0 otherwise; it never raises. The GMPY_*_OVERFLOW macros store
+ * a op b in *r and evaluate to nonzero if the result would not fit.
+ * GMPy_Word_FDivMod() computes the floor quotient and remainder; it returns
+ * 0 (without raising) for division by zero or LONG_MIN // -1.
+ */
+
+static int                   GMPy_Integer_AsWord(PyObject *x, long *value);
+static int                   GMPy_Word_FDivMod(long a, long b, long *q, long *r);
+
+#if (defined(__GNUC__) && __GNUC__ >= 5) || defined(__clang__)
+# define GMPY_ADD_OVERFLOW(a, b, r) __builtin_add_overflow(a, b, r)
+# define GMPY_SUB_OVERFLOW(a, b, r) __builtin_sub_overflow(a, b, r)
+# define GMPY_MUL_OVERFLOW(a, b, r) __builtin_mul_overflow(a, b, r)
+#else
+# define GMPY_ADD_OVERFLOW(a, b, r) \
+    (((b) > 0 ? (a) > LONG_MAX - (b) : (a) < LONG_MIN - (b)) ? 1 : (*(r) = (a) + (b), 0))
+# define GMPY_SUB_OVERFLOW(a, b, r) \
+    (((b) < 0 ? (a) > LONG_MAX + (b) : (a) < LONG_MIN + (b)) ? 1 : (*(r) = (a) - (b), 0))
+/* Conservative: only products of two half-word operands are computed. */
+# define GMPY_HALF_LONG (1L << (sizeof(long) * 4 - 1))
+# define GMPY_MUL_OVERFLOW(a, b, r) \
+    (((a) >= GMPY_HALF_LONG || (a) <= -GMPY_HALF_LONG || \
+      (b) >= GMPY_HALF_LONG || (b) <= -GMPY_HALF_LONG) ? 1 : (*(r) = (a) * (b), 0))
+#endif
+
 #ifdef _WIN64
 static PY_LONG_LONG          GMPy_Integer_AsLongLongAndError(PyObject *vv, int *error);
 static unsigned PY_LONG_LONG GMPy_Integer_AsUnsignedLongLongAndError(PyObject *vv, int *error);
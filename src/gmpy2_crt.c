@@ -0,0 +1,401 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_crt.c                                                             *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* This file implements the Chinese Remainder Theorem. A CRTBasis
+ * precomputes the product tree of the moduli and the inverses needed to
+ * combine residues, so converting between an integer and its residues
+ * takes quasi-linear time in both directions.
+ */
+
+PyDoc_STRVAR(GMPy_doc_crtbasis_factory,
+"CRTBasis(moduli) -> CRTBasis\n\n"
+"Return a basis for the Chinese Remainder Theorem. moduli must be an\n"
+"iterable of positive, pairwise coprime integers. The product tree of\n"
+"the moduli and the inverses used by crt() are precomputed.");
+
+static CRTBasis_Object *
+GMPy_CRTBasis_New(PyObject *moduli, const char *name)
+{
+    CRTBasis_Object *result;
+    GMPy_ProdTree *tree;
+    mpz_t **work;
+    Py_ssize_t i, n, bad = -1;
+
+    if (!(result = PyObject_New(CRTBasis_Object, &CRTBasis_Type)))
+        return NULL;
+
+    result->inverse = NULL;
+    tree = &result->tree;
+    if (GMPy_ProdTree_FromIterable(tree, moduli, name) < 0)
+        goto err;
+
+    if (tree->depth == 0) {
+        PyErr_Format(PyExc_ValueError, "%s requires at least one modulus", name);
+        goto err;
+    }
+
+    n = tree->count[0];
+    for (i = 0; i < n; i++) {
+        if (mpz_sgn(tree->level[0][i]) <= 0) {
+            PyErr_Format(PyExc_ValueError, "%s moduli must be positive", name);
+            goto err;
+        }
+    }
+
+    if (!(result->inverse = GMPY_MALLOC(n * sizeof(mpz_t)))) {
+        PyErr_NoMemory();
+        goto err;
+    }
+    for (i = 0; i < n; i++)
+        mpz_init(result->inverse[i]);
+
+    if (!(work = GMPy_ProdTree_NewWork(tree)))
+        goto err;
+
+    /* If M mod m[i]**2 = r then r/m[i] = (M/m[i]) mod m[i]. */
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(GMPy_ProdTree_Size(tree));
+    GMPy_ProdTree_Build(tree);
+    GMPy_ProdTree_Remainders(tree, tree->level[tree->depth - 1][0], 1,
+                             result->inverse, work);
+    for (i = 0; i < n; i++) {
+        mpz_divexact(result->inverse[i], result->inverse[i], tree->level[0][i]);
+        if (!mpz_invert(result->inverse[i], result->inverse[i], tree->level[0][i])) {
+            bad = i;
+            break;
+        }
+    }
+    GMPY_MAYBE_END_ALLOW_THREADS;
+
+    GMPy_ProdTree_ClearWork(tree, work);
+
+    if (bad >= 0) {
+        PyErr_Format(PyExc_ValueError, "%s moduli must be pairwise coprime", name);
+        goto err;
+    }
+    return result;
+
+  err:
+    Py_DECREF((PyObject*)result);
+    return NULL;
+}
+
+static PyObject *
+GMPy_CRTBasis_Factory(PyObject *self, PyObject *other)
+{
+    return (PyObject*)GMPy_CRTBasis_New(other, "CRTBasis()");
+}
+
+static void
+GMPy_CRTBasis_Dealloc(CRTBasis_Object *self)
+{
+    Py_ssize_t i;
+
+    if (self->inverse) {
+        for (i = 0; i < self->tree.count[0]; i++)
+            mpz_clear(self->inverse[i]);
+        GMPY_FREE(self->inverse);
+    }
+    GMPy_ProdTree_Clear(&self->tree);
+    PyObject_Del(self);
+}
+
+/* Return the unique integer x with 0 <= x < M and x = residues[i] mod m[i].
+ * Each leaf is set to residues[i] * inverse[i] mod m[i]; then each node is
+ * the sum of its children, each multiplied by the product of the moduli
+ * of the other child.
+ */
+
+static PyObject *
+GMPy_CRTBasis_Combine(CRTBasis_Object *self, PyObject *residues, const char *name)
+{
+    GMPy_ProdTree *tree = &self->tree;
+    MPZ_Vector_Object *vr;
+    MPZ_Object *result = NULL;
+    mpz_t **work = NULL, view;
+    Py_ssize_t i;
+    int k;
+
+    if (!(vr = GMPy_MPZ_Vector_From_Iterable(residues, name)))
+        return NULL;
+
+    if (vr->length != tree->count[0]) {
+        PyErr_Format(PyExc_ValueError,
+                     "%s requires the same number of residues and moduli", name);
+        goto err;
+    }
+
+    if (!(work = GMPy_ProdTree_NewWork(tree)) || !(result = GMPy_MPZ_New(NULL)))
+        goto err;
+
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(GMPy_ProdTree_Size(tree));
+    for (i = 0; i < tree->count[0]; i++) {
+        MPZ_VECTOR_VIEW(view, vr, i);
+        mpz_mul(work[0][i], view, self->inverse[i]);
+        mpz_fdiv_r(work[0][i], work[0][i], tree->level[0][i]);
+    }
+    for (k = 1; k < tree->depth; k++) {
+        for (i = 0; i < tree->count[k]; i++) {
+            if (2 * i + 1 < tree->count[k - 1]) {
+                mpz_mul(work[k][i], work[k - 1][2 * i], tree->level[k - 1][2 * i + 1]);
+                mpz_addmul(work[k][i], work[k - 1][2 * i + 1], tree->level[k - 1][2 * i]);
+            }
+            else {
+                mpz_swap(work[k][i], work[k - 1][2 * i]);
+            }
+        }
+    }
+    mpz_tdiv_r(result->z, work[tree->depth - 1][0], tree->level[tree->depth - 1][0]);
+    GMPY_MAYBE_END_ALLOW_THREADS;
+
+  err:
+    if (work)
+        GMPy_ProdTree_ClearWork(tree, work);
+    Py_DECREF((PyObject*)vr);
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_crtbasis_method_crt,
+"b.crt(residues) -> mpz\n\n"
+"Return the unique integer x with 0 <= x < b.modulus such that\n"
+"x % b.moduli[i] == residues[i] % b.moduli[i] for every i.");
+
+static PyObject *
+GMPy_CRTBasis_Method_CRT(PyObject *self, PyObject *other)
+{
+    return GMPy_CRTBasis_Combine((CRTBasis_Object*)self, other, "crt()");
+}
+
+PyDoc_STRVAR(GMPy_doc_crtbasis_method_to_residues,
+"b.to_residues(x) -> list\n\n"
+"Return a list containing x % m for each modulus m. A remainder tree\n"
+"is used so the running time is quasi-linear.");
+
+static PyObject *
+GMPy_CRTBasis_Method_ToResidues(PyObject *self, PyObject *other)
+{
+    CRTBasis_Object *basis = (CRTBasis_Object*)self;
+    GMPy_ProdTree *tree = &basis->tree;
+    MPZ_Object *tempx;
+    PyObject *result = NULL;
+    mpz_t **work, *rem;
+    Py_ssize_t i, n = tree->count[0];
+
+    if (!IS_INTEGER(other)) {
+        TYPE_ERROR("to_residues() requires 'int' argument");
+        return NULL;
+    }
+
+    if (!(tempx = GMPy_MPZ_From_Integer(other, NULL)))
+        return NULL;
+
+    if (!(work = GMPy_ProdTree_NewWork(tree))) {
+        Py_DECREF((PyObject*)tempx);
+        return NULL;
+    }
+
+    /* The leaf level of work is not used by GMPy_ProdTree_Remainders() so
+     * it holds the remainders.
+     */
+    rem = work[0];
+
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(GMPy_ProdTree_Size(tree) + mpz_size(tempx->z));
+    GMPy_ProdTree_Remainders(tree, tempx->z, 0, rem, work);
+    for (i = 0; i < n; i++) {
+        if (mpz_sgn(rem[i]) < 0)
+            mpz_add(rem[i], rem[i], tree->level[0][i]);
+    }
+    GMPY_MAYBE_END_ALLOW_THREADS;
+
+    result = GMPy_MPZ_List_FromArray(rem, n);
+    GMPy_ProdTree_ClearWork(tree, work);
+    Py_DECREF((PyObject*)tempx);
+    return result;
+}
+
+static PyObject *
+GMPy_CRTBasis_GetModuli_Attrib(CRTBasis_Object *self, void *closure)
+{
+    PyObject *result;
+    MPZ_Object *temp;
+    Py_ssize_t i;
+
+    if (!(result = PyList_New(self->tree.count[0])))
+        return NULL;
+
+    for (i = 0; i < self->tree.count[0]; i++) {
+        if (!(temp = GMPy_MPZ_New(NULL))) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        mpz_set(temp->z, self->tree.level[0][i]);
+        PyList_SET_ITEM(result, i, (PyObject*)temp);
+    }
+    return result;
+}
+
+static PyObject *
+GMPy_CRTBasis_GetModulus_Attrib(CRTBasis_Object *self, void *closure)
+{
+    MPZ_Object *result;
+
+    if ((result = GMPy_MPZ_New(NULL)))
+        mpz_set(result->z, self->tree.level[self->tree.depth - 1][0]);
+    return (PyObject*)result;
+}
+
+static Py_ssize_t
+GMPy_CRTBasis_Length_Slot(CRTBasis_Object *self)
+{
+    return self->tree.count[0];
+}
+
+static PyObject *
+GMPy_CRTBasis_Repr_Slot(CRTBasis_Object *self)
+{
+    PyObject *list = NULL, *sep = NULL, *body = NULL, *result = NULL;
+    PyObject *item;
+    Py_ssize_t i;
+
+    if (!(list = GMPy_CRTBasis_GetModuli_Attrib(self, NULL)))
+        return NULL;
+
+    for (i = 0; i < self->tree.count[0]; i++) {
+        if (!(item = PyObject_Str(PyList_GET_ITEM(list, i))))
+            goto done;
+        PyList_SetItem(list, i, item);
+    }
+
+    if (!(sep = Py2or3String_FromString(", ")))
+        goto done;
+    if (!(body = PyObject_CallMethod(sep, "join", "O", list)))
+        goto done;
+
+#ifdef PY3
+    result = PyUnicode_FromFormat("CRTBasis([%U])", body);
+#else
+    result = PyString_FromFormat("CRTBasis([%s])", PyString_AS_STRING(body));
+#endif
+
+  done:
+    Py_XDECREF(list);
+    Py_XDECREF(sep);
+    Py_XDECREF(body);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_crtbasis_modulus, "product of the moduli");
+PyDoc_STRVAR(GMPy_doc_crtbasis_moduli, "list of the moduli");
+
+static PyGetSetDef GMPy_CRTBasis_getseters[] =
+{
+    { "modulus", (getter)GMPy_CRTBasis_GetModulus_Attrib, NULL,
+      GMPy_doc_crtbasis_modulus, NULL },
+    { "moduli", (getter)GMPy_CRTBasis_GetModuli_Attrib, NULL,
+      GMPy_doc_crtbasis_moduli, NULL },
+    { NULL }
+};
+
+static PyMethodDef GMPy_CRTBasis_methods[] =
+{
+    { "crt", GMPy_CRTBasis_Method_CRT, METH_O, GMPy_doc_crtbasis_method_crt },
+    { "to_residues", GMPy_CRTBasis_Method_ToResidues, METH_O, GMPy_doc_crtbasis_method_to_residues },
+    { NULL }
+};
+
+static PySequenceMethods GMPy_CRTBasis_sequence_methods =
+{
+    (lenfunc) GMPy_CRTBasis_Length_Slot,    /* sq_length        */
+        0,                                  /* sq_concat        */
+        0,                                  /* sq_repeat        */
+        0,                                  /* sq_item          */
+};
+
+static PyTypeObject CRTBasis_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                  /* ob_size          */
+#endif
+    "CRTBasis",                             /* tp_name          */
+    sizeof(CRTBasis_Object),                /* tp_basicsize     */
+        0,                                  /* tp_itemsize      */
+    (destructor) GMPy_CRTBasis_Dealloc,     /* tp_dealloc       */
+        0,                                  /* tp_print         */
+        0,                                  /* tp_getattr       */
+        0,                                  /* tp_setattr       */
+        0,                                  /* tp_reserved      */
+    (reprfunc) GMPy_CRTBasis_Repr_Slot,     /* tp_repr          */
+        0,                                  /* tp_as_number     */
+    &GMPy_CRTBasis_sequence_methods,        /* tp_as_sequence   */
+        0,                                  /* tp_as_mapping    */
+        0,                                  /* tp_hash          */
+        0,                                  /* tp_call          */
+        0,                                  /* tp_str           */
+        0,                                  /* tp_getattro      */
+        0,                                  /* tp_setattro      */
+        0,                                  /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                     /* tp_flags         */
+    "Basis for the Chinese Remainder Theorem", /* tp_doc        */
+        0,                                  /* tp_traverse      */
+        0,                                  /* tp_clear         */
+        0,                                  /* tp_richcompare   */
+        0,                                  /* tp_weaklistoffset*/
+        0,                                  /* tp_iter          */
+        0,                                  /* tp_iternext      */
+    GMPy_CRTBasis_methods,                  /* tp_methods       */
+        0,                                  /* tp_members       */
+    GMPy_CRTBasis_getseters,                /* tp_getset        */
+};
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_crt,
+"crt(residues, moduli) -> mpz\n\n"
+"Return the unique integer x with 0 <= x < prod(moduli) such that\n"
+"x % moduli[i] == residues[i] % moduli[i] for every i. The moduli must\n"
+"be positive and pairwise coprime. Use CRTBasis(moduli) when the same\n"
+"moduli are used repeatedly.");
+
+static PyObject *
+GMPy_MPZ_Function_CRT(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    CRTBasis_Object *basis;
+    PyObject *result;
+
+    if (GMPY_NARGS != 2) {
+        TYPE_ERROR("crt() requires 2 arguments");
+        return NULL;
+    }
+
+    if (!(basis = GMPy_CRTBasis_New(GMPY_ARG(1), "crt()")))
+        return NULL;
+
+    result = GMPy_CRTBasis_Combine(basis, GMPY_ARG(0), "crt()");
+    Py_DECREF((PyObject*)basis);
+    return result;
+}
@@ -0,0 +1,59 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_crt.h                                                             *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef GMPY_CRT_H
+#define GMPY_CRT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A CRTBasis stores the product tree of a list of pairwise coprime
+ * moduli m[i] and, for each modulus, inverse[i] = (M/m[i])**-1 mod m[i]
+ * where M is the product of all the moduli.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    GMPy_ProdTree tree;     /* product tree of the moduli */
+    mpz_t *inverse;         /* inverse[i] = (M/m[i])**-1 mod m[i] */
+} CRTBasis_Object;
+
+static PyTypeObject CRTBasis_Type;
+#define CRTBasis_Check(v) (((PyObject*)v)->ob_type == &CRTBasis_Type)
+
+static CRTBasis_Object * GMPy_CRTBasis_New(PyObject *moduli, const char *name);
+static PyObject *        GMPy_CRTBasis_Factory(PyObject *self, PyObject *other);
+static PyObject *        GMPy_CRTBasis_Combine(CRTBasis_Object *self, PyObject *residues,
+                                               const char *name);
+static PyObject *        GMPy_MPZ_Function_CRT(PyObject *self, GMPY_FASTCALL_ARGS);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -56,9 +56,25 @@ GMPy_Integer_DivMod(PyObject *x, PyObject *y, CTXT_Object *context)
     PyObject *result;
     MPZ_Object *tempx, *tempy, *rem, *quo;
     mpz_t tempz;
-    long temp;
+    long temp, a, b, q, r;
     int error;
 
+    if (GMPy_Integer_AsWord(x, &a) && GMPy_Integer_AsWord(y, &b) &&
+        GMPy_Word_FDivMod(a, b, &q, &r)) {
+        result = PyTuple_New(2);
+        quo = GMPy_MPZ_From_SI(q, context);
+        rem = GMPy_MPZ_From_SI(r, context);
+        if (!result || !quo || !rem) {
+            Py_XDECREF((PyObject*)quo);
+            Py_XDECREF((PyObject*)rem);
+            Py_XDECREF(result);
+            return NULL;
+        }
+        PyTuple_SET_ITEM(result, 0, (PyObject*)quo);
+        PyTuple_SET_ITEM(result, 1, (PyObject*)rem);
+        return result;
+    }
+
     result = PyTuple_New(2);
     rem = GMPy_MPZ_New(context);
     quo = GMPy_MPZ_New(context);
@@ -105,7 +121,9 @@ GMPy_Integer_DivMod(PyObject *x, PyObject *y, CTXT_Object *context)
                 Py_DECREF(result);
                 return NULL;
             }
+            GMPY_MAYBE_BEGIN_ALLOW_THREADS(GMPY_GIL_SIZE(x, y));
             mpz_fdiv_qr(quo->z, rem->z, MPZ(x), MPZ(y));
+            GMPY_MAYBE_END_ALLOW_THREADS;
             PyTuple_SET_ITEM(result, 0, (PyObject*)quo);
             PyTuple_SET_ITEM(result, 1, (PyObject*)rem);
             return result;
@@ -150,7 +168,9 @@ GMPy_Integer_DivMod(PyObject *x, PyObject *y, CTXT_Object *context)
             Py_DECREF(result);
             return NULL;
         }
+        GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z) + mpz_size(tempy->z));
         mpz_fdiv_qr(quo->z, rem->z, tempx->z, tempy->z);
+        GMPY_MAYBE_END_ALLOW_THREADS;
         Py_DECREF((PyObject*)tempx);
         Py_DECREF((PyObject*)tempy);
         PyTuple_SET_ITEM(result, 0, (PyObject*)quo);
@@ -576,11 +596,11 @@ PyDoc_STRVAR(GMPy_doc_context_divmod,
 "mpfr arguments to context.div_mod().");
 
 static PyObject *
-GMPy_Context_DivMod(PyObject *self, PyObject *args)
+GMPy_Context_DivMod(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("divmod() requires 2 arguments.");
         return NULL;
     }
@@ -592,7 +612,7 @@ GMPy_Context_DivMod(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_DivMod(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1),
+    return GMPy_Number_DivMod(GMPY_ARG(0), GMPY_ARG(1),
                               context);
 }
 
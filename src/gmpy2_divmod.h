@@ -50,7 +50,7 @@ static PyObject * GMPy_MPQ_DivMod_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPFR_DivMod_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPC_DivMod_Slot(PyObject *x, PyObject *y);
 
-static PyObject * GMPy_Context_DivMod(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_DivMod(PyObject *self, GMPY_FASTCALL_ARGS);
 
 #ifdef __cplusplus
 }
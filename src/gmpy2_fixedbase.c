@@ -0,0 +1,509 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_fixedbase.c                                                       *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* This file implements the FixedBasePow type. It precomputes a table of
+ * powers of a fixed base g so that g**e mod m can be evaluated for many
+ * different exponents e without any squarings. See gmpy2_fixedbase.h for
+ * a description of the table.
+ */
+
+/* The largest window that will be used. The evaluation needs a scratch
+ * array with 2**window entries.
+ */
+
+#define GMPY_FIXEDBASE_MAX_WINDOW 16
+
+PyDoc_STRVAR(GMPy_doc_fixedbasepow_factory,
+"FixedBasePow(g, m, max_exp_bits) -> FixedBasePow\n\n"
+"Return an object that computes powmod(g, e, m) for many exponents e.\n"
+"A table of powers of g is precomputed so exponents with up to\n"
+"max_exp_bits bits need far fewer multiplications than powmod().\n"
+"Larger exponents are supported but do not use the table. m must be\n"
+"positive.");
+
+/* Return the window that minimizes the number of multiplications,
+ * ceil(bits/window) + 2**window, for exponents with bits bits.
+ */
+
+static int
+GMPy_FixedBasePow_Window(mp_bitcnt_t bits)
+{
+    mp_bitcnt_t cost, best_cost = 0;
+    int w, best = 1;
+
+    for (w = 1; w <= GMPY_FIXEDBASE_MAX_WINDOW; w++) {
+        cost = (bits + w - 1) / w + ((mp_bitcnt_t)1 << w);
+        if (w == 1 || cost < best_cost) {
+            best = w;
+            best_cost = cost;
+        }
+    }
+    return best;
+}
+
+static PyObject *
+GMPy_FixedBasePow_Factory(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    FixedBasePow_Object *result;
+    MPZ_Object *tempg = NULL, *tempm = NULL;
+    mp_bitcnt_t bits;
+    Py_ssize_t j;
+    int k;
+
+    if (GMPY_NARGS != 3 || !IS_INTEGER(GMPY_ARG(0)) || !IS_INTEGER(GMPY_ARG(1)) ||
+        !IS_INTEGER(GMPY_ARG(2))) {
+        TYPE_ERROR("FixedBasePow() requires 'int','int','int' arguments");
+        return NULL;
+    }
+
+    bits = mp_bitcnt_t_From_Integer(GMPY_ARG(2));
+    if (bits == (mp_bitcnt_t)(-1) && PyErr_Occurred())
+        return NULL;
+
+    if (bits == 0) {
+        VALUE_ERROR("FixedBasePow() max_exp_bits must be positive");
+        return NULL;
+    }
+
+    if (!(tempg = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL)) ||
+        !(tempm = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL))) {
+        Py_XDECREF((PyObject*)tempg);
+        return NULL;
+    }
+
+    if (mpz_sgn(tempm->z) <= 0) {
+        VALUE_ERROR("FixedBasePow() modulus must be positive");
+        Py_DECREF((PyObject*)tempg);
+        Py_DECREF((PyObject*)tempm);
+        return NULL;
+    }
+
+    if (!(result = PyObject_New(FixedBasePow_Object, &FixedBasePow_Type))) {
+        Py_DECREF((PyObject*)tempg);
+        Py_DECREF((PyObject*)tempm);
+        return NULL;
+    }
+
+    mpz_init_set(result->m, tempm->z);
+    mpz_init(result->g);
+    mpz_fdiv_r(result->g, tempg->z, result->m);
+    Py_DECREF((PyObject*)tempg);
+    Py_DECREF((PyObject*)tempm);
+
+    result->bits = bits;
+    result->window = GMPy_FixedBasePow_Window(bits);
+    result->count = (Py_ssize_t)((bits + result->window - 1) / result->window);
+
+    if (!(result->table = GMPY_MALLOC(result->count * sizeof(mpz_t)))) {
+        result->count = 0;
+        Py_DECREF((PyObject*)result);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    for (j = 0; j < result->count; j++)
+        mpz_init(result->table[j]);
+
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(result->m) * (bits / GMP_NUMB_BITS + 1));
+    mpz_set(result->table[0], result->g);
+    for (j = 1; j < result->count; j++) {
+        mpz_mul(result->table[j], result->table[j - 1], result->table[j - 1]);
+        mpz_tdiv_r(result->table[j], result->table[j], result->m);
+        for (k = 1; k < result->window; k++) {
+            mpz_mul(result->table[j], result->table[j], result->table[j]);
+            mpz_tdiv_r(result->table[j], result->table[j], result->m);
+        }
+    }
+    GMPY_MAYBE_END_ALLOW_THREADS;
+
+    return (PyObject*)result;
+}
+
+static void
+GMPy_FixedBasePow_Dealloc(FixedBasePow_Object *self)
+{
+    Py_ssize_t j;
+
+    for (j = 0; j < self->count; j++)
+        mpz_clear(self->table[j]);
+    GMPY_FREE(self->table);
+    mpz_clear(self->g);
+    mpz_clear(self->m);
+    PyObject_Del(self);
+}
+
+/* Return window bits of |e| starting at bit start. */
+
+static unsigned long
+GMPy_FixedBasePow_Digit(mpz_srcptr e, mp_bitcnt_t start, int window)
+{
+    mp_size_t n = (mp_size_t)(start / GMP_NUMB_BITS);
+    int shift = (int)(start % GMP_NUMB_BITS);
+    mp_limb_t digit;
+
+    digit = mpz_getlimbn(e, n) >> shift;
+    if (shift + window > GMP_NUMB_BITS)
+        digit |= mpz_getlimbn(e, n + 1) << (GMP_NUMB_BITS - shift);
+    return (unsigned long)(digit & (((mp_limb_t)1 << window) - 1));
+}
+
+/* Store g**|e| mod m in r. If the exponent is larger than the table, the
+ * result is computed with mpz_powm(). Otherwise the digits of e are
+ * grouped by value using the head and next arrays (2**window and count
+ * entries), and the BGMW method is used: b accumulates the product of the
+ * table entries whose digit is at least d, and a accumulates the product
+ * of the successive values of b. The Python API is not used so this can
+ * be called without holding the GIL.
+ */
+
+static void
+GMPy_FixedBasePow_Eval(FixedBasePow_Object *self, mpz_ptr r, mpz_srcptr e,
+                       Py_ssize_t *head, Py_ssize_t *next, mpz_ptr a, mpz_ptr b)
+{
+    mp_bitcnt_t nbits = mpz_sgn(e) ? mpz_sizeinbase(e, 2) : 0;
+    Py_ssize_t j, n;
+    unsigned long d, maxd = 0;
+    int a_one = 1, b_one = 1;
+
+    if (nbits > (mp_bitcnt_t)self->window * self->count) {
+        mpz_abs(a, e);
+        mpz_powm(r, self->g, a, self->m);
+        return;
+    }
+
+    n = (Py_ssize_t)((nbits + self->window - 1) / self->window);
+    for (d = 0; d < (1UL << self->window); d++)
+        head[d] = -1;
+    for (j = n - 1; j >= 0; j--) {
+        d = GMPy_FixedBasePow_Digit(e, (mp_bitcnt_t)j * self->window, self->window);
+        if (d) {
+            next[j] = head[d];
+            head[d] = j;
+            if (d > maxd)
+                maxd = d;
+        }
+    }
+
+    for (d = maxd; d > 0; d--) {
+        for (j = head[d]; j >= 0; j = next[j]) {
+            if (b_one) {
+                mpz_set(b, self->table[j]);
+                b_one = 0;
+            }
+            else {
+                mpz_mul(b, b, self->table[j]);
+                mpz_tdiv_r(b, b, self->m);
+            }
+        }
+        if (!b_one) {
+            if (a_one) {
+                mpz_set(a, b);
+                a_one = 0;
+            }
+            else {
+                mpz_mul(a, a, b);
+                mpz_tdiv_r(a, a, self->m);
+            }
+        }
+    }
+
+    if (a_one)
+        mpz_set_ui(a, 1);
+    mpz_tdiv_r(r, a, self->m);
+}
+
+/* Allocate the scratch arrays used by GMPy_FixedBasePow_Eval(). */
+
+static int
+GMPy_FixedBasePow_Scratch(FixedBasePow_Object *self, Py_ssize_t **head, Py_ssize_t **next)
+{
+    *head = GMPY_MALLOC(((size_t)1 << self->window) * sizeof(Py_ssize_t));
+    *next = GMPY_MALLOC((self->count ? self->count : 1) * sizeof(Py_ssize_t));
+    if (!*head || !*next) {
+        GMPY_FREE(*head);
+        GMPY_FREE(*next);
+        PyErr_NoMemory();
+        return -1;
+    }
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_fixedbasepow_method_pow,
+"f.pow(e) -> mpz\n\n"
+"Return powmod(g, e, m). If e is negative, g must be invertible.");
+
+static PyObject *
+GMPy_FixedBasePow_Method_Pow(PyObject *self, PyObject *other)
+{
+    FixedBasePow_Object *fb = (FixedBasePow_Object*)self;
+    MPZ_Object *result = NULL, *tempe;
+    Py_ssize_t *head, *next;
+    mpz_t a, b;
+    int ok = 1;
+
+    if (!IS_INTEGER(other)) {
+        TYPE_ERROR("pow() requires 'int' argument");
+        return NULL;
+    }
+
+    if (!(tempe = GMPy_MPZ_From_Integer(other, NULL)))
+        return NULL;
+
+    if (GMPy_FixedBasePow_Scratch(fb, &head, &next) < 0) {
+        Py_DECREF((PyObject*)tempe);
+        return NULL;
+    }
+
+    if (!(result = GMPy_MPZ_New(NULL)))
+        goto err;
+
+    mpz_inoc(a);
+    mpz_inoc(b);
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempe->z) * mpz_size(fb->m));
+    GMPy_FixedBasePow_Eval(fb, result->z, tempe->z, head, next, a, b);
+    if (mpz_sgn(tempe->z) < 0)
+        ok = mpz_invert(result->z, result->z, fb->m);
+    GMPY_MAYBE_END_ALLOW_THREADS;
+    mpz_cloc(a);
+    mpz_cloc(b);
+
+    if (!ok) {
+        VALUE_ERROR("pow() base not invertible");
+        Py_CLEAR(result);
+    }
+
+  err:
+    GMPY_FREE(head);
+    GMPY_FREE(next);
+    Py_DECREF((PyObject*)tempe);
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_fixedbasepow_method_batch_pow,
+"f.batch_pow(e) -> mpz_vector or list\n\n"
+"Return powmod(g, e[i], m) for each element of e. Returns an\n"
+"mpz_vector if e is an mpz_vector and a list otherwise.");
+
+static PyObject *
+GMPy_FixedBasePow_Method_BatchPow(PyObject *self, PyObject *other)
+{
+    FixedBasePow_Object *fb = (FixedBasePow_Object*)self;
+    MPZ_Vector_Object *ve, *result = NULL;
+    PyObject *list;
+    Py_ssize_t *head, *next;
+    Py_ssize_t i, n, bad = -1;
+    mpz_t view, r, a, b;
+
+    if (!(ve = GMPy_MPZ_Vector_From_Iterable(other, "batch_pow()")))
+        return NULL;
+    n = ve->length;
+
+    if (GMPy_FixedBasePow_Scratch(fb, &head, &next) < 0) {
+        Py_DECREF((PyObject*)ve);
+        return NULL;
+    }
+
+    /* Every result is less than m so the vector never needs to grow and
+     * GMPy_MPZ_Vector_Append() cannot fail.
+     */
+    if (!(result = GMPy_MPZ_Vector_New(n, n * mpz_size(fb->m))))
+        goto err;
+
+    mpz_inoc(r);
+    mpz_inoc(a);
+    mpz_inoc(b);
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(ve->limbs_used * mpz_size(fb->m));
+    for (i = 0; i < n; i++) {
+        MPZ_VECTOR_VIEW(view, ve, i);
+        GMPy_FixedBasePow_Eval(fb, r, view, head, next, a, b);
+        if (mpz_sgn(view) < 0 && !mpz_invert(r, r, fb->m)) {
+            bad = i;
+            break;
+        }
+        GMPy_MPZ_Vector_Append(result, r);
+    }
+    GMPY_MAYBE_END_ALLOW_THREADS;
+    mpz_cloc(r);
+    mpz_cloc(a);
+    mpz_cloc(b);
+
+    if (bad >= 0) {
+        PyErr_Format(PyExc_ValueError,
+                     "batch_pow() base not invertible for element %zd", bad);
+        Py_CLEAR(result);
+    }
+
+  err:
+    GMPY_FREE(head);
+    GMPY_FREE(next);
+    Py_DECREF((PyObject*)ve);
+
+    if (!result || MPZ_Vector_Check(other))
+        return (PyObject*)result;
+
+    list = GMPy_MPZ_Vector_To_List(result);
+    Py_DECREF((PyObject*)result);
+    return list;
+}
+
+PyDoc_STRVAR(GMPy_doc_fixedbasepow_method_sizeof,
+"f.__sizeof__() -> int\n\n"
+"Returns the amount of memory consumed by f, including the table.");
+
+static PyObject *
+GMPy_FixedBasePow_Method_SizeOf(PyObject *self, PyObject *other)
+{
+    FixedBasePow_Object *fb = (FixedBasePow_Object*)self;
+    size_t size;
+    Py_ssize_t j;
+
+    size = sizeof(FixedBasePow_Object) + fb->count * sizeof(mpz_t) +
+           (fb->g->_mp_alloc + fb->m->_mp_alloc) * sizeof(mp_limb_t);
+    for (j = 0; j < fb->count; j++)
+        size += fb->table[j]->_mp_alloc * sizeof(mp_limb_t);
+    return PyIntOrLong_FromSize_t(size);
+}
+
+static PyObject *
+GMPy_FixedBasePow_GetBase_Attrib(FixedBasePow_Object *self, void *closure)
+{
+    MPZ_Object *result;
+
+    if ((result = GMPy_MPZ_New(NULL)))
+        mpz_set(result->z, self->g);
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_FixedBasePow_GetModulus_Attrib(FixedBasePow_Object *self, void *closure)
+{
+    MPZ_Object *result;
+
+    if ((result = GMPy_MPZ_New(NULL)))
+        mpz_set(result->z, self->m);
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_FixedBasePow_GetMaxExpBits_Attrib(FixedBasePow_Object *self, void *closure)
+{
+    return PyIntOrLong_FromSize_t((size_t)self->bits);
+}
+
+static PyObject *
+GMPy_FixedBasePow_GetWindow_Attrib(FixedBasePow_Object *self, void *closure)
+{
+    return PyIntOrLong_FromLong(self->window);
+}
+
+static PyObject *
+GMPy_FixedBasePow_Repr_Slot(FixedBasePow_Object *self)
+{
+    PyObject *g = NULL, *m = NULL, *result = NULL;
+
+    if (!(g = GMPy_FixedBasePow_GetBase_Attrib(self, NULL)) ||
+        !(m = GMPy_FixedBasePow_GetModulus_Attrib(self, NULL)))
+        goto done;
+
+#ifdef PY3
+    result = PyUnicode_FromFormat("FixedBasePow(%S, %S, %lu)", g, m,
+                                  (unsigned long)self->bits);
+#else
+    {
+        PyObject *gs = NULL, *ms = NULL;
+
+        if ((gs = PyObject_Str(g)) && (ms = PyObject_Str(m)))
+            result = PyString_FromFormat("FixedBasePow(%s, %s, %lu)",
+                                         PyString_AS_STRING(gs),
+                                         PyString_AS_STRING(ms),
+                                         (unsigned long)self->bits);
+        Py_XDECREF(gs);
+        Py_XDECREF(ms);
+    }
+#endif
+
+  done:
+    Py_XDECREF(g);
+    Py_XDECREF(m);
+    return result;
+}
+
+static PyGetSetDef GMPy_FixedBasePow_getseters[] =
+{
+    { "base", (getter)GMPy_FixedBasePow_GetBase_Attrib, NULL, "base, reduced modulo the modulus", NULL },
+    { "max_exp_bits", (getter)GMPy_FixedBasePow_GetMaxExpBits_Attrib, NULL, "largest exponent size that uses the table", NULL },
+    { "modulus", (getter)GMPy_FixedBasePow_GetModulus_Attrib, NULL, "modulus", NULL },
+    { "window", (getter)GMPy_FixedBasePow_GetWindow_Attrib, NULL, "exponent bits per table entry", NULL },
+    {NULL}
+};
+
+static PyMethodDef GMPy_FixedBasePow_methods[] =
+{
+    { "__sizeof__", GMPy_FixedBasePow_Method_SizeOf, METH_NOARGS, GMPy_doc_fixedbasepow_method_sizeof },
+    { "batch_pow", GMPy_FixedBasePow_Method_BatchPow, METH_O, GMPy_doc_fixedbasepow_method_batch_pow },
+    { "pow", GMPy_FixedBasePow_Method_Pow, METH_O, GMPy_doc_fixedbasepow_method_pow },
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject FixedBasePow_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                  /* ob_size          */
+#endif
+    "FixedBasePow",                         /* tp_name          */
+    sizeof(FixedBasePow_Object),            /* tp_basicsize     */
+        0,                                  /* tp_itemsize      */
+    (destructor) GMPy_FixedBasePow_Dealloc, /* tp_dealloc       */
+        0,                                  /* tp_print         */
+        0,                                  /* tp_getattr       */
+        0,                                  /* tp_setattr       */
+        0,                                  /* tp_reserved      */
+    (reprfunc) GMPy_FixedBasePow_Repr_Slot, /* tp_repr          */
+        0,                                  /* tp_as_number     */
+        0,                                  /* tp_as_sequence   */
+        0,                                  /* tp_as_mapping    */
+        0,                                  /* tp_hash          */
+        0,                                  /* tp_call          */
+        0,                                  /* tp_str           */
+        0,                                  /* tp_getattro      */
+        0,                                  /* tp_setattro      */
+        0,                                  /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                     /* tp_flags         */
+    "Fixed-base modular exponentiation",    /* tp_doc           */
+        0,                                  /* tp_traverse      */
+        0,                                  /* tp_clear         */
+        0,                                  /* tp_richcompare   */
+        0,                                  /* tp_weaklistoffset*/
+        0,                                  /* tp_iter          */
+        0,                                  /* tp_iternext      */
+    GMPy_FixedBasePow_methods,              /* tp_methods       */
+        0,                                  /* tp_members       */
+    GMPy_FixedBasePow_getseters,            /* tp_getset        */
+};
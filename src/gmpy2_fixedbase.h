@@ -0,0 +1,62 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_fixedbase.h                                                       *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef GMPY_FIXEDBASE_H
+#define GMPY_FIXEDBASE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A FixedBasePow stores a table of g**(2**(window*j)) mod m for
+ * j = 0 .. count-1. Exponents with at most window*count bits are
+ * evaluated with the BGMW (Brickell, Gordon, McCurley, and Wilson)
+ * method using at most count + 2**window - 2 modular multiplications and
+ * no squarings.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    mpz_t g;                /* the base, reduced modulo m */
+    mpz_t m;                /* the modulus, always positive */
+    mp_bitcnt_t bits;       /* max_exp_bits requested by the caller */
+    int window;             /* number of exponent bits per table entry */
+    Py_ssize_t count;       /* number of table entries */
+    mpz_t *table;           /* table[j] = g**(2**(window*j)) mod m */
+} FixedBasePow_Object;
+
+static PyTypeObject FixedBasePow_Type;
+#define FixedBasePow_Check(v) (((PyObject*)v)->ob_type == &FixedBasePow_Type)
+
+static PyObject *  GMPy_FixedBasePow_Factory(PyObject *self, GMPY_FASTCALL_ARGS);
+static unsigned long GMPy_FixedBasePow_Digit(mpz_srcptr e, mp_bitcnt_t start, int window);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
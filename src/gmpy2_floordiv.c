@@ -55,8 +55,14 @@ static PyObject *
 GMPy_Integer_FloorDiv(PyObject *x, PyObject *y, CTXT_Object *context)
 {
     MPZ_Object *result;
+    long a, b, q, r;
 
-    if (!(result = GMPy_MPZ_New(context)))
+    if (GMPy_Integer_AsWord(x, &a) && GMPy_Integer_AsWord(y, &b) &&
+        GMPy_Word_FDivMod(a, b, &q, &r)) {
+        return (PyObject*)GMPy_MPZ_From_SI(q, context);
+    }
+
+    if (!(result = GMPy_MPZ_NewSize(GMPY_DIV_SIZE(x, y), context)))
         return NULL;
 
     if (CHECK_MPZANY(x)) {
@@ -94,7 +100,9 @@ GMPy_Integer_FloorDiv(PyObject *x, PyObject *y, CTXT_Object *context)
                 Py_DECREF((PyObject*)result);
                 return NULL;
             }
+            GMPY_MAYBE_BEGIN_ALLOW_THREADS(GMPY_GIL_SIZE(x, y));
             mpz_fdiv_q(result->z, MPZ(x), MPZ(y));
+            GMPY_MAYBE_END_ALLOW_THREADS;
             return (PyObject*)result;
         }
     }
@@ -135,7 +143,9 @@ GMPy_Integer_FloorDiv(PyObject *x, PyObject *y, CTXT_Object *context)
             return NULL;
         }
 
+        GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z) + mpz_size(tempy->z));
         mpz_fdiv_q(result->z, tempx->z, tempy->z);
+        GMPY_MAYBE_END_ALLOW_THREADS;
         Py_DECREF((PyObject*)tempx);
         Py_DECREF((PyObject*)tempy);
         return (PyObject*)result;
@@ -156,13 +166,20 @@ GMPy_MPZ_FloorDiv_Slot(PyObject *x, PyObject *y)
 {
     if (CHECK_MPZANY(x) && CHECK_MPZANY(y)) {
         MPZ_Object *result;
+        long a, b, q, r;
 
+        if (GMPy_Integer_AsWord(x, &a) && GMPy_Integer_AsWord(y, &b) &&
+            GMPy_Word_FDivMod(a, b, &q, &r)) {
+            return (PyObject*)GMPy_MPZ_From_SI(q, NULL);
+        }
         if (mpz_sgn(MPZ(y)) == 0) {
             ZERO_ERROR("division or modulo by zero");
             return NULL;
         }
-        if ((result = GMPy_MPZ_New(NULL))) {
+        if ((result = GMPy_MPZ_NewSize(GMPY_DIV_SIZE(x, y), NULL))) {
+            GMPY_MAYBE_BEGIN_ALLOW_THREADS(GMPY_GIL_SIZE(x, y));
             mpz_fdiv_q(result->z, MPZ(x), MPZ(y));
+            GMPY_MAYBE_END_ALLOW_THREADS;
         }
         return (PyObject*)result;
     }
@@ -441,11 +458,11 @@ PyDoc_STRVAR(GMPy_doc_context_floordiv,
 "Return x // y; uses floor division.");
 
 static PyObject *
-GMPy_Context_FloorDiv(PyObject *self, PyObject *args)
+GMPy_Context_FloorDiv(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("floor_div() requires 2 arguments");
         return NULL;
     }
@@ -458,7 +475,7 @@ GMPy_Context_FloorDiv(PyObject *self, PyObject *args)
     }
 
 
-    return GMPy_Number_FloorDiv(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1),
+    return GMPy_Number_FloorDiv(GMPY_ARG(0), GMPY_ARG(1),
                                 context);
 }
 
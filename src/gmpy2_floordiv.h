@@ -48,7 +48,7 @@ static PyObject * GMPy_MPQ_FloorDiv_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPFR_FloorDiv_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPC_FloorDiv_Slot(PyObject *x, PyObject *y);
 
-static PyObject * GMPy_Context_FloorDiv(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_FloorDiv(PyObject *self, GMPY_FASTCALL_ARGS);
 
 #ifdef __cplusplus
 }
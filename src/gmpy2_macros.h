@@ -61,8 +61,8 @@
  *     GMPy_Complex_NAME(x, y, Z, context)
  *     GMPy_Number_NAME(x, y, Z, context)
  *     - assumes GMPy_Integer_NAME & GMPy_Rational_NAME also exist
- *     GMPy_Context_NAME(self, args)
- *     - called with METH_VARARGS
+ *     GMPy_Context_NAME(self, args, nargs)
+ *     - called with METH_FASTCALL (METH_VARARGS before Python 3.7)
  * 
  * GMPY_MPFR_MPC_UNIOP_TEMPLATE(NAME, FUNC) creates the following functions:
  *     GMPy_Number_NAME(x, context)
@@ -85,8 +85,8 @@
  * GMPY_MPFR_BINOP(NAME, FUNC) creates the following functions:
  *     GMPy_Real_NAME(x, y, context)
  *     GMPy_Number_NAME(x, y, context)
- *     GMPy_Context_NAME(self, args)
- *     - called with METH_VARARGS
+ *     GMPy_Context_NAME(self, args, nargs)
+ *     - called with METH_FASTCALL (METH_VARARGS before Python 3.7)
  *
  */
 
@@ -304,10 +304,10 @@ GMPy_Number_##NAME(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context)
     return NULL; \
 } \
 static PyObject * \
-GMPy_Context_##NAME(PyObject *self, PyObject *args) \
+GMPy_Context_##NAME(PyObject *self, GMPY_FASTCALL_ARGS) \
 { \
     CTXT_Object *context = NULL; \
-    if (PyTuple_GET_SIZE(args) != 3) { \
+    if (GMPY_NARGS != 3) { \
         TYPE_ERROR(#FUNC"() requires 3 arguments"); \
         return NULL; \
     } \
@@ -317,8 +317,8 @@ GMPy_Context_##NAME(PyObject *self, PyObject *args) \
     else { \
         CHECK_CONTEXT(context); \
     } \
-    return GMPy_Number_##NAME(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), \
-                              PyTuple_GET_ITEM(args, 2), context); \
+    return GMPy_Number_##NAME(GMPY_ARG(0), GMPY_ARG(1), \
+                              GMPY_ARG(2), context); \
 }
 
 #define GMPY_MPFR_UNIOP(NAME, FUNC) \
@@ -574,10 +574,10 @@ GMPy_Number_##NAME(PyObject *x, PyObject *y, CTXT_Object *context) \
     return NULL; \
 } \
 static PyObject * \
-GMPy_Context_##NAME(PyObject *self, PyObject *args) \
+GMPy_Context_##NAME(PyObject *self, GMPY_FASTCALL_ARGS) \
 { \
     CTXT_Object *context = NULL; \
-    if (PyTuple_GET_SIZE(args) != 2) { \
+    if (GMPY_NARGS != 2) { \
         TYPE_ERROR(#FUNC"() requires 2 arguments"); \
         return NULL; \
     } \
@@ -587,7 +587,7 @@ GMPy_Context_##NAME(PyObject *self, PyObject *args) \
     else { \
         CHECK_CONTEXT(context); \
     } \
-    return GMPy_Number_##NAME(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context); \
+    return GMPy_Number_##NAME(GMPY_ARG(0), GMPY_ARG(1), context); \
 } \
 
 /* Macro to support functions that require ('mpfr', 'int').
@@ -624,10 +624,10 @@ GMPy_Number_##NAME(PyObject *x, PyObject *y, CTXT_Object *context) \
     return NULL; \
 } \
 static PyObject * \
-GMPy_Context_##NAME(PyObject *self, PyObject *args) \
+GMPy_Context_##NAME(PyObject *self, GMPY_FASTCALL_ARGS) \
 { \
     CTXT_Object *context = NULL; \
-    if (PyTuple_GET_SIZE(args) != 2) { \
+    if (GMPY_NARGS != 2) { \
         TYPE_ERROR(#FUNC"() requires 2 arguments"); \
         return NULL; \
     } \
@@ -637,7 +637,7 @@ GMPy_Context_##NAME(PyObject *self, PyObject *args) \
     else { \
         CHECK_CONTEXT(context); \
     } \
-    return GMPy_Number_##NAME(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context); \
+    return GMPy_Number_##NAME(GMPY_ARG(0), GMPY_ARG(1), context); \
 } \
 
 /* Macro to support functions that require ('mpfr', 'int').
@@ -675,10 +675,10 @@ GMPy_Number_##NAME(PyObject *x, PyObject *y, CTXT_Object *context) \
     return NULL; \
 } \
 static PyObject * \
-GMPy_Context_##NAME(PyObject *self, PyObject *args) \
+GMPy_Context_##NAME(PyObject *self, GMPY_FASTCALL_ARGS) \
 { \
     CTXT_Object *context = NULL; \
-    if (PyTuple_GET_SIZE(args) != 2) { \
+    if (GMPY_NARGS != 2) { \
         TYPE_ERROR(#FUNC"() requires 2 arguments"); \
         return NULL; \
     } \
@@ -688,7 +688,7 @@ GMPy_Context_##NAME(PyObject *self, PyObject *args) \
     else { \
         CHECK_CONTEXT(context); \
     } \
-    return GMPy_Number_##NAME(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context); \
+    return GMPy_Number_##NAME(GMPY_ARG(0), GMPY_ARG(1), context); \
 } \
 
 #define GMPY_MPFR_BINOP_TEMPLATE(NAME, FUNC) \
@@ -701,10 +701,10 @@ GMPy_Number_##NAME(PyObject *x, PyObject *y, CTXT_Object *context) \
     return NULL; \
 } \
 static PyObject * \
-GMPy_Context_##NAME(PyObject *self, PyObject *args) \
+GMPy_Context_##NAME(PyObject *self, GMPY_FASTCALL_ARGS) \
 { \
     CTXT_Object *context = NULL; \
-    if (PyTuple_GET_SIZE(args) != 2) { \
+    if (GMPY_NARGS != 2) { \
         TYPE_ERROR(#FUNC"() requires 2 arguments"); \
         return NULL; \
     } \
@@ -714,7 +714,7 @@ GMPy_Context_##NAME(PyObject *self, PyObject *args) \
     else { \
         CHECK_CONTEXT(context); \
     } \
-    return GMPy_Number_##NAME(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context); \
+    return GMPy_Number_##NAME(GMPY_ARG(0), GMPY_ARG(1), context); \
 } \
 
 #define GMPY_MPFR_BINOP_EX(NAME, FUNC) \
@@ -759,10 +759,10 @@ GMPy_Number_##NAME(PyObject *x, PyObject *y, CTXT_Object *context) \
     return NULL; \
 } \
 static PyObject * \
-GMPy_Context_##NAME(PyObject *self, PyObject *args) \
+GMPy_Context_##NAME(PyObject *self, GMPY_FASTCALL_ARGS) \
 { \
     CTXT_Object *context = NULL; \
-    if (PyTuple_GET_SIZE(args) != 2) { \
+    if (GMPY_NARGS != 2) { \
         TYPE_ERROR(#FUNC"() requires 2 arguments"); \
         return NULL; \
     } \
@@ -772,7 +772,7 @@ GMPy_Context_##NAME(PyObject *self, PyObject *args) \
     else { \
         CHECK_CONTEXT(context); \
     } \
-    return GMPy_Number_##NAME(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context); \
+    return GMPy_Number_##NAME(GMPY_ARG(0), GMPY_ARG(1), context); \
 } \
 
 /* GMPY_MPFR_CONST(NAME, FUNCT) is the template for creating constants. For
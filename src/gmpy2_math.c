@@ -1271,11 +1271,11 @@ GMPy_Number_Round2(PyObject *x, PyObject *y, CTXT_Object *context)
 }
 
 static PyObject *
-GMPy_Context_Round2(PyObject *self, PyObject *args)
+GMPy_Context_Round2(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
     
-    if (PyTuple_GET_SIZE(args) < 1 || PyTuple_GET_SIZE(args) > 2) {
+    if (GMPY_NARGS < 1 || GMPY_NARGS > 2) {
         TYPE_ERROR("round2() requires 1 or 2 arguments");
         return NULL;
     }
@@ -1287,11 +1287,11 @@ GMPy_Context_Round2(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    if (PyTuple_GET_SIZE(args) == 1) {
-        return GMPy_Number_Round2(PyTuple_GET_ITEM(args, 0), NULL, context);
+    if (GMPY_NARGS == 1) {
+        return GMPy_Number_Round2(GMPY_ARG(0), NULL, context);
     }
     else {
-        return GMPy_Number_Round2(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context);
+        return GMPy_Number_Round2(GMPY_ARG(0), GMPY_ARG(1), context);
     }
 }
 
@@ -1588,7 +1588,7 @@ PyDoc_STRVAR(GMPy_doc_context_next_toward,
 "the same precision as x.");
 
 static PyObject *
-GMPy_Context_NextToward(PyObject *self, PyObject *args)
+GMPy_Context_NextToward(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPFR_Object *result, *tempx, *tempy;
     CTXT_Object *context = NULL;
@@ -1600,13 +1600,13 @@ GMPy_Context_NextToward(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("next_toward() requires 2 arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPFR_From_Real(PyTuple_GET_ITEM(args, 0), 1, context);
-    tempy = GMPy_MPFR_From_Real(PyTuple_GET_ITEM(args, 1), 1, context);
+    tempx = GMPy_MPFR_From_Real(GMPY_ARG(0), 1, context);
+    tempy = GMPy_MPFR_From_Real(GMPY_ARG(1), 1, context);
     if (!tempx || !tempy) {
         TYPE_ERROR("next_toward() argument type not supported");
         Py_XDECREF((PyObject*)tempx);
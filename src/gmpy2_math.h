@@ -127,11 +127,11 @@ static PyObject * GMPy_Context_Sinh_Cosh(PyObject *self, PyObject *other);
 
 static PyObject * GMPy_Real_Atan2(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Atan2(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Atan2(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Atan2(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_Hypot(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Hypot(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Hypot(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Hypot(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Context_Degrees(PyObject *self, PyObject *other);
 static PyObject * GMPy_Context_Radians(PyObject *self, PyObject *other);
@@ -258,47 +258,47 @@ static PyObject * GMPy_Context_Ai(PyObject *self, PyObject *other);
 
 static PyObject * GMPy_Real_FMA(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
 static PyObject * GMPy_Number_FMA(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
-static PyObject * GMPy_Context_FMA(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_FMA(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_FMS(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
 static PyObject * GMPy_Number_FMS(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
-static PyObject * GMPy_Context_FMS(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_FMS(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_Root(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Root(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Root(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Root(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_Jn(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Jn(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Jn(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Jn(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_Yn(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Yn(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Yn(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Yn(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_AGM(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_AGM(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_AGM(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_AGM(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_Maxnum(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Maxnum(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Maxnum(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Maxnum(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_Minnum(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Minnum(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Minnum(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Minnum(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_Remainder(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Remainder(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Remainder(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Remainder(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_Fmod(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Fmod(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Fmod(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Fmod(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_RelDiff(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_RelDiff(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_RelDiff(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_RelDiff(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_Ceil(PyObject *x, CTXT_Object *context);
 static PyObject * GMPy_Number_Ceil(PyObject *x, CTXT_Object *context);
@@ -317,7 +317,7 @@ static PyObject * GMPy_Context_Trunc(PyObject *self, PyObject *args);
 
 static PyObject * GMPy_Real_Round2(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Round2(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Round2(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Round2(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_RoundAway(PyObject *x, CTXT_Object *context);
 static PyObject * GMPy_Number_RoundAway(PyObject *x, CTXT_Object *context);
@@ -333,13 +333,13 @@ static PyObject * GMPy_Context_Lgamma(PyObject *self, PyObject *other);
 
 static PyObject * GMPy_Real_RemQuo(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_RemQuo(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_RemQuo(PyObject *self, PyObject *other);
+static PyObject * GMPy_Context_RemQuo(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_Frexp(PyObject *x, CTXT_Object *context);
 static PyObject * GMPy_Number_Frexp(PyObject *x, CTXT_Object *context);
 static PyObject * GMPy_Context_Frexp(PyObject *self, PyObject *other);
 
-static PyObject * GMPy_Context_NextToward(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_NextToward(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Context_NextAbove(PyObject *self, PyObject *other);
 
@@ -232,11 +232,11 @@ PyDoc_STRVAR(GMPy_doc_context_minus,
 "Return -x. The context is applied to the result.");
 
 static PyObject *
-GMPy_Context_Minus(PyObject *self, PyObject *args)
+GMPy_Context_Minus(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 1) {
+    if (GMPY_NARGS != 1) {
         TYPE_ERROR("minus() requires 1 argument.");
         return NULL;
     }
@@ -248,6 +248,6 @@ GMPy_Context_Minus(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Minus(PyTuple_GET_ITEM(args, 0), context);
+    return GMPy_Number_Minus(GMPY_ARG(0), context);
 }
 
@@ -48,7 +48,7 @@ static PyObject * GMPy_MPQ_Minus_Slot(MPQ_Object *x);
 static PyObject * GMPy_MPFR_Minus_Slot(MPFR_Object *x);
 static PyObject * GMPy_MPC_Minus_Slot(MPC_Object *x);
 
-static PyObject * GMPy_Context_Minus(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Minus(PyObject *self, GMPY_FASTCALL_ARGS);
 
 #ifdef __cplusplus
 }
@@ -109,7 +109,9 @@ GMPy_get_mp_limbsize(PyObject *self, PyObject *args)
 PyDoc_STRVAR(GMPy_doc_get_cache,
 "get_cache() -> (cache_size, object_size)\n\n\
 Return the current cache size (number of objects) and maximum size\n\
-per object (number of limbs) for all GMPY2 objects.");
+per object (number of limbs) for all GMPY2 objects. The mpz, xmpz,\n\
+mpfr, and mpc caches are divided into size classes; get_cache_bins()\n\
+reports the hits and misses of each size class.");
 
 static PyObject *
 GMPy_get_cache(PyObject *self, PyObject *args)
@@ -117,6 +119,231 @@ GMPy_get_cache(PyObject *self, PyObject *args)
     return Py_BuildValue("(ii)", global.cache_size, global.cache_obsize);
 }
 
+PyDoc_STRVAR(GMPy_doc_get_cache_bins,
+"get_cache_bins() -> dict\n\n\
+Return the state of the size classes of the mpz_t ('zcache'), 'mpz',\n\
+'xmpz', 'mpfr', and 'mpc' caches. Each value is a list with one tuple per\n\
+size class: (min_limbs, limit, in_cache, hits, misses). A size class holds\n\
+objects with at least min_limbs and less than 2*min_limbs limbs allocated,\n\
+up to a maximum of limit objects. An mpfr or mpc is only reused for a\n\
+precision in the same size class; the size class of an mpc is that of\n\
+the larger of its two parts. Each thread has its own caches; the values\n\
+describe the caches of the current thread.");
+
+static PyObject *
+GMPy_Cache_Bins_To_List(GMPy_Cache_Bin *bins)
+{
+    PyObject *result, *item;
+    int k;
+
+    if (!(result = PyList_New(GMPY_CACHE_BINS)))
+        return NULL;
+
+    for (k = 0; k < GMPY_CACHE_BINS; k++) {
+        if (!(item = Py_BuildValue("(iiinn)", 1 << k, bins[k].limit,
+                                   bins[k].in_cache,
+                                   (Py_ssize_t)bins[k].hits,
+                                   (Py_ssize_t)bins[k].misses))) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyList_SET_ITEM(result, k, item);
+    }
+    return result;
+}
+
+static PyObject *
+GMPy_get_cache_bins(PyObject *self, PyObject *args)
+{
+    PyObject *result, *zbins = NULL, *mpzbins = NULL, *xmpzbins = NULL;
+    PyObject *mpfrbins = NULL, *mpcbins = NULL;
+    GMPy_Cache *cache;
+
+    if (!(cache = GMPy_Cache_Get())) {
+        SYSTEM_ERROR("the caches of the current thread are not available");
+        return NULL;
+    }
+
+    if ((zbins = GMPy_Cache_Bins_To_List(cache->z.bin)) &&
+        (mpzbins = GMPy_Cache_Bins_To_List(cache->mpz.bin)) &&
+        (xmpzbins = GMPy_Cache_Bins_To_List(cache->xmpz.bin)) &&
+        (mpfrbins = GMPy_Cache_Bins_To_List(cache->mpfr.bin)) &&
+        (mpcbins = GMPy_Cache_Bins_To_List(cache->mpc.bin))) {
+        result = Py_BuildValue("{sOsOsOsOsO}", "zcache", zbins, "mpz", mpzbins,
+                               "xmpz", xmpzbins, "mpfr", mpfrbins,
+                               "mpc", mpcbins);
+    }
+    else {
+        result = NULL;
+    }
+    Py_XDECREF(zbins);
+    Py_XDECREF(mpzbins);
+    Py_XDECREF(xmpzbins);
+    Py_XDECREF(mpfrbins);
+    Py_XDECREF(mpcbins);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_cache_stats,
+"cache_stats() -> dict\n\n\
+Return statistics for the caches of the current thread. The keys are\n\
+'zcache', 'mpz', 'xmpz', 'mpq', 'mpfr', and 'mpc'. Each value is a dict\n\
+with the number of requests served from the cache ('hits') and not\n\
+served ('misses'), the number of freed objects that were not cached\n\
+because they were larger than the maximum object size ('oversize') or\n\
+because the cache and the pool were full ('full'), the number of objects\n\
+in the cache ('in_cache'), and the approximate number of bytes they use\n\
+('bytes'). 'pool' and 'pool_bytes' describe the objects in the pool\n\
+shared by all threads.");
+
+/* Return the statistics of one object cache as a dict. If pool is not
+ * NULL, it must be locked by the caller.
+ */
+
+static PyObject *
+GMPy_Object_Cache_Stats(GMPy_Object_Cache *oc, GMPy_Object_Cache *pool, size_t which)
+{
+    size_t hits = 0, misses = 0, bytes = 0, pool_bytes = 0;
+    Py_ssize_t in_cache = 0, pool_in_cache = 0;
+    int i, k;
+
+    for (k = 0; k < GMPY_CACHE_BINS; k++) {
+        hits += oc->bin[k].hits;
+        misses += oc->bin[k].misses;
+        in_cache += oc->bin[k].in_cache;
+        for (i = 0; i < oc->bin[k].in_cache; i++)
+            bytes += GMPy_Cache_Bytes(which, oc->items[k][i]);
+        if (pool) {
+            pool_in_cache += pool->bin[k].in_cache;
+            for (i = 0; i < pool->bin[k].in_cache; i++)
+                pool_bytes += GMPy_Cache_Bytes(which, pool->items[k][i]);
+        }
+    }
+
+    return Py_BuildValue("{snsnsnsnsnsnsnsn}",
+                         "hits", (Py_ssize_t)hits,
+                         "misses", (Py_ssize_t)misses,
+                         "oversize", (Py_ssize_t)oc->oversize,
+                         "full", (Py_ssize_t)oc->full,
+                         "in_cache", in_cache,
+                         "bytes", (Py_ssize_t)bytes,
+                         "pool", pool_in_cache,
+                         "pool_bytes", (Py_ssize_t)pool_bytes);
+}
+
+static PyObject *
+GMPy_cache_stats(PyObject *self, PyObject *args)
+{
+    static const char *names[] = { "mpz", "xmpz", "mpq", "mpfr", "mpc" };
+    PyObject *result, *item;
+    GMPy_Object_Cache *pool = NULL;
+    GMPy_Cache *cache;
+    size_t hits = 0, misses = 0, bytes = 0;
+    Py_ssize_t in_cache = 0;
+    int i, k;
+
+    if (!(cache = GMPy_Cache_Get())) {
+        SYSTEM_ERROR("the caches of the current thread are not available");
+        return NULL;
+    }
+
+    if (!(result = PyDict_New()))
+        return NULL;
+
+    for (k = 0; k < GMPY_CACHE_BINS; k++) {
+        hits += cache->z.bin[k].hits;
+        misses += cache->z.bin[k].misses;
+        in_cache += cache->z.bin[k].in_cache;
+        for (i = 0; i < cache->z.bin[k].in_cache; i++)
+            bytes += cache->z.items[k][i]->_mp_alloc * sizeof(mp_limb_t);
+    }
+    item = Py_BuildValue("{snsnsnsnsnsnsnsn}",
+                         "hits", (Py_ssize_t)hits,
+                         "misses", (Py_ssize_t)misses,
+                         "oversize", (Py_ssize_t)cache->z.oversize,
+                         "full", (Py_ssize_t)cache->z.full,
+                         "in_cache", in_cache,
+                         "bytes", (Py_ssize_t)bytes,
+                         "pool", (Py_ssize_t)0,
+                         "pool_bytes", (Py_ssize_t)0);
+    if (!item || PyDict_SetItemString(result, "zcache", item) < 0) {
+        Py_XDECREF(item);
+        Py_DECREF(result);
+        return NULL;
+    }
+    Py_DECREF(item);
+
+    for (i = 0; i < (int)(sizeof(gmpy_cache_kinds) / sizeof(size_t)); i++) {
+#ifdef GMPY_TLS
+        pool = GMPY_OBJECT_CACHE(&gmpy_cache_pool, gmpy_cache_kinds[i]);
+        PyThread_acquire_lock(gmpy_cache_lock, WAIT_LOCK);
+#endif
+        item = GMPy_Object_Cache_Stats(GMPY_OBJECT_CACHE(cache, gmpy_cache_kinds[i]),
+                                       pool, gmpy_cache_kinds[i]);
+#ifdef GMPY_TLS
+        PyThread_release_lock(gmpy_cache_lock);
+#endif
+        if (!item || PyDict_SetItemString(result, names[i], item) < 0) {
+            Py_XDECREF(item);
+            Py_DECREF(result);
+            return NULL;
+        }
+        Py_DECREF(item);
+    }
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_reset_cache_stats,
+"reset_cache_stats()\n\n\
+Set the hits, misses, oversize, and full counts reported by cache_stats() and\n\
+get_cache_bins() for the current thread to 0.");
+
+static PyObject *
+GMPy_reset_cache_stats(PyObject *self, PyObject *args)
+{
+    GMPy_Cache *cache;
+
+    if (!(cache = GMPy_Cache_Get())) {
+        SYSTEM_ERROR("the caches of the current thread are not available");
+        return NULL;
+    }
+    GMPy_Cache_Reset_Stats(cache);
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(GMPy_doc_get_cache_autotune,
+"get_cache_autotune() -> bool\n\n\
+Return True if the cache size is adjusted automatically. See\n\
+set_cache_autotune().");
+
+static PyObject *
+GMPy_get_cache_autotune(PyObject *self, PyObject *args)
+{
+    if (global.cache_autotune)
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+PyDoc_STRVAR(GMPy_doc_set_cache_autotune,
+"set_cache_autotune(flag)\n\n\
+If flag is true, the miss rate of the caches of each thread is checked\n\
+after every 1024 misses. If more than a quarter of the requests missed\n\
+and objects were freed because the caches were full, the cache size is\n\
+doubled, up to 1000 objects. The cache size is never\n\
+reduced automatically; use set_cache() to reduce it.");
+
+static PyObject *
+GMPy_set_cache_autotune(PyObject *self, PyObject *other)
+{
+    int flag;
+
+    if ((flag = PyObject_IsTrue(other)) < 0)
+        return NULL;
+
+    global.cache_autotune = flag;
+    Py_RETURN_NONE;
+}
+
 PyDoc_STRVAR(GMPy_doc_set_cache,
 "set_cache(cache_size, object_size)\n\n\
 Set the current cache size (number of objects) and the maximum size\n\
@@ -141,12 +368,50 @@ GMPy_set_cache(PyObject *self, PyObject *args)
 
     global.cache_size = newcache;
     global.cache_obsize = newsize;
-    set_zcache();
-    set_gmpympzcache();
-    set_gmpympqcache();
-    set_gmpyxmpzcache();
-    set_gmpympfrcache();
-    set_gmpympccache();
+    set_cache_limits();
+    Py_RETURN_NONE;
+}
+
+/*
+ * access the GIL release threshold
+ */
+
+PyDoc_STRVAR(GMPy_doc_get_gil_threshold,
+"get_gil_threshold() -> integer\n\n\
+Return the minimum size of the operands (number of limbs) that will\n\
+cause the GIL to be released during a long running mpz operation. A\n\
+value of 0 indicates the GIL is never released.");
+
+static PyObject *
+GMPy_get_gil_threshold(PyObject *self, PyObject *args)
+{
+    return PyIntOrLong_FromLong(global.gil_threshold);
+}
+
+PyDoc_STRVAR(GMPy_doc_set_gil_threshold,
+"set_gil_threshold(size)\n\n\
+Set the minimum size of the operands (number of limbs) that will cause\n\
+the GIL to be released during multiplication, division, powmod, gcd,\n\
+and root calculations on mpz values. Other Python threads can run while\n\
+the calculation is in progress. A value of 0 disables the release of\n\
+the GIL. Raises ValueError if size is negative.");
+
+static PyObject *
+GMPy_set_gil_threshold(PyObject *self, PyObject *other)
+{
+    long newsize;
+
+    newsize = PyIntOrLong_AsLong(other);
+    if (newsize == -1 && PyErr_Occurred()) {
+        TYPE_ERROR("set_gil_threshold() requires 'int' argument");
+        return NULL;
+    }
+    if (newsize < 0) {
+        VALUE_ERROR("size must be >= 0");
+        return NULL;
+    }
+
+    global.gil_threshold = newsize;
     Py_RETURN_NONE;
 }
 
@@ -206,3 +471,57 @@ GMPy_printf(PyObject *self, PyObject *args)
     }
 }
 
+
+/* Parse the arguments of a function that is called with the
+ * GMPY_METH_FASTCALL | METH_KEYWORDS calling convention. The format string
+ * and the keyword list are the same as for PyArg_ParseTupleAndKeywords().
+ * When METH_FASTCALL is used, the arguments are copied into a temporary
+ * tuple and dictionary so callers should handle the common cases directly
+ * and only use this function when keywords are present. Objects returned
+ * by the "O" format are borrowed from the caller's arguments.
+ */
+
+static int
+GMPy_ParseArgsAndKeywords(GMPY_FASTCALL_KWARGS, const char *format,
+                          char **kwlist, ...)
+{
+    int result;
+    va_list va;
+#ifdef GMPY_FASTCALL
+    PyObject *tuple = NULL, *dict = NULL;
+    Py_ssize_t i;
+
+    if (!(tuple = PyTuple_New(nargs))) {
+        return 0;
+    }
+    for (i = 0; i < nargs; i++) {
+        Py_INCREF(args[i]);
+        PyTuple_SET_ITEM(tuple, i, args[i]);
+    }
+
+    if (kwnames) {
+        if (!(dict = PyDict_New())) {
+            Py_DECREF(tuple);
+            return 0;
+        }
+        for (i = 0; i < PyTuple_GET_SIZE(kwnames); i++) {
+            if (PyDict_SetItem(dict, PyTuple_GET_ITEM(kwnames, i), args[nargs + i]) < 0) {
+                Py_DECREF(tuple);
+                Py_DECREF(dict);
+                return 0;
+            }
+        }
+    }
+
+    va_start(va, kwlist);
+    result = PyArg_VaParseTupleAndKeywords(tuple, dict, (char*)format, kwlist, va);
+    va_end(va);
+    Py_DECREF(tuple);
+    Py_XDECREF(dict);
+#else
+    va_start(va, kwlist);
+    result = PyArg_VaParseTupleAndKeywords(args, kwnames, (char*)format, kwlist, va);
+    va_end(va);
+#endif
+    return result;
+}
@@ -41,8 +41,14 @@ static PyObject * GMPy_get_mpc_version(PyObject *self, PyObject *args);
 static PyObject * GMPy_get_mp_limbsize(PyObject *self, PyObject *args);
 static PyObject * GMPy_get_cache(PyObject *self, PyObject *args);
 static PyObject * GMPy_set_cache(PyObject *self, PyObject *args);
+static PyObject * GMPy_get_cache_bins(PyObject *self, PyObject *args);
+static PyObject * GMPy_get_gil_threshold(PyObject *self, PyObject *args);
+static PyObject * GMPy_set_gil_threshold(PyObject *self, PyObject *other);
 static PyObject * GMPy_printf(PyObject *self, PyObject *args);
 
+static int        GMPy_ParseArgsAndKeywords(GMPY_FASTCALL_KWARGS, const char *format,
+                                            char **kwlist, ...);
+
 #ifdef __cplusplus
 }
 #endif
@@ -54,10 +54,16 @@ static PyObject *
 GMPy_Integer_Mod(PyObject *x, PyObject *y, CTXT_Object *context)
 {
     MPZ_Object *result;
+    long a, b, q, r;
+
+    if (GMPy_Integer_AsWord(x, &a) && GMPy_Integer_AsWord(y, &b) &&
+        GMPy_Word_FDivMod(a, b, &q, &r)) {
+        return (PyObject*)GMPy_MPZ_From_SI(r, context);
+    }
 
     CHECK_CONTEXT(context);
 
-    if (!(result = GMPy_MPZ_New(context)))
+    if (!(result = GMPy_MPZ_NewSize(GMPY_MPZ_SIZE(y), context)))
         return NULL;
 
     if (CHECK_MPZANY(x)) {
@@ -94,7 +100,9 @@ GMPy_Integer_Mod(PyObject *x, PyObject *y, CTXT_Object *context)
                 Py_DECREF((PyObject*)result);
                 return NULL;
             }
+            GMPY_MAYBE_BEGIN_ALLOW_THREADS(GMPY_GIL_SIZE(x, y));
             mpz_fdiv_r(result->z, MPZ(x), MPZ(y));
+            GMPY_MAYBE_END_ALLOW_THREADS;
             return (PyObject*)result;
         }
     }
@@ -135,7 +143,9 @@ GMPy_Integer_Mod(PyObject *x, PyObject *y, CTXT_Object *context)
             Py_DECREF((PyObject*)result);
             return NULL;
         }
+        GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z) + mpz_size(tempy->z));
         mpz_fdiv_r(result->z, tempx->z, tempy->z);
+        GMPY_MAYBE_END_ALLOW_THREADS;
         Py_DECREF((PyObject*)tempx);
         Py_DECREF((PyObject*)tempy);
         return (PyObject*)result;
@@ -369,11 +379,11 @@ PyDoc_STRVAR(GMPy_doc_context_mod,
 "mpfr arguments to context.mod().");
 
 static PyObject *
-GMPy_Context_Mod(PyObject *self, PyObject *args)
+GMPy_Context_Mod(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("mod() requires 2 arguments");
         return NULL;
     }
@@ -385,6 +395,6 @@ GMPy_Context_Mod(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Mod(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context);
+    return GMPy_Number_Mod(GMPY_ARG(0), GMPY_ARG(1), context);
 }
 
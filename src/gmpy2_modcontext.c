@@ -0,0 +1,565 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_modcontext.c                                                      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* This file implements the ModContext type. A ModContext stores a fixed
+ * modulus and provides modular multiplication, squaring, exponentiation,
+ * and inversion, together with batch versions that process an entire
+ * mpz_vector (or iterable) in a single call. The modulus is converted only
+ * once and reduced arguments are used directly, so chained modular
+ * arithmetic avoids most of the argument conversion and reduction
+ * overhead of the module-level functions.
+ */
+
+PyDoc_STRVAR(GMPy_doc_modcontext_factory,
+"ModContext(m) -> ModContext\n\n"
+"Return a context for arithmetic modulo m; m must be positive. The\n"
+"methods mulmod(), sqrmod(), powmod(), and invert() return values in\n"
+"the range [0, m). The batch_*() methods accept an mpz_vector or an\n"
+"iterable of integers and return an mpz_vector or a list.");
+
+static PyObject *
+GMPy_ModContext_Factory(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    ModContext_Object *result;
+    MPZ_Object *tempm;
+
+    if (GMPY_NARGS != 1 || !IS_INTEGER(GMPY_ARG(0))) {
+        TYPE_ERROR("ModContext() requires 'int' argument");
+        return NULL;
+    }
+
+    if (!(tempm = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL)))
+        return NULL;
+
+    if (mpz_sgn(tempm->z) <= 0) {
+        VALUE_ERROR("ModContext() modulus must be positive");
+        Py_DECREF((PyObject*)tempm);
+        return NULL;
+    }
+
+    if (!(result = PyObject_New(ModContext_Object, &ModContext_Type))) {
+        Py_DECREF((PyObject*)tempm);
+        return NULL;
+    }
+
+    mpz_init_set(result->m, tempm->z);
+    result->size = mpz_size(result->m);
+    Py_DECREF((PyObject*)tempm);
+    return (PyObject*)result;
+}
+
+static void
+GMPy_ModContext_Dealloc(ModContext_Object *self)
+{
+    mpz_clear(self->m);
+    PyObject_Del(self);
+}
+
+static PyObject *
+GMPy_ModContext_Repr_Slot(ModContext_Object *self)
+{
+    MPZ_Object *temp;
+    PyObject *str, *result = NULL;
+
+    if (!(temp = GMPy_MPZ_New(NULL)))
+        return NULL;
+    mpz_set(temp->z, self->m);
+    str = PyObject_Str((PyObject*)temp);
+    Py_DECREF((PyObject*)temp);
+    if (!str)
+        return NULL;
+
+#ifdef PY3
+    result = PyUnicode_FromFormat("ModContext(%U)", str);
+#else
+    result = PyString_FromFormat("ModContext(%s)", PyString_AS_STRING(str));
+#endif
+    Py_DECREF(str);
+    return result;
+}
+
+static PyObject *
+GMPy_ModContext_GetModulus_Attrib(ModContext_Object *self, void *closure)
+{
+    MPZ_Object *result;
+
+    if ((result = GMPy_MPZ_New(NULL)))
+        mpz_set(result->z, self->m);
+    return (PyObject*)result;
+}
+
+/* Return x if 0 <= x < m. Otherwise store x mod m in temp and return temp.
+ * x and temp may be the same. The Python API is not used.
+ */
+
+static mpz_srcptr
+GMPy_ModContext_Reduce(ModContext_Object *self, mpz_srcptr x, mpz_ptr temp)
+{
+    if (mpz_sgn(x) >= 0 && mpz_cmp(x, self->m) < 0)
+        return x;
+
+    mpz_fdiv_r(temp, x, self->m);
+    return temp;
+}
+
+/* Convert an integer argument. An mpz is used directly; other integer
+ * types are copied into temp. If reduce is non-zero, the value is reduced
+ * modulo m. Returns NULL if obj is not an integer; no exception is set.
+ */
+
+static mpz_srcptr
+GMPy_ModContext_Arg(ModContext_Object *self, PyObject *obj, mpz_ptr temp, int reduce)
+{
+    mpz_srcptr x;
+
+    if (MPZ_Check(obj)) {
+        x = MPZ(obj);
+    }
+    else if (XMPZ_Check(obj)) {
+        /* Copy an xmpz since the GIL may be released. */
+        mpz_set(temp, MPZ(obj));
+        x = temp;
+    }
+    else if (PyIntOrLong_Check(obj)) {
+        mpz_set_PyIntOrLong(temp, obj);
+        x = temp;
+    }
+    else {
+        return NULL;
+    }
+
+    return reduce ? GMPy_ModContext_Reduce(self, x, temp) : x;
+}
+
+/* Store the result of op in r. x must be reduced. For GMPY_MODCTX_MULMOD,
+ * y must also be reduced; for GMPY_MODCTX_POWMOD, y is the exponent. temp
+ * must be distinct from x and y. Returns 0 on success and -1 if x is not
+ * invertible (only possible for GMPY_MODCTX_INVERT and for
+ * GMPY_MODCTX_POWMOD with a negative exponent). The Python API is not
+ * used so this can be called without holding the GIL.
+ */
+
+static int
+GMPy_ModContext_Op(ModContext_Object *self, int op, mpz_ptr r,
+                   mpz_srcptr x, mpz_srcptr y, mpz_ptr temp)
+{
+    switch (op) {
+    case GMPY_MODCTX_MULMOD:
+        mpz_mul(r, x, y);
+        mpz_tdiv_r(r, r, self->m);
+        break;
+    case GMPY_MODCTX_SQRMOD:
+        mpz_mul(r, x, x);
+        mpz_tdiv_r(r, r, self->m);
+        break;
+    case GMPY_MODCTX_POWMOD:
+        if (mpz_sgn(y) < 0) {
+            if (!mpz_invert(temp, x, self->m))
+                return -1;
+            mpz_neg(r, y);
+            mpz_powm(r, temp, r, self->m);
+        }
+        else {
+            mpz_powm(r, x, y, self->m);
+        }
+        break;
+    case GMPY_MODCTX_INVERT:
+        if (!mpz_invert(r, x, self->m))
+            return -1;
+        break;
+    }
+    return 0;
+}
+
+/* Raise the exception for a failed GMPy_ModContext_Op(). If index is not
+ * negative, it is the index of the element that caused the failure.
+ */
+
+static void
+GMPy_ModContext_OpError(int op, const char *name, Py_ssize_t index)
+{
+    PyObject *exc;
+    const char *msg;
+
+    if (op == GMPY_MODCTX_INVERT) {
+        exc = PyExc_ZeroDivisionError;
+        msg = "no inverse exists";
+    }
+    else {
+        exc = PyExc_ValueError;
+        msg = "base not invertible";
+    }
+
+    if (index < 0)
+        PyErr_Format(exc, "%s %s", name, msg);
+    else
+        PyErr_Format(exc, "%s %s for element %zd", name, msg, index);
+}
+
+/* Apply op to a single pair of arguments. y is NULL for the unary
+ * operations.
+ */
+
+static PyObject *
+GMPy_ModContext_Apply(ModContext_Object *self, int op, PyObject *x, PyObject *y,
+                      const char *name)
+{
+    MPZ_Object *result = NULL;
+    mpz_srcptr px, py = NULL;
+    mpz_t tx, ty, temp;
+    size_t size;
+    int res;
+
+    mpz_inoc(tx);
+    mpz_inoc(ty);
+    mpz_inoc(temp);
+
+    if (!(px = GMPy_ModContext_Arg(self, x, tx, 1)) ||
+        (y && !(py = GMPy_ModContext_Arg(self, y, ty, op != GMPY_MODCTX_POWMOD)))) {
+        PyErr_Format(PyExc_TypeError, "%s requires integer arguments", name);
+        goto err;
+    }
+
+    if (!(result = GMPy_MPZ_New(NULL)))
+        goto err;
+
+    size = self->size * 2;
+    if (op == GMPY_MODCTX_POWMOD)
+        size = self->size * mpz_size(py);
+
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(size);
+    res = GMPy_ModContext_Op(self, op, result->z, px, py, temp);
+    GMPY_MAYBE_END_ALLOW_THREADS;
+
+    if (res < 0) {
+        GMPy_ModContext_OpError(op, name, -1);
+        Py_CLEAR(result);
+    }
+
+  err:
+    mpz_cloc(tx);
+    mpz_cloc(ty);
+    mpz_cloc(temp);
+    return (PyObject*)result;
+}
+
+/* Apply op element-wise. x must be an mpz_vector or an iterable of
+ * integers. For the binary operations, y can be an integer or an
+ * mpz_vector or iterable with the same length as x. The result is an
+ * mpz_vector if x is an mpz_vector and a list otherwise.
+ */
+
+static PyObject *
+GMPy_ModContext_Batch(ModContext_Object *self, int op, PyObject *x, PyObject *y,
+                      const char *name)
+{
+    MPZ_Vector_Object *vx = NULL, *vy = NULL, *result = NULL;
+    PyObject *list;
+    mpz_srcptr px, py = NULL;
+    mpz_t view, yview, tx, ty, r, temp;
+    Py_ssize_t i, n, bad = -1;
+    size_t size;
+
+    mpz_inoc(tx);
+    mpz_inoc(ty);
+    mpz_inoc(r);
+    mpz_inoc(temp);
+
+    if (!(vx = GMPy_MPZ_Vector_From_Iterable(x, name)))
+        goto err;
+    n = vx->length;
+
+    if (y) {
+        if (IS_INTEGER(y)) {
+            py = GMPy_ModContext_Arg(self, y, ty, op != GMPY_MODCTX_POWMOD);
+        }
+        else {
+            if (!(vy = GMPy_MPZ_Vector_From_Iterable(y, name)))
+                goto err;
+            if (vy->length != n) {
+                PyErr_Format(PyExc_ValueError,
+                             "%s requires arguments with the same length", name);
+                goto err;
+            }
+        }
+    }
+
+    /* Every result is less than m so the vector never needs to grow and
+     * GMPy_MPZ_Vector_Append() cannot fail.
+     */
+    if (!(result = GMPy_MPZ_Vector_New(n, n * self->size)))
+        goto err;
+
+    size = n * self->size;
+    if (op == GMPY_MODCTX_POWMOD)
+        size *= py ? mpz_size(py) : 1 + vy->limbs_used / (n ? n : 1);
+
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(size);
+    for (i = 0; i < n; i++) {
+        MPZ_VECTOR_VIEW(view, vx, i);
+        px = GMPy_ModContext_Reduce(self, view, tx);
+        if (vy) {
+            MPZ_VECTOR_VIEW(yview, vy, i);
+            py = (op == GMPY_MODCTX_POWMOD) ? yview : GMPy_ModContext_Reduce(self, yview, ty);
+        }
+        if (GMPy_ModContext_Op(self, op, r, px, py, temp) < 0) {
+            bad = i;
+            break;
+        }
+        GMPy_MPZ_Vector_Append(result, r);
+    }
+    GMPY_MAYBE_END_ALLOW_THREADS;
+
+    if (bad >= 0) {
+        GMPy_ModContext_OpError(op, name, bad);
+        goto err;
+    }
+
+    mpz_cloc(tx);
+    mpz_cloc(ty);
+    mpz_cloc(r);
+    mpz_cloc(temp);
+    Py_DECREF((PyObject*)vx);
+    Py_XDECREF((PyObject*)vy);
+
+    if (MPZ_Vector_Check(x))
+        return (PyObject*)result;
+
+    list = GMPy_MPZ_Vector_To_List(result);
+    Py_DECREF((PyObject*)result);
+    return list;
+
+  err:
+    mpz_cloc(tx);
+    mpz_cloc(ty);
+    mpz_cloc(r);
+    mpz_cloc(temp);
+    Py_XDECREF((PyObject*)vx);
+    Py_XDECREF((PyObject*)vy);
+    Py_XDECREF((PyObject*)result);
+    return NULL;
+}
+
+PyDoc_STRVAR(GMPy_doc_modcontext_method_reduce,
+"ctx.reduce(x) -> mpz\n\n"
+"Return x mod m.");
+
+static PyObject *
+GMPy_ModContext_Method_Reduce(PyObject *self, PyObject *other)
+{
+    ModContext_Object *ctx = (ModContext_Object*)self;
+    MPZ_Object *result;
+    mpz_srcptr px;
+    mpz_t temp;
+
+    mpz_inoc(temp);
+    if (!(px = GMPy_ModContext_Arg(ctx, other, temp, 1))) {
+        TYPE_ERROR("reduce() requires integer arguments");
+        mpz_cloc(temp);
+        return NULL;
+    }
+
+    if ((result = GMPy_MPZ_New(NULL)))
+        mpz_set(result->z, px);
+    mpz_cloc(temp);
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_modcontext_method_mulmod,
+"ctx.mulmod(x, y) -> mpz\n\n"
+"Return (x * y) mod m.");
+
+static PyObject *
+GMPy_ModContext_Method_MulMod(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    if (GMPY_NARGS != 2) {
+        TYPE_ERROR("mulmod() requires 2 arguments");
+        return NULL;
+    }
+    return GMPy_ModContext_Apply((ModContext_Object*)self, GMPY_MODCTX_MULMOD,
+                                 GMPY_ARG(0), GMPY_ARG(1), "mulmod()");
+}
+
+PyDoc_STRVAR(GMPy_doc_modcontext_method_sqrmod,
+"ctx.sqrmod(x) -> mpz\n\n"
+"Return (x * x) mod m.");
+
+static PyObject *
+GMPy_ModContext_Method_SqrMod(PyObject *self, PyObject *other)
+{
+    return GMPy_ModContext_Apply((ModContext_Object*)self, GMPY_MODCTX_SQRMOD,
+                                 other, NULL, "sqrmod()");
+}
+
+PyDoc_STRVAR(GMPy_doc_modcontext_method_powmod,
+"ctx.powmod(x, y) -> mpz\n\n"
+"Return (x ** y) mod m. If y is negative, x must be invertible.");
+
+static PyObject *
+GMPy_ModContext_Method_PowMod(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    if (GMPY_NARGS != 2) {
+        TYPE_ERROR("powmod() requires 2 arguments");
+        return NULL;
+    }
+    return GMPy_ModContext_Apply((ModContext_Object*)self, GMPY_MODCTX_POWMOD,
+                                 GMPY_ARG(0), GMPY_ARG(1), "powmod()");
+}
+
+PyDoc_STRVAR(GMPy_doc_modcontext_method_invert,
+"ctx.invert(x) -> mpz\n\n"
+"Return y such that (x * y) mod m == 1. Raises ZeroDivisionError if no\n"
+"inverse exists.");
+
+static PyObject *
+GMPy_ModContext_Method_Invert(PyObject *self, PyObject *other)
+{
+    return GMPy_ModContext_Apply((ModContext_Object*)self, GMPY_MODCTX_INVERT,
+                                 other, NULL, "invert()");
+}
+
+PyDoc_STRVAR(GMPy_doc_modcontext_method_batch_mulmod,
+"ctx.batch_mulmod(x, y) -> mpz_vector or list\n\n"
+"Return (x[i] * y[i]) mod m for each element of x. y can be an integer\n"
+"or a sequence with the same length as x.");
+
+static PyObject *
+GMPy_ModContext_Method_BatchMulMod(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    if (GMPY_NARGS != 2) {
+        TYPE_ERROR("batch_mulmod() requires 2 arguments");
+        return NULL;
+    }
+    return GMPy_ModContext_Batch((ModContext_Object*)self, GMPY_MODCTX_MULMOD,
+                                 GMPY_ARG(0), GMPY_ARG(1), "batch_mulmod()");
+}
+
+PyDoc_STRVAR(GMPy_doc_modcontext_method_batch_sqrmod,
+"ctx.batch_sqrmod(x) -> mpz_vector or list\n\n"
+"Return (x[i] * x[i]) mod m for each element of x.");
+
+static PyObject *
+GMPy_ModContext_Method_BatchSqrMod(PyObject *self, PyObject *other)
+{
+    return GMPy_ModContext_Batch((ModContext_Object*)self, GMPY_MODCTX_SQRMOD,
+                                 other, NULL, "batch_sqrmod()");
+}
+
+PyDoc_STRVAR(GMPy_doc_modcontext_method_batch_powmod,
+"ctx.batch_powmod(x, y) -> mpz_vector or list\n\n"
+"Return (x[i] ** y[i]) mod m for each element of x. y can be an integer\n"
+"or a sequence with the same length as x.");
+
+static PyObject *
+GMPy_ModContext_Method_BatchPowMod(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    if (GMPY_NARGS != 2) {
+        TYPE_ERROR("batch_powmod() requires 2 arguments");
+        return NULL;
+    }
+    return GMPy_ModContext_Batch((ModContext_Object*)self, GMPY_MODCTX_POWMOD,
+                                 GMPY_ARG(0), GMPY_ARG(1), "batch_powmod()");
+}
+
+PyDoc_STRVAR(GMPy_doc_modcontext_method_batch_invert,
+"ctx.batch_invert(x[, out]) -> mpz_vector or list\n\n"
+"Return the inverse modulo m of each element of x using Montgomery's\n"
+"trick. Raises ZeroDivisionError, including the index of the first\n"
+"element that is not invertible, if an inverse does not exist. If out\n"
+"is a list of xmpz, the inverses are stored in out.");
+
+static PyObject *
+GMPy_ModContext_Method_BatchInvert(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    if (GMPY_NARGS < 1 || GMPY_NARGS > 2) {
+        TYPE_ERROR("batch_invert() requires 1 or 2 arguments");
+        return NULL;
+    }
+    return GMPy_MPZ_BatchInvert(GMPY_ARG(0), ((ModContext_Object*)self)->m,
+                                GMPY_NARGS == 2 ? GMPY_ARG(1) : NULL,
+                                "batch_invert()");
+}
+
+static PyGetSetDef GMPy_ModContext_getseters[] =
+{
+    { "modulus", (getter)GMPy_ModContext_GetModulus_Attrib, NULL, "modulus", NULL },
+    {NULL}
+};
+
+static PyMethodDef GMPy_ModContext_methods[] =
+{
+    { "batch_invert", (PyCFunction)GMPy_ModContext_Method_BatchInvert, GMPY_METH_FASTCALL, GMPy_doc_modcontext_method_batch_invert },
+    { "batch_mulmod", (PyCFunction)GMPy_ModContext_Method_BatchMulMod, GMPY_METH_FASTCALL, GMPy_doc_modcontext_method_batch_mulmod },
+    { "batch_powmod", (PyCFunction)GMPy_ModContext_Method_BatchPowMod, GMPY_METH_FASTCALL, GMPy_doc_modcontext_method_batch_powmod },
+    { "batch_sqrmod", GMPy_ModContext_Method_BatchSqrMod, METH_O, GMPy_doc_modcontext_method_batch_sqrmod },
+    { "invert", GMPy_ModContext_Method_Invert, METH_O, GMPy_doc_modcontext_method_invert },
+    { "mulmod", (PyCFunction)GMPy_ModContext_Method_MulMod, GMPY_METH_FASTCALL, GMPy_doc_modcontext_method_mulmod },
+    { "powmod", (PyCFunction)GMPy_ModContext_Method_PowMod, GMPY_METH_FASTCALL, GMPy_doc_modcontext_method_powmod },
+    { "reduce", GMPy_ModContext_Method_Reduce, METH_O, GMPy_doc_modcontext_method_reduce },
+    { "sqrmod", GMPy_ModContext_Method_SqrMod, METH_O, GMPy_doc_modcontext_method_sqrmod },
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject ModContext_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                  /* ob_size          */
+#endif
+    "ModContext",                           /* tp_name          */
+    sizeof(ModContext_Object),              /* tp_basicsize     */
+        0,                                  /* tp_itemsize      */
+    (destructor) GMPy_ModContext_Dealloc,   /* tp_dealloc       */
+        0,                                  /* tp_print         */
+        0,                                  /* tp_getattr       */
+        0,                                  /* tp_setattr       */
+        0,                                  /* tp_reserved      */
+    (reprfunc) GMPy_ModContext_Repr_Slot,   /* tp_repr          */
+        0,                                  /* tp_as_number     */
+        0,                                  /* tp_as_sequence   */
+        0,                                  /* tp_as_mapping    */
+        0,                                  /* tp_hash          */
+        0,                                  /* tp_call          */
+        0,                                  /* tp_str           */
+        0,                                  /* tp_getattro      */
+        0,                                  /* tp_setattro      */
+        0,                                  /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                     /* tp_flags         */
+    "Context for arithmetic with a fixed modulus", /* tp_doc    */
+        0,                                  /* tp_traverse      */
+        0,                                  /* tp_clear         */
+        0,                                  /* tp_richcompare   */
+        0,                                  /* tp_weaklistoffset*/
+        0,                                  /* tp_iter          */
+        0,                                  /* tp_iternext      */
+    GMPy_ModContext_methods,                /* tp_methods       */
+        0,                                  /* tp_members       */
+    GMPy_ModContext_getseters,              /* tp_getset        */
+};
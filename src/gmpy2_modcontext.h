@@ -0,0 +1,65 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_modcontext.h                                                      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef GMPY_MODCONTEXT_H
+#define GMPY_MODCONTEXT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A ModContext stores a fixed positive modulus. All the values it returns
+ * are fully reduced, i.e. 0 <= value < modulus, and arguments that are
+ * already reduced are used without another reduction.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    mpz_t m;                /* the modulus, always positive */
+    size_t size;            /* size of the modulus in limbs */
+} ModContext_Object;
+
+static PyTypeObject ModContext_Type;
+#define ModContext_Check(v) (((PyObject*)v)->ob_type == &ModContext_Type)
+
+/* Operations supported by GMPy_ModContext_Op(). */
+
+#define GMPY_MODCTX_MULMOD  0
+#define GMPY_MODCTX_SQRMOD  1
+#define GMPY_MODCTX_POWMOD  2
+#define GMPY_MODCTX_INVERT  3
+
+static PyObject *  GMPy_ModContext_Factory(PyObject *self, GMPY_FASTCALL_ARGS);
+static mpz_srcptr  GMPy_ModContext_Reduce(ModContext_Object *self, mpz_srcptr x, mpz_ptr temp);
+static int         GMPy_ModContext_Op(ModContext_Object *self, int op, mpz_ptr r,
+                                      mpz_srcptr x, mpz_srcptr y, mpz_ptr temp);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -54,7 +54,7 @@ PyDoc_STRVAR(GMPy_doc_mpc_factory,
 "           precision + guard_bits.\n" );
 
 static PyObject *
-GMPy_MPC_Factory(PyObject *self, PyObject *args, PyObject *kwargs)
+GMPy_MPC_Factory(PyObject *self, GMPY_FASTCALL_KWARGS)
 {
     MPC_Object *result = NULL;
     MPFR_Object *tempreal = NULL, *tempimag = NULL;
@@ -77,10 +77,8 @@ GMPy_MPC_Factory(PyObject *self, PyObject *args, PyObject *kwargs)
         CHECK_CONTEXT(context);
     }
 
-    argc = PyTuple_Size(args);
-    if (kwargs) {
-        keywdc = PyDict_Size(kwargs);
-    }
+    argc = GMPY_NARGS;
+    keywdc = GMPY_NKWARGS;
 
     if (argc + keywdc > 3) {
         TYPE_ERROR("mpc() takes at most 3 arguments");
@@ -99,7 +97,7 @@ GMPy_MPC_Factory(PyObject *self, PyObject *args, PyObject *kwargs)
         return NULL;
     }
 
-    arg0 = PyTuple_GET_ITEM(args, 0);
+    arg0 = GMPY_ARG(0);
 
     /* If building an mpc from a string, there can be upto two additional
      * arguments. Note that precision can be either a single integer or
@@ -107,8 +105,8 @@ GMPy_MPC_Factory(PyObject *self, PyObject *args, PyObject *kwargs)
      */
     if (PyStrOrUnicode_Check(arg0)) {
         if (keywdc || argc > 1) {
-            if (!(PyArg_ParseTupleAndKeywords(args, kwargs, "O|Oi", kwlist_s,
-                                              &arg0, &prec, &base)))
+            if (!(GMPy_ParseArgsAndKeywords(GMPY_FASTCALL_PASS, "O|Oi", kwlist_s,
+                                            &arg0, &prec, &base)))
                 return NULL;
         }
 
@@ -147,8 +145,8 @@ GMPy_MPC_Factory(PyObject *self, PyObject *args, PyObject *kwargs)
 
     if (IS_REAL(arg0)) {
         if (keywdc || argc > 1) {
-            if (!(PyArg_ParseTupleAndKeywords(args, kwargs, "O|OO", kwlist_r,
-                                            &arg0, &arg1, &prec)))
+            if (!(GMPy_ParseArgsAndKeywords(GMPY_FASTCALL_PASS, "O|OO", kwlist_r,
+                                          &arg0, &arg1, &prec)))
                 return NULL;
         }
 
@@ -209,8 +207,8 @@ GMPy_MPC_Factory(PyObject *self, PyObject *args, PyObject *kwargs)
 
     if (IS_COMPLEX_ONLY(arg0)) {
         if (keywdc || argc > 1) {
-            if (!(PyArg_ParseTupleAndKeywords(args, kwargs, "O|O", kwlist_c,
-                                          &arg0, &prec)))
+            if (!(GMPy_ParseArgsAndKeywords(GMPY_FASTCALL_PASS, "O|O", kwlist_c,
+                                        &arg0, &prec)))
             return NULL;
         }
 
@@ -256,6 +254,7 @@ static PyMethodDef Pympc_methods[] =
 {
     { "__complex__", GMPy_PyComplex_From_MPC, METH_O, GMPy_doc_mpc_complex },
     { "__format__", GMPy_MPC_Format, METH_VARARGS, GMPy_doc_mpc_format },
+    { "__reduce_ex__", GMPy_MPANY_Reduce_Ex, METH_O, GMPy_doc_method_reduce_ex },
     { "__sizeof__", GMPy_MPC_SizeOf_Method, METH_NOARGS, GMPy_doc_mpc_sizeof_method },
     { "conjugate", GMPy_MPC_Conjugate_Method, METH_NOARGS, GMPy_doc_mpc_conjugate_method },
     { "digits", GMPy_MPC_Digits_Method, METH_VARARGS, GMPy_doc_mpc_digits_method },
@@ -46,16 +46,9 @@ extern "C" {
 #  pragma comment(lib,"mpc.lib")
 #endif
 
-typedef struct {
-    PyObject_HEAD
-    mpc_t c;
-    Py_hash_t hash_cache;
-    int rc;
-} MPC_Object;
+/* MPC_Object, MPC(), and MPC_Check() are defined in gmpy2_capi.h. */
 
 static PyTypeObject MPC_Type;
-#define MPC(obj) (((MPC_Object *)(obj))->c)
-#define MPC_Check(v) (((PyObject*)v)->ob_type == &MPC_Type)
 
 /*
  * Define macros for comparing with zero, checking if either component is
@@ -198,7 +191,7 @@ static PyTypeObject MPC_Type;
     GMPY_MPC_SUBNORMALIZE(V, CTX); \
     GMPY_MPC_EXCEPTIONS(V, CTX, NAME); \
 
-static PyObject * GMPy_MPC_Factory(PyObject *self, PyObject *args, PyObject *kwargs);
+static PyObject * GMPy_MPC_Factory(PyObject *self, GMPY_FASTCALL_KWARGS);
 
 #ifdef __cplusplus
 }
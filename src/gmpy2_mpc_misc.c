@@ -262,11 +262,11 @@ GMPy_Number_Rect(PyObject *x, PyObject *y, CTXT_Object *context)
 }
 
 static PyObject *
-GMPy_Context_Rect(PyObject *self, PyObject *args)
+GMPy_Context_Rect(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("rect() requires 2 arguments");
         return NULL;
     }
@@ -278,7 +278,7 @@ GMPy_Context_Rect(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Rect(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context);
+    return GMPy_Number_Rect(GMPY_ARG(0), GMPY_ARG(1), context);
 }
 
 PyDoc_STRVAR(GMPy_doc_context_proj,
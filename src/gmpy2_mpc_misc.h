@@ -46,7 +46,7 @@ static PyObject * GMPy_Context_Polar(PyObject *self, PyObject *other);
 
 static PyObject * GMPy_Complex_Rect(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Rect(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Rect(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Rect(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Complex_Proj(PyObject *x, CTXT_Object *context);
 static PyObject * GMPy_Number_Proj(PyObject *x, CTXT_Object *context);
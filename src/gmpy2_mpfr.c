@@ -52,7 +52,7 @@ PyDoc_STRVAR(GMPy_doc_mpfr_factory,
 "           precision + guard_bits.\n" );
 
 static PyObject *
-GMPy_MPFR_Factory(PyObject *self, PyObject *args, PyObject *keywds)
+GMPy_MPFR_Factory(PyObject *self, GMPY_FASTCALL_KWARGS)
 {
     MPFR_Object *result = NULL;
     PyObject *arg0 = NULL;
@@ -73,10 +73,8 @@ GMPy_MPFR_Factory(PyObject *self, PyObject *args, PyObject *keywds)
         CHECK_CONTEXT(context);
     }
 
-    argc = PyTuple_Size(args);
-    if (keywds) {
-        keywdc = PyDict_Size(keywds);
-    }
+    argc = GMPY_NARGS;
+    keywdc = GMPY_NKWARGS;
 
     if (argc + keywdc > 3) {
         TYPE_ERROR("mpfr() takes at most 3 arguments");
@@ -95,13 +93,13 @@ GMPy_MPFR_Factory(PyObject *self, PyObject *args, PyObject *keywds)
         return NULL;
     }
 
-    arg0 = PyTuple_GET_ITEM(args, 0);
+    arg0 = GMPY_ARG(0);
 
     /* A string can have both precision and base additional arguments. */
     if (PyStrOrUnicode_Check(arg0)) {
         if (keywdc || argc > 1) {
-            if (!(PyArg_ParseTupleAndKeywords(args, keywds, "O|li", kwlist_s,
-                                              &arg0, &prec, &base)))
+            if (!(GMPy_ParseArgsAndKeywords(GMPY_FASTCALL_PASS, "O|li", kwlist_s,
+                                            &arg0, &prec, &base)))
                 return NULL;
         }
 
@@ -121,8 +119,8 @@ GMPy_MPFR_Factory(PyObject *self, PyObject *args, PyObject *keywds)
     /* A number can only have precision additional argument. */
     if (IS_REAL(arg0)) {
         if (keywdc || argc > 1) {
-            if (!(PyArg_ParseTupleAndKeywords(args, keywds, "O|l", kwlist_n,
-                                              &arg0, &prec)))
+            if (!(GMPy_ParseArgsAndKeywords(GMPY_FASTCALL_PASS, "O|l", kwlist_n,
+                                            &arg0, &prec)))
                 return NULL;
         }
 
@@ -234,6 +232,7 @@ static PyMethodDef Pympfr_methods [] =
     { "__ceil__", GMPy_MPFR_Method_Ceil, METH_NOARGS, GMPy_doc_mpfr_ceil_method },
     { "__floor__", GMPy_MPFR_Method_Floor, METH_NOARGS, GMPy_doc_mpfr_floor_method },
     { "__format__", GMPy_MPFR_Format, METH_VARARGS, GMPy_doc_mpfr_format },
+    { "__reduce_ex__", GMPy_MPANY_Reduce_Ex, METH_O, GMPy_doc_method_reduce_ex },
     { "__round__", GMPy_MPFR_Method_Round10, METH_VARARGS, GMPy_doc_method_round10 },
     { "__sizeof__", GMPy_MPFR_SizeOf_Method, METH_NOARGS, GMPy_doc_mpfr_sizeof_method },
     { "__trunc__", GMPy_MPFR_Method_Trunc, METH_NOARGS, GMPy_doc_mpfr_trunc_method },
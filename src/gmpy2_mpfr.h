@@ -50,16 +50,9 @@ extern "C" {
 #  pragma comment(lib,"mpfr.lib")
 #endif
 
-typedef struct {
-    PyObject_HEAD
-    mpfr_t f;
-    Py_hash_t hash_cache;
-    int rc;
-} MPFR_Object;
+/* MPFR_Object, MPFR(), and MPFR_Check() are defined in gmpy2_capi.h. */
 
 static PyTypeObject MPFR_Type;
-#define MPFR(obj) (((MPFR_Object *)(obj))->f)
-#define MPFR_Check(v) (((PyObject*)v)->ob_type == &MPFR_Type)
 
 #define GMPY_DIVZERO(msg) PyErr_SetString(GMPyExc_DivZero, msg)
 #define GMPY_INEXACT(msg) PyErr_SetString(GMPyExc_Inexact, msg)
@@ -149,7 +142,7 @@ static PyTypeObject MPFR_Type;
         } \
     } \
 
-static PyObject * GMPy_MPFR_Factory(PyObject *self, PyObject *args, PyObject *keywds);
+static PyObject * GMPy_MPFR_Factory(PyObject *self, GMPY_FASTCALL_KWARGS);
 
 #ifdef __cplusplus
 }
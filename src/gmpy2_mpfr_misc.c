@@ -68,11 +68,11 @@ GMPy_Number_F2Q(PyObject *x, PyObject *y, CTXT_Object *context)
 }
 
 static PyObject *
-GMPy_Context_F2Q(PyObject *self, PyObject *args)
+GMPy_Context_F2Q(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) < 1 || PyTuple_GET_SIZE(args) > 2) {
+    if (GMPY_NARGS < 1 || GMPY_NARGS > 2) {
         TYPE_ERROR("f2q() requires 1 or 2 arguments");
         return NULL;
     }
@@ -84,11 +84,11 @@ GMPy_Context_F2Q(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    if (PyTuple_GET_SIZE(args) == 1) {
-        return GMPy_Number_F2Q(PyTuple_GET_ITEM(args, 0), NULL, context);
+    if (GMPY_NARGS == 1) {
+        return GMPy_Number_F2Q(GMPY_ARG(0), NULL, context);
     }
     else {
-        return GMPy_Number_F2Q(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context);
+        return GMPy_Number_F2Q(GMPY_ARG(0), GMPY_ARG(1), context);
     }
 }
 
@@ -225,7 +225,7 @@ PyDoc_STRVAR(GMPy_doc_mpfr_set_exp,
 "is set.");
 
 static PyObject *
-GMPy_MPFR_set_exp(PyObject *self, PyObject *args)
+GMPy_MPFR_set_exp(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPFR_Object *result;
     PyObject *temp;
@@ -234,15 +234,15 @@ GMPy_MPFR_set_exp(PyObject *self, PyObject *args)
 
     CHECK_CONTEXT(context);
 
-    if (PyTuple_GET_SIZE(args) != 2 ||
-        !MPFR_Check(PyTuple_GET_ITEM(args, 0)) ||
-        !PyIntOrLong_Check(PyTuple_GET_ITEM(args, 1))) {
+    if (GMPY_NARGS != 2 ||
+        !MPFR_Check(GMPY_ARG(0)) ||
+        !PyIntOrLong_Check(GMPY_ARG(1))) {
         TYPE_ERROR("set_exp() requires 'mpfr', 'integer' arguments");
         return NULL;
     }
 
-    temp = PyTuple_GET_ITEM(args, 0);
-    exp = (mpfr_exp_t)PyIntOrLong_AsLong(PyTuple_GET_ITEM(args, 1));
+    temp = GMPY_ARG(0);
+    exp = (mpfr_exp_t)PyIntOrLong_AsLong(GMPY_ARG(1));
     if (exp == -1 && PyErr_Occurred()) {
         VALUE_ERROR("exponent too large");
         return NULL;
@@ -280,16 +280,16 @@ PyDoc_STRVAR(GMPy_doc_mpfr_set_sign,
 "If 'bool' is True, then return an 'mpfr' with the sign bit set.");
 
 static PyObject *
-GMPy_MPFR_set_sign(PyObject *self, PyObject *args)
+GMPy_MPFR_set_sign(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPFR_Object *result;
     CTXT_Object *context = NULL;
 
     CHECK_CONTEXT(context);
 
-    if (PyTuple_GET_SIZE(args) != 2 ||
-        !MPFR_Check(PyTuple_GET_ITEM(args, 0)) ||
-        !PyIntOrLong_Check(PyTuple_GET_ITEM(args, 1))) {
+    if (GMPY_NARGS != 2 ||
+        !MPFR_Check(GMPY_ARG(0)) ||
+        !PyIntOrLong_Check(GMPY_ARG(1))) {
         TYPE_ERROR("set_sign() requires 'mpfr', 'boolean' arguments");
         return NULL;
     }
@@ -298,8 +298,8 @@ GMPy_MPFR_set_sign(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    result->rc = mpfr_setsign(MPFR(result), MPFR(PyTuple_GET_ITEM(args, 0)),
-                              PyObject_IsTrue(PyTuple_GET_ITEM(args, 1)),
+    result->rc = mpfr_setsign(MPFR(result), MPFR(GMPY_ARG(0)),
+                              PyObject_IsTrue(GMPY_ARG(1)),
                               GET_MPFR_ROUND(context));
 
     return (PyObject*)result;
@@ -311,16 +311,16 @@ PyDoc_STRVAR(GMPy_doc_mpfr_copy_sign,
 "second argument.");
 
 static PyObject *
-GMPy_MPFR_copy_sign(PyObject *self, PyObject *args)
+GMPy_MPFR_copy_sign(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPFR_Object *result;
     CTXT_Object *context = NULL;
 
     CHECK_CONTEXT(context);
 
-    if (PyTuple_GET_SIZE(args) != 2 ||
-        !MPFR_Check(PyTuple_GET_ITEM(args, 0)) ||
-        !MPFR_Check(PyTuple_GET_ITEM(args, 1))) {
+    if (GMPY_NARGS != 2 ||
+        !MPFR_Check(GMPY_ARG(0)) ||
+        !MPFR_Check(GMPY_ARG(1))) {
         TYPE_ERROR("copy_sign() requires 'mpfr', 'boolean' arguments");
         return NULL;
     }
@@ -329,8 +329,8 @@ GMPy_MPFR_copy_sign(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    result->rc = mpfr_copysign(MPFR(result), MPFR(PyTuple_GET_ITEM(args, 0)),
-                               MPFR(PyTuple_GET_ITEM(args, 1)),
+    result->rc = mpfr_copysign(MPFR(result), MPFR(GMPY_ARG(0)),
+                               MPFR(GMPY_ARG(1)),
                                GET_MPFR_ROUND(context));
 
     return (PyObject*)result;
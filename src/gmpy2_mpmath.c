@@ -65,7 +65,7 @@ PyDoc_STRVAR(doc_mpmath_normalizeg,
 "_mpmath_normalize(...): helper function for mpmath.");
 
 static PyObject *
-Pympz_mpmath_normalize(PyObject *self, PyObject *args)
+Pympz_mpmath_normalize(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     long sign = 0;
     long bc = 0, prec = 0, shift, zbits, carry = 0;
@@ -74,15 +74,15 @@ Pympz_mpmath_normalize(PyObject *self, PyObject *args)
     char rnd = 0;
     int err1, err2, err3;
 
-    if (PyTuple_GET_SIZE(args) == 6) {
+    if (GMPY_NARGS == 6) {
         /* Need better error-checking here. Under Python 3.0, overflow into
            C-long is possible. */
-        sign = GMPy_Integer_AsLongAndError(PyTuple_GET_ITEM(args, 0), &err1);
-        man = (MPZ_Object *)PyTuple_GET_ITEM(args, 1);
-        exp = PyTuple_GET_ITEM(args, 2);
-        bc = GMPy_Integer_AsLongAndError(PyTuple_GET_ITEM(args, 3), &err2);
-        prec = GMPy_Integer_AsLongAndError(PyTuple_GET_ITEM(args, 4), &err3);
-        rndstr = PyTuple_GET_ITEM(args, 5);
+        sign = GMPy_Integer_AsLongAndError(GMPY_ARG(0), &err1);
+        man = (MPZ_Object *)GMPY_ARG(1);
+        exp = GMPY_ARG(2);
+        bc = GMPy_Integer_AsLongAndError(GMPY_ARG(3), &err2);
+        prec = GMPy_Integer_AsLongAndError(GMPY_ARG(4), &err3);
+        rndstr = GMPY_ARG(5);
         if (err1 || err2 || err3) {
             TYPE_ERROR("arguments long, MPZ_Object*, PyObject*, long, long, char needed");
             return NULL;
@@ -226,7 +226,7 @@ PyDoc_STRVAR(doc_mpmath_createg,
 "_mpmath_create(...): helper function for mpmath.");
 
 static PyObject *
-Pympz_mpmath_create(PyObject *self, PyObject *args)
+Pympz_mpmath_create(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     long sign;
     long bc, shift, zbits, carry = 0, prec = 0;
@@ -236,23 +236,23 @@ Pympz_mpmath_create(PyObject *self, PyObject *args)
 
     const char *rnd = "f";
 
-    if (PyTuple_GET_SIZE(args) < 2) {
+    if (GMPY_NARGS < 2) {
         TYPE_ERROR("mpmath_create() expects 'mpz','int'[,'int','str'] arguments");
         return NULL;
     }
 
-    switch (PyTuple_GET_SIZE(args)) {
+    switch (GMPY_NARGS) {
         case 4:
-            rnd = Py2or3String_AsString(PyTuple_GET_ITEM(args, 3));
+            rnd = Py2or3String_AsString(GMPY_ARG(3));
         case 3:
-            prec = GMPy_Integer_AsLongAndError(PyTuple_GET_ITEM(args, 2), &error);
+            prec = GMPy_Integer_AsLongAndError(GMPY_ARG(2), &error);
             if (error)
                 return NULL;
             prec = ABS(prec);
         case 2:
-            exp = PyTuple_GET_ITEM(args, 1);
+            exp = GMPY_ARG(1);
         case 1:
-            man = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+            man = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
             if (!man) {
                 TYPE_ERROR("mpmath_create() expects 'mpz','int'[,'int','str'] arguments");
                 return NULL;
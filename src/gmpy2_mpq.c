@@ -39,7 +39,7 @@ PyDoc_STRVAR(GMPy_doc_mpq_factory,
 "     base separated by a '/' character.\n");
 
 static PyObject *
-GMPy_MPQ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
+GMPy_MPQ_Factory(PyObject *self, GMPY_FASTCALL_KWARGS)
 {
     MPQ_Object *result, *temp;
     PyObject *n, *m;
@@ -55,10 +55,8 @@ GMPy_MPQ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
         CHECK_CONTEXT(context);
     }
 
-    argc = PyTuple_Size(args);
-    if (keywds) {
-        keywdc = PyDict_Size(keywds);
-    }
+    argc = GMPY_NARGS;
+    keywdc = GMPY_NKWARGS;
 
     if (argc + keywdc > 2) {
         TYPE_ERROR("mpq() takes at most 2 arguments");
@@ -77,13 +75,13 @@ GMPy_MPQ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
         return NULL;
     }
 
-    n = PyTuple_GetItem(args, 0);
+    n = GMPY_ARG(0);
     
     /* Handle the case where the first argument is a string. */
     if (PyStrOrUnicode_Check(n)) {
         /* keyword base is legal */
         if (keywdc || argc > 1) {
-            if (!(PyArg_ParseTupleAndKeywords(args, keywds, "O|i", kwlist, &n, &base))) {
+            if (!(GMPy_ParseArgsAndKeywords(GMPY_FASTCALL_PASS, "O|i", kwlist, &n, &base))) {
                 return NULL;
             }
         }
@@ -105,7 +103,7 @@ GMPy_MPQ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
 
     /* Handle 2 arguments. Both arguments must be integer or rational. */
     if (argc == 2) {
-        m = PyTuple_GetItem(args, 1);
+        m = GMPY_ARG(1);
 
         if (IS_RATIONAL(n) && IS_RATIONAL(m)) {
            result = GMPy_MPQ_From_Rational(n, context);
@@ -226,6 +224,7 @@ static PyMethodDef GMPy_MPQ_methods [] =
 {
     { "__ceil__", GMPy_MPQ_Method_Ceil, METH_NOARGS, GMPy_doc_mpq_method_ceil },
     { "__floor__", GMPy_MPQ_Method_Floor, METH_NOARGS, GMPy_doc_mpq_method_floor },
+    { "__reduce_ex__", GMPy_MPANY_Reduce_Ex, METH_O, GMPy_doc_method_reduce_ex },
     { "__round__", GMPy_MPQ_Method_Round, METH_VARARGS, GMPy_doc_mpq_method_round },
     { "__sizeof__", GMPy_MPQ_Method_Sizeof, METH_NOARGS, GMPy_doc_mpq_method_sizeof },
     { "__trunc__", GMPy_MPQ_Method_Trunc, METH_NOARGS, GMPy_doc_mpq_method_trunc },
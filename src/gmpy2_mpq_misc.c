@@ -101,7 +101,7 @@ PyDoc_STRVAR(GMPy_doc_function_qdiv,
 "divisible by y.");
 
 static PyObject *
-GMPy_MPQ_Function_Qdiv(PyObject *self, PyObject *args)
+GMPy_MPQ_Function_Qdiv(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     Py_ssize_t argc;
     int isOne = 0;
@@ -113,17 +113,17 @@ GMPy_MPQ_Function_Qdiv(PyObject *self, PyObject *args)
 
     /* Validate the argument(s). */
 
-    argc = PyTuple_GET_SIZE(args);
+    argc = GMPY_NARGS;
     if (argc == 1) {
-        x = PyTuple_GET_ITEM(args, 0);
+        x = GMPY_ARG(0);
         isOne = 1;
         if (!IS_RATIONAL(x)) {
             goto arg_error;
         }
     }
     else if (argc == 2) {
-        x = PyTuple_GET_ITEM(args, 0);
-        y = PyTuple_GET_ITEM(args, 1);
+        x = GMPY_ARG(0);
+        y = GMPY_ARG(1);
         if (!IS_RATIONAL(x) || !IS_RATIONAL(y)) {
             goto arg_error;
         }
@@ -40,7 +40,7 @@ PyDoc_STRVAR(GMPy_doc_mpz_factory,
 "     between 2 and 62.");
 
 static PyObject *
-GMPy_MPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
+GMPy_MPZ_Factory(PyObject *self, GMPY_FASTCALL_KWARGS)
 {
     MPZ_Object *result = NULL;
     PyObject *n;
@@ -53,17 +53,14 @@ GMPy_MPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
     
     /* Optimize the most common use cases first; either 0 or 1 argument */
     
-    argc = PyTuple_GET_SIZE(args);
+    argc = GMPY_NARGS;
     
     if (argc == 0) {
-        if ((result = GMPy_MPZ_New(context))) {
-            mpz_set_ui(result->z, 0);
-        }
-        return (PyObject*)result;
+        return (PyObject*)GMPy_MPZ_From_SI(0, context);
     }
 
-    if (argc == 1 && !keywds) {
-        n = PyTuple_GET_ITEM(args, 0);
+    if (argc == 1 && !GMPY_NKWARGS) {
+        n = GMPY_ARG(0);
         if (IS_REAL(n)) {
             result = GMPy_MPZ_From_Number(n, context);
         }
@@ -76,7 +73,7 @@ GMPy_MPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
         return (PyObject*)result;
     }
 
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|i", kwlist, &n, &base)) {
+    if (!GMPy_ParseArgsAndKeywords(GMPY_FASTCALL_PASS, "O|i", kwlist, &n, &base)) {
         return NULL;
     }
 
@@ -187,6 +184,17 @@ static PyMappingMethods GMPy_MPZ_mapping_methods = {
     NULL
 };
 
+static PyBufferProcs GMPy_MPZ_buffer_methods = {
+#ifdef PY2
+        0,                                  /* bf_getreadbuffer  */
+        0,                                  /* bf_getwritebuffer */
+        0,                                  /* bf_getsegcount    */
+        0,                                  /* bf_getcharbuffer  */
+#endif
+    (getbufferproc) GMPy_MPZ_GetBuffer,     /* bf_getbuffer      */
+    (releasebufferproc) GMPy_MPZ_ReleaseBuffer, /* bf_releasebuffer */
+};
+
 static PyGetSetDef GMPy_MPZ_getseters[] =
 {
     { "numerator", (getter)GMPy_MPZ_Attrib_GetNumer, NULL, "numerator", NULL },
@@ -199,20 +207,22 @@ static PyMethodDef GMPy_MPZ_methods [] =
     { "__format__", GMPy_MPZ_Format, METH_VARARGS, GMPy_doc_mpz_format },
     { "__ceil__", GMPy_MPZ_Method_Ceil, METH_NOARGS, GMPy_doc_mpz_method_ceil },
     { "__floor__", GMPy_MPZ_Method_Floor, METH_NOARGS, GMPy_doc_mpz_method_floor },
-    { "__round__", GMPy_MPZ_Method_Round, METH_VARARGS, GMPy_doc_mpz_method_round },
+    { "__reduce_ex__", GMPy_MPANY_Reduce_Ex, METH_O, GMPy_doc_method_reduce_ex },
+    { "__round__", (PyCFunction)GMPy_MPZ_Method_Round, GMPY_METH_FASTCALL, GMPy_doc_mpz_method_round },
     { "__sizeof__", GMPy_MPZ_Method_SizeOf, METH_NOARGS, GMPy_doc_mpz_method_sizeof },
     { "__trunc__", GMPy_MPZ_Method_Trunc, METH_NOARGS, GMPy_doc_mpz_method_trunc },
     { "bit_clear", GMPy_MPZ_bit_clear_method, METH_O, doc_bit_clear_method },
     { "bit_flip", GMPy_MPZ_bit_flip_method, METH_O, doc_bit_flip_method },
     { "bit_length", GMPy_MPZ_bit_length_method, METH_NOARGS, doc_bit_length_method },
-    { "bit_scan0", GMPy_MPZ_bit_scan0_method, METH_VARARGS, doc_bit_scan0_method },
-    { "bit_scan1", GMPy_MPZ_bit_scan1_method, METH_VARARGS, doc_bit_scan1_method },
+    { "bit_scan0", (PyCFunction)GMPy_MPZ_bit_scan0_method, GMPY_METH_FASTCALL, doc_bit_scan0_method },
+    { "bit_scan1", (PyCFunction)GMPy_MPZ_bit_scan1_method, GMPY_METH_FASTCALL, doc_bit_scan1_method },
     { "bit_set", GMPy_MPZ_bit_set_method, METH_O, doc_bit_set_method },
     { "bit_test", GMPy_MPZ_bit_test_method, METH_O, doc_bit_test_method },
     { "digits", GMPy_MPZ_Digits_Method, METH_VARARGS, GMPy_doc_mpz_digits_method },
-    { "is_congruent", GMPy_MPZ_Method_IsCongruent, METH_VARARGS, GMPy_doc_mpz_method_is_congruent },
+    { "is_congruent", (PyCFunction)GMPy_MPZ_Method_IsCongruent, GMPY_METH_FASTCALL, GMPy_doc_mpz_method_is_congruent },
     { "is_divisible", GMPy_MPZ_Method_IsDivisible, METH_O, GMPy_doc_mpz_method_is_divisible },
-    { "num_digits", GMPy_MPZ_Method_NumDigits, METH_VARARGS, GMPy_doc_mpz_method_num_digits },
+    { "limbs", GMPy_MPZ_Method_Limbs, METH_NOARGS, GMPy_doc_mpz_method_limbs },
+    { "num_digits", (PyCFunction)GMPy_MPZ_Method_NumDigits, GMPY_METH_FASTCALL, GMPy_doc_mpz_method_num_digits },
     { NULL, NULL, 1 }
 };
 
@@ -243,13 +253,13 @@ static PyTypeObject MPZ_Type =
     (reprfunc) GMPy_MPZ_Str_Slot,           /* tp_str           */
         0,                                  /* tp_getattro      */
         0,                                  /* tp_setattro      */
-        0,                                  /* tp_as_buffer     */
+    &GMPy_MPZ_buffer_methods,               /* tp_as_buffer     */
 #ifdef PY3
     Py_TPFLAGS_DEFAULT,                     /* tp_flags         */
 #else
     Py_TPFLAGS_HAVE_INDEX|Py_TPFLAGS_HAVE_RICHCOMPARE| \
     Py_TPFLAGS_CHECKTYPES|Py_TPFLAGS_HAVE_CLASS| \
-    Py_TPFLAGS_HAVE_INPLACEOPS,
+    Py_TPFLAGS_HAVE_INPLACEOPS|Py_TPFLAGS_HAVE_NEWBUFFER,
 #endif
     "Multiple precision integer",           /* tp_doc           */
         0,                                  /* tp_traverse      */
@@ -32,17 +32,11 @@
 extern "C" {
 #endif
 
-typedef struct {
-    PyObject_HEAD
-    mpz_t z;
-    Py_hash_t hash_cache;
-} MPZ_Object;
+/* MPZ_Object, MPZ(), and MPZ_Check() are defined in gmpy2_capi.h. */
 
 static PyTypeObject MPZ_Type;
-#define MPZ(obj) (((MPZ_Object*)(obj))->z)
-#define MPZ_Check(v) (((PyObject*)v)->ob_type == &MPZ_Type)
 
-static PyObject * GMPy_MPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds);
+static PyObject * GMPy_MPZ_Factory(PyObject *self, GMPY_FASTCALL_KWARGS);
 
 #ifdef __cplusplus
 }
@@ -97,12 +97,12 @@ PyDoc_STRVAR(doc_bit_scan0_method,
 "format), then None is returned.");
 
 static PyObject *
-GMPy_MPZ_bit_scan0_method(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_scan0_method(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t index, starting_bit = 0;
 
-    if (PyTuple_GET_SIZE(args) == 1) {
-        starting_bit = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 0));
+    if (GMPY_NARGS == 1) {
+        starting_bit = mp_bitcnt_t_From_Integer(GMPY_ARG(0));
         if (starting_bit == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
             return NULL;
         }
@@ -126,21 +126,21 @@ PyDoc_STRVAR(doc_bit_scan0_function,
 "format), then None is returned.");
 
 static PyObject *
-GMPy_MPZ_bit_scan0_function(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_scan0_function(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t index, starting_bit = 0;
     MPZ_Object *tempx = NULL;
 
-    if (PyTuple_GET_SIZE(args) == 0 || PyTuple_GET_SIZE(args) > 2) {
+    if (GMPY_NARGS == 0 || GMPY_NARGS > 2) {
         goto err;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL))) {
         goto err;
     }
 
-    if (PyTuple_GET_SIZE(args) == 2) {
-        starting_bit = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    if (GMPY_NARGS == 2) {
+        starting_bit = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
         if (starting_bit == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
             goto err_index;
         }
@@ -171,12 +171,12 @@ PyDoc_STRVAR(doc_bit_scan1_method,
 "format), then None is returned.");
 
 static PyObject *
-GMPy_MPZ_bit_scan1_method(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_scan1_method(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t index, starting_bit = 0;
 
-    if (PyTuple_GET_SIZE(args) == 1) {
-        starting_bit = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 0));
+    if (GMPY_NARGS == 1) {
+        starting_bit = mp_bitcnt_t_From_Integer(GMPY_ARG(0));
         if (starting_bit == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
             return NULL;
         }
@@ -200,21 +200,21 @@ PyDoc_STRVAR(doc_bit_scan1_function,
 "format), then None is returned.");
 
 static PyObject *
-GMPy_MPZ_bit_scan1_function(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_scan1_function(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t index, starting_bit = 0;
     MPZ_Object *tempx = NULL;
 
-    if (PyTuple_GET_SIZE(args) == 0 || PyTuple_GET_SIZE(args) > 2) {
+    if (GMPY_NARGS == 0 || GMPY_NARGS > 2) {
         goto err;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL))) {
         goto err;
     }
 
-    if (PyTuple_GET_SIZE(args) == 2) {
-        starting_bit = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    if (GMPY_NARGS == 2) {
+        starting_bit = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
         if (starting_bit == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
             goto err_index;
         }
@@ -243,21 +243,21 @@ PyDoc_STRVAR(doc_bit_test_function,
 "Return the value of the n-th bit of x.");
 
 static PyObject *
-GMPy_MPZ_bit_test_function(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_test_function(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t bit_index;
     int temp;
     MPZ_Object *tempx = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         goto err;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL))) {
         goto err;
     }
 
-    bit_index = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    bit_index = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (bit_index == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         goto err_index;
     }
@@ -302,21 +302,21 @@ PyDoc_STRVAR(doc_bit_clear_function,
 "Return a copy of x with the n-th bit cleared.");
 
 static PyObject *
-GMPy_MPZ_bit_clear_function(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_clear_function(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t bit_index;
     MPZ_Object *result = NULL, *tempx = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2)
+    if (GMPY_NARGS != 2)
         goto err;
 
     if (!(result = GMPy_MPZ_New(NULL)))
         return NULL;
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL)))
+    if (!(tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL)))
         goto err;
 
-    bit_index = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    bit_index = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (bit_index == (mp_bitcnt_t)(-1) && PyErr_Occurred())
         goto err_index;
 
@@ -361,21 +361,21 @@ PyDoc_STRVAR(doc_bit_set_function,
 "Return a copy of x with the n-th bit set.");
 
 static PyObject *
-GMPy_MPZ_bit_set_function(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_set_function(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t bit_index;
     MPZ_Object *result = NULL, *tempx = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2)
+    if (GMPY_NARGS != 2)
         goto err;
 
     if (!(result = GMPy_MPZ_New(NULL)))
         return NULL;
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL)))
+    if (!(tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL)))
         goto err;
 
-    bit_index = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    bit_index = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (bit_index == (mp_bitcnt_t)(-1) && PyErr_Occurred())
         goto err_index;
 
@@ -420,21 +420,21 @@ PyDoc_STRVAR(doc_bit_flip_function,
 "Return a copy of x with the n-th bit inverted.");
 
 static PyObject *
-GMPy_MPZ_bit_flip_function(PyObject *self, PyObject *args)
+GMPy_MPZ_bit_flip_function(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t bit_index;
     MPZ_Object *result = NULL, *tempx = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2)
+    if (GMPY_NARGS != 2)
         goto err;
 
     if (!(result = GMPy_MPZ_New(NULL)))
         return NULL;
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL)))
+    if (!(tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL)))
         goto err;
 
-    bit_index = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    bit_index = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (bit_index == (mp_bitcnt_t)(-1) && PyErr_Occurred())
         goto err_index;
 
@@ -485,7 +485,7 @@ GMPy_MPZ_Invert_Slot(MPZ_Object *self)
 static PyObject *
 GMPy_MPZ_And_Slot(PyObject *self, PyObject *other)
 {
-    MPZ_Object *result;
+    MPZ_Object *result, *tempx;
 
     if (CHECK_MPZANY(self)) {
         if (CHECK_MPZANY(other)) {
@@ -494,15 +494,19 @@ GMPy_MPZ_And_Slot(PyObject *self, PyObject *other)
             mpz_and(result->z, MPZ(self), MPZ(other));
         }
         else {
-            if (!(result = GMPy_MPZ_From_Integer(other, NULL)))
+            if (!(tempx = GMPy_MPZ_From_Integer(other, NULL)))
                 return NULL;
-            mpz_and(result->z, MPZ(self), result->z);
+            if ((result = GMPy_MPZ_New(NULL)))
+                mpz_and(result->z, MPZ(self), tempx->z);
+            Py_DECREF((PyObject*)tempx);
         }
     }
     else if (CHECK_MPZANY(other)) {
-        if (!(result = GMPy_MPZ_From_Integer(self, NULL)))
+        if (!(tempx = GMPy_MPZ_From_Integer(self, NULL)))
             return NULL;
-        mpz_and(result->z, result->z, MPZ(other));
+        if ((result = GMPy_MPZ_New(NULL)))
+            mpz_and(result->z, tempx->z, MPZ(other));
+        Py_DECREF((PyObject*)tempx);
     }
     else {
         Py_RETURN_NOTIMPLEMENTED;
@@ -513,7 +517,7 @@ GMPy_MPZ_And_Slot(PyObject *self, PyObject *other)
 static PyObject *
 GMPy_MPZ_Ior_Slot(PyObject *self, PyObject *other)
 {
-    MPZ_Object *result;
+    MPZ_Object *result, *tempx;
 
     if (CHECK_MPZANY(self)) {
         if (CHECK_MPZANY(other)) {
@@ -522,15 +526,19 @@ GMPy_MPZ_Ior_Slot(PyObject *self, PyObject *other)
             mpz_ior(result->z, MPZ(self), MPZ(other));
         }
         else {
-            if (!(result = GMPy_MPZ_From_Integer(other, NULL)))
+            if (!(tempx = GMPy_MPZ_From_Integer(other, NULL)))
                 return NULL;
-            mpz_ior(result->z, MPZ(self), result->z);
+            if ((result = GMPy_MPZ_New(NULL)))
+                mpz_ior(result->z, MPZ(self), tempx->z);
+            Py_DECREF((PyObject*)tempx);
         }
     }
     else if (CHECK_MPZANY(other)) {
-        if (!(result = GMPy_MPZ_From_Integer(self, NULL)))
+        if (!(tempx = GMPy_MPZ_From_Integer(self, NULL)))
             return NULL;
-        mpz_ior(result->z, result->z, MPZ(other));
+        if ((result = GMPy_MPZ_New(NULL)))
+            mpz_ior(result->z, tempx->z, MPZ(other));
+        Py_DECREF((PyObject*)tempx);
     }
     else {
         Py_RETURN_NOTIMPLEMENTED;
@@ -541,7 +549,7 @@ GMPy_MPZ_Ior_Slot(PyObject *self, PyObject *other)
 static PyObject *
 GMPy_MPZ_Xor_Slot(PyObject *self, PyObject *other)
 {
-    MPZ_Object *result;
+    MPZ_Object *result, *tempx;
 
     if (CHECK_MPZANY(self)) {
         if (CHECK_MPZANY(other)) {
@@ -550,15 +558,19 @@ GMPy_MPZ_Xor_Slot(PyObject *self, PyObject *other)
             mpz_xor(result->z, MPZ(self), MPZ(other));
         }
         else {
-            if (!(result = GMPy_MPZ_From_Integer(other, NULL)))
+            if (!(tempx = GMPy_MPZ_From_Integer(other, NULL)))
                 return NULL;
-            mpz_xor(result->z, MPZ(self), result->z);
+            if ((result = GMPy_MPZ_New(NULL)))
+                mpz_xor(result->z, MPZ(self), tempx->z);
+            Py_DECREF((PyObject*)tempx);
         }
     }
     else if (CHECK_MPZANY(other)) {
-        if (!(result = GMPy_MPZ_From_Integer(self, NULL)))
+        if (!(tempx = GMPy_MPZ_From_Integer(self, NULL)))
             return NULL;
-        mpz_xor(result->z, result->z, MPZ(other));
+        if ((result = GMPy_MPZ_New(NULL)))
+            mpz_xor(result->z, tempx->z, MPZ(other));
+        Py_DECREF((PyObject*)tempx);
     }
     else {
         Py_RETURN_NOTIMPLEMENTED;
@@ -657,16 +669,16 @@ PyDoc_STRVAR(doc_hamdist,
 "bits differ) between integers x and y.");
 
 static PyObject *
-GMPy_MPZ_hamdist(PyObject *self, PyObject *args)
+GMPy_MPZ_hamdist(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     PyObject *result = NULL;
     MPZ_Object *tempx = NULL, *tempy = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2)
+    if (GMPY_NARGS != 2)
         goto err;
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     if (!tempx || !tempy)
         goto err;
 
@@ -35,22 +35,22 @@ extern "C" {
 static PyObject * GMPy_MPZ_bit_length_function(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_bit_length_method(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_bit_mask(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_bit_scan0_function(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_bit_scan0_method(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_bit_scan1_function(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_bit_scan1_method(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_bit_scan0_function(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_bit_scan0_method(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_bit_scan1_function(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_bit_scan1_method(PyObject *self, GMPY_FASTCALL_ARGS);
 
-static PyObject * GMPy_MPZ_bit_test_function(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_bit_test_function(PyObject *self, GMPY_FASTCALL_ARGS);
 static PyObject * GMPy_MPZ_bit_test_method(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_bit_clear_function(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_bit_clear_function(PyObject *self, GMPY_FASTCALL_ARGS);
 static PyObject * GMPy_MPZ_bit_clear_method(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_bit_set_function(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_bit_set_function(PyObject *self, GMPY_FASTCALL_ARGS);
 static PyObject * GMPy_MPZ_bit_set_method(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_bit_flip_function(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_bit_flip_function(PyObject *self, GMPY_FASTCALL_ARGS);
 static PyObject * GMPy_MPZ_bit_flip_method(PyObject *self, PyObject *other);
 
 static PyObject * GMPy_MPZ_popcount(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_hamdist(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_hamdist(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_MPZ_Invert_Slot(MPZ_Object *self);
 static PyObject * GMPy_MPZ_And_Slot(PyObject *self, PyObject *other);
@@ -41,18 +41,18 @@ PyDoc_STRVAR(doc_c_divmod,
 "have the opposite sign of y. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_c_divmod(PyObject *self, PyObject *args)
+GMPy_MPZ_c_divmod(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     PyObject *result;
     MPZ_Object *q, *r, *tempx, *tempy;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("c_divmod() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     q = GMPy_MPZ_New(NULL);
     r = GMPy_MPZ_New(NULL);
     result = PyTuple_New(2);
@@ -64,7 +64,9 @@ GMPy_MPZ_c_divmod(PyObject *self, PyObject *args)
         goto err;
     }
 
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z) + mpz_size(tempy->z));
     mpz_cdiv_qr(q->z, r->z, tempx->z, tempy->z);
+    GMPY_MAYBE_END_ALLOW_THREADS;
 
     Py_DECREF((PyObject*)tempx);
     Py_DECREF((PyObject*)tempy);
@@ -87,17 +89,17 @@ PyDoc_STRVAR(doc_c_div,
 "towards +Inf (ceiling rounding). x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_c_div(PyObject *self, PyObject *args)
+GMPy_MPZ_c_div(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *q, *tempx, *tempy;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("c_div() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     q = GMPy_MPZ_New(NULL);
     if (!tempx || !tempy || !q)
         goto err;
@@ -107,7 +109,9 @@ GMPy_MPZ_c_div(PyObject *self, PyObject *args)
         goto err;
     }
 
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z) + mpz_size(tempy->z));
     mpz_cdiv_q(q->z, tempx->z, tempy->z);
+    GMPY_MAYBE_END_ALLOW_THREADS;
 
     Py_DECREF((PyObject*)tempx);
     Py_DECREF((PyObject*)tempy);
@@ -126,17 +130,17 @@ PyDoc_STRVAR(doc_c_mod,
 "the opposite sign of y. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_c_mod(PyObject *self, PyObject *args)
+GMPy_MPZ_c_mod(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *r, *tempx, *tempy;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("c_mod() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     r = GMPy_MPZ_New(NULL);
     if (!tempx || !tempy || !r)
         goto err;
@@ -146,7 +150,9 @@ GMPy_MPZ_c_mod(PyObject *self, PyObject *args)
         goto err;
     }
 
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z) + mpz_size(tempy->z));
     mpz_cdiv_r(r->z, tempx->z, tempy->z);
+    GMPY_MAYBE_END_ALLOW_THREADS;
 
     Py_DECREF((PyObject*)tempx);
     Py_DECREF((PyObject*)tempy);
@@ -172,18 +178,18 @@ PyDoc_STRVAR(doc_f_divmod,
 "have the same sign as y. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_f_divmod(PyObject *self, PyObject *args)
+GMPy_MPZ_f_divmod(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     PyObject *result;
     MPZ_Object *q, *r, *tempx, *tempy;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(GMPY_NARGS != 2) {
         TYPE_ERROR("f_divmod() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     q = GMPy_MPZ_New(NULL);
     r = GMPy_MPZ_New(NULL);
     result = PyTuple_New(2);
@@ -195,7 +201,9 @@ GMPy_MPZ_f_divmod(PyObject *self, PyObject *args)
         goto err;
     }
 
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z) + mpz_size(tempy->z));
     mpz_fdiv_qr(q->z, r->z, tempx->z, tempy->z);
+    GMPY_MAYBE_END_ALLOW_THREADS;
 
     Py_DECREF((PyObject*)tempx);
     Py_DECREF((PyObject*)tempy);
@@ -218,17 +226,17 @@ PyDoc_STRVAR(doc_f_div,
 "towards -Inf (floor rounding). x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_f_div(PyObject *self, PyObject *args)
+GMPy_MPZ_f_div(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *q, *tempx, *tempy;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(GMPY_NARGS != 2) {
         TYPE_ERROR("f_div() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     q = GMPy_MPZ_New(NULL);
     if (!tempx || !tempy || !q)
         goto err;
@@ -238,7 +246,9 @@ GMPy_MPZ_f_div(PyObject *self, PyObject *args)
         goto err;
     }
 
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z) + mpz_size(tempy->z));
     mpz_fdiv_q(q->z, tempx->z, tempy->z);
+    GMPY_MAYBE_END_ALLOW_THREADS;
 
     Py_DECREF((PyObject*)tempx);
     Py_DECREF((PyObject*)tempy);
@@ -257,17 +267,17 @@ PyDoc_STRVAR(doc_f_mod,
 "the same sign as y. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_f_mod(PyObject *self, PyObject *args)
+GMPy_MPZ_f_mod(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *r, *tempx, *tempy;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(GMPY_NARGS != 2) {
         TYPE_ERROR("f_mod() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     r = GMPy_MPZ_New(NULL);
     if (!tempx || !tempy || !r)
         goto err;
@@ -277,7 +287,9 @@ GMPy_MPZ_f_mod(PyObject *self, PyObject *args)
         goto err;
     }
 
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z) + mpz_size(tempy->z));
     mpz_fdiv_r(r->z, tempx->z, tempy->z);
+    GMPY_MAYBE_END_ALLOW_THREADS;
 
     Py_DECREF((PyObject*)tempx);
     Py_DECREF((PyObject*)tempy);
@@ -303,18 +315,18 @@ PyDoc_STRVAR(doc_t_divmod,
 "the same sign as x. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_t_divmod(PyObject *self, PyObject *args)
+GMPy_MPZ_t_divmod(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     PyObject *result;
     MPZ_Object *q, *r, *tempx, *tempy;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("t_divmod() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     q = GMPy_MPZ_New(NULL);
     r = GMPy_MPZ_New(NULL);
     result = PyTuple_New(2);
@@ -326,7 +338,9 @@ GMPy_MPZ_t_divmod(PyObject *self, PyObject *args)
         goto err;
     }
 
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z) + mpz_size(tempy->z));
     mpz_tdiv_qr(q->z, r->z, tempx->z, tempy->z);
+    GMPY_MAYBE_END_ALLOW_THREADS;
 
     Py_DECREF((PyObject*)tempx);
     Py_DECREF((PyObject*)tempy);
@@ -349,17 +363,17 @@ PyDoc_STRVAR(doc_t_div,
 "towards 0. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_t_div(PyObject *self, PyObject *args)
+GMPy_MPZ_t_div(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *q, *tempx, *tempy;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("t_div() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     q = GMPy_MPZ_New(NULL);
     if (!tempx || !tempy || !q)
         goto err;
@@ -369,7 +383,9 @@ GMPy_MPZ_t_div(PyObject *self, PyObject *args)
         goto err;
     }
 
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z) + mpz_size(tempy->z));
     mpz_tdiv_q(q->z, tempx->z, tempy->z);
+    GMPY_MAYBE_END_ALLOW_THREADS;
 
     Py_DECREF((PyObject*)tempx);
     Py_DECREF((PyObject*)tempy);
@@ -388,17 +404,17 @@ PyDoc_STRVAR(doc_t_mod,
 "the same sign as x. x and y must be integers.");
 
 static PyObject *
-GMPy_MPZ_t_mod(PyObject *self, PyObject *args)
+GMPy_MPZ_t_mod(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *r, *tempx, *tempy;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(GMPY_NARGS != 2) {
         TYPE_ERROR("t_mod() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     r = GMPy_MPZ_New(NULL);
     if (!tempx || !tempy || !r)
         goto err;
@@ -408,7 +424,9 @@ GMPy_MPZ_t_mod(PyObject *self, PyObject *args)
         goto err;
     }
 
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z) + mpz_size(tempy->z));
     mpz_tdiv_r(r->z, tempx->z, tempy->z);
+    GMPY_MAYBE_END_ALLOW_THREADS;
 
     Py_DECREF((PyObject*)tempx);
     Py_DECREF((PyObject*)tempy);
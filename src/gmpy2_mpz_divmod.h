@@ -32,15 +32,15 @@
 extern "C" {
 #endif
 
-static PyObject * GMPy_MPZ_c_divmod(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_c_div(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_c_mod(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_f_divmod(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_f_div(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_f_mod(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_t_divmod(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_t_div(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_t_mod(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_c_divmod(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_c_div(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_c_mod(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_f_divmod(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_f_div(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_f_mod(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_t_divmod(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_t_div(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_t_mod(PyObject *self, GMPY_FASTCALL_ARGS);
 
 #ifdef __cplusplus
 }
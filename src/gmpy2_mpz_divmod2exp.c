@@ -43,23 +43,23 @@ PyDoc_STRVAR(doc_c_divmod_2exp,
 "be negative. x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_c_divmod_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_c_divmod_2exp(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t nbits;
     PyObject *result;
     MPZ_Object *q, *r, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("c_divmod_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
     q = GMPy_MPZ_New(NULL);
     r = GMPy_MPZ_New(NULL);
     result = PyTuple_New(2);
@@ -86,22 +86,22 @@ PyDoc_STRVAR(doc_c_div_2exp,
 "towards +Inf (ceiling rounding). x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_c_div_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_c_div_2exp(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *result, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("c_div_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
     result = GMPy_MPZ_New(NULL);
     if (!tempx || !result) {
         Py_XDECREF((PyObject*)result);
@@ -120,22 +120,22 @@ PyDoc_STRVAR(doc_c_mod_2exp,
 "negative. x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_c_mod_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_c_mod_2exp(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *result, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("c_mod_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
     result = GMPy_MPZ_New(NULL);
     if (!tempx || !result) {
         Py_XDECREF((PyObject*)result);
@@ -161,23 +161,23 @@ PyDoc_STRVAR(doc_f_divmod_2exp,
 "positive. x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_f_divmod_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_f_divmod_2exp(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t nbits;
     PyObject *result;
     MPZ_Object *q, *r, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("f_divmod_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
     q = GMPy_MPZ_New(NULL);
     r = GMPy_MPZ_New(NULL);
     result = PyTuple_New(2);
@@ -204,22 +204,22 @@ PyDoc_STRVAR(doc_f_div_2exp,
 "towards -Inf (floor rounding). x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_f_div_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_f_div_2exp(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *result, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("f_div_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
     result = GMPy_MPZ_New(NULL);
     if (!tempx || !result) {
         Py_XDECREF((PyObject*)result);
@@ -238,22 +238,22 @@ PyDoc_STRVAR(doc_f_mod_2exp,
 "positive. x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_f_mod_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_f_mod_2exp(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *result, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("f_mod_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
     result = GMPy_MPZ_New(NULL);
     if (!tempx || !result) {
         Py_XDECREF((PyObject*)result);
@@ -279,23 +279,23 @@ PyDoc_STRVAR(doc_t_divmod_2exp,
 "same sign as x. x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_t_divmod_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_t_divmod_2exp(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *q, *r, *tempx;
     PyObject *result;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("t_divmod_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
     q = GMPy_MPZ_New(NULL);
     r = GMPy_MPZ_New(NULL);
     result = PyTuple_New(2);
@@ -322,22 +322,22 @@ PyDoc_STRVAR(doc_t_div_2exp,
 "towards zero (truncation). n must be >0.");
 
 static PyObject *
-GMPy_MPZ_t_div_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_t_div_2exp(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *result, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("t_div_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
     result = GMPy_MPZ_New(NULL);
     if (!tempx || !result) {
         Py_XDECREF((PyObject*)result);
@@ -356,22 +356,22 @@ PyDoc_STRVAR(doc_t_mod_2exp,
 "the same sign as x. x must be an integer. n must be >0.");
 
 static PyObject *
-GMPy_MPZ_t_mod_2exp(PyObject *self, PyObject *args)
+GMPy_MPZ_t_mod_2exp(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t nbits;
     MPZ_Object *result, *tempx;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("t_mod_2exp() requires 'mpz','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (nbits == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
     result = GMPy_MPZ_New(NULL);
     if (!tempx || !result) {
         Py_XDECREF((PyObject*)result);
@@ -39,13 +39,13 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_num_digits,
 "value returned may be 1 too large.");
 
 static PyObject *
-GMPy_MPZ_Method_NumDigits(PyObject *self, PyObject *args)
+GMPy_MPZ_Method_NumDigits(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     long base = 10;
     PyObject *result;
 
-    if (PyTuple_GET_SIZE(args) == 1) {
-        base = PyIntOrLong_AsLong(PyTuple_GET_ITEM(args, 0));
+    if (GMPY_NARGS == 1) {
+        base = PyIntOrLong_AsLong(GMPY_ARG(0));
         if (base == -1 && PyErr_Occurred()) {
             return NULL;
         }
@@ -61,21 +61,21 @@ GMPy_MPZ_Method_NumDigits(PyObject *self, PyObject *args)
 }
 
 static PyObject *
-GMPy_MPZ_Function_NumDigits(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_NumDigits(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     long base = 10;
     Py_ssize_t argc;
     MPZ_Object *temp;
     PyObject *result;
 
-    argc = PyTuple_GET_SIZE(args);
+    argc = GMPY_NARGS;
     if (argc == 0 || argc > 2) {
         TYPE_ERROR("num_digits() requires 'mpz',['int'] arguments");
         return NULL;
     }
 
     if (argc == 2) {
-        base = PyIntOrLong_AsLong(PyTuple_GET_ITEM(args, 1));
+        base = PyIntOrLong_AsLong(GMPY_ARG(1));
         if (base == -1 && PyErr_Occurred()) {
             return NULL;
         }
@@ -86,7 +86,7 @@ GMPy_MPZ_Function_NumDigits(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    if (!(temp = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(temp = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL))) {
         return NULL;
     }
     
@@ -101,25 +101,25 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_iroot,
 "iff the root is exact. x >= 0. n > 0.");
 
 static PyObject *
-GMPy_MPZ_Function_Iroot(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Iroot(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     unsigned long n;
     int exact;
     MPZ_Object *root, *tempx;
     PyObject *result;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("iroot() requires 'mpz','int' arguments");
         return NULL;
     }
     
-    n = c_ulong_From_Integer(PyTuple_GET_ITEM(args, 1));
+    n = c_ulong_From_Integer(GMPY_ARG(1));
     if ((n == 0) || ((n == (unsigned long)(-1)) && PyErr_Occurred())) {
         VALUE_ERROR("n must be > 0");
         return NULL;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL))) {
         return NULL;
     }
     
@@ -138,7 +138,9 @@ GMPy_MPZ_Function_Iroot(PyObject *self, PyObject *args)
         return NULL;
     }
 
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z));
     exact = mpz_root(root->z, tempx->z, n);
+    GMPY_MAYBE_END_ALLOW_THREADS;
     Py_DECREF((PyObject*)tempx);
     
     PyTuple_SET_ITEM(result, 0, (PyObject*)root);
@@ -152,24 +154,24 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_iroot_rem,
 "root of x and x=y**n + r. x >= 0. n > 0.");
 
 static PyObject *
-GMPy_MPZ_Function_IrootRem(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_IrootRem(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     unsigned long n;
     MPZ_Object *root, *rem, *tempx;
     PyObject *result;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("iroot_rem() requires 'mpz','int' arguments");
         return NULL;
     }
     
-    n = c_ulong_From_Integer(PyTuple_GET_ITEM(args, 1));
+    n = c_ulong_From_Integer(GMPY_ARG(1));
     if ((n == 0) || ((n == (unsigned long)(-1)) && PyErr_Occurred())) {
         VALUE_ERROR("n must be > 0");
         return NULL;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL))) {
         return NULL;
     }
     
@@ -190,7 +192,9 @@ GMPy_MPZ_Function_IrootRem(PyObject *self, PyObject *args)
         return NULL;
     }
     
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z));
     mpz_rootrem(root->z, rem->z, tempx->z, n);
+    GMPY_MAYBE_END_ALLOW_THREADS;
     Py_DECREF((PyObject*)tempx);
     
     PyTuple_SET_ITEM(result, 0, (PyObject*)root);
@@ -228,23 +232,23 @@ GMPy_MPZ_Method_Trunc(PyObject *self, PyObject *other)
 PyDoc_STRVAR(GMPy_doc_mpz_method_round, "Round an mpz to power of 10.");
 
 static PyObject *
-GMPy_MPZ_Method_Round(PyObject *self, PyObject *args)
+GMPy_MPZ_Method_Round(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     Py_ssize_t round_digits;
     MPZ_Object *result;
     mpz_t temp, rem;
 
-    if (PyTuple_GET_SIZE(args) == 0) {
+    if (GMPY_NARGS == 0) {
         Py_INCREF(self);
         return self;
     }
 
-    if (PyTuple_GET_SIZE(args) != 1) {
+    if (GMPY_NARGS != 1) {
         TYPE_ERROR("Too many arguments for __round__().");
         return NULL;
     }
 
-    round_digits = ssize_t_From_Integer(PyTuple_GET_ITEM(args, 0));
+    round_digits = ssize_t_From_Integer(GMPY_ARG(0));
     if (round_digits == -1 && PyErr_Occurred()) {
         TYPE_ERROR("__round__() requires 'int' argument");
         return NULL;
@@ -314,12 +318,12 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_gcd,
 "Return the greatest common denominator of integers a and b.");
 
 static PyObject *
-GMPy_MPZ_Function_GCD(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_GCD(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     PyObject *arg0, *arg1;
     MPZ_Object *result, *tempa, *tempb;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("gcd() requires 'mpz','mpz' arguments");
         return NULL;
     }
@@ -328,10 +332,12 @@ GMPy_MPZ_Function_GCD(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    arg0 = PyTuple_GET_ITEM(args, 0);
-    arg1 = PyTuple_GET_ITEM(args, 1);
+    arg0 = GMPY_ARG(0);
+    arg1 = GMPY_ARG(1);
     if (MPZ_Check(arg0) && MPZ_Check(arg1)) {
+        GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(MPZ(arg0)) + mpz_size(MPZ(arg1)));
         mpz_gcd(result->z, MPZ(arg0), MPZ(arg1));
+        GMPY_MAYBE_END_ALLOW_THREADS;
     }
     else {
         tempa = GMPy_MPZ_From_Integer(arg0, NULL);
@@ -344,7 +350,9 @@ GMPy_MPZ_Function_GCD(PyObject *self, PyObject *args)
             return NULL;
         }
         
+        GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempa->z) + mpz_size(tempb->z));
         mpz_gcd(result->z, tempa->z, tempb->z);
+        GMPY_MAYBE_END_ALLOW_THREADS;
         Py_DECREF((PyObject*)tempa);
         Py_DECREF((PyObject*)tempb);
     }
@@ -356,12 +364,12 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_lcm,
 "Return the lowest common multiple of integers a and b.");
 
 static PyObject *
-GMPy_MPZ_Function_LCM(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_LCM(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     PyObject *arg0, *arg1;
     MPZ_Object *result, *tempa, *tempb;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(GMPY_NARGS != 2) {
         TYPE_ERROR("lcm() requires 'mpz','mpz' arguments");
         return NULL;
     }
@@ -370,8 +378,8 @@ GMPy_MPZ_Function_LCM(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    arg0 = PyTuple_GET_ITEM(args, 0);
-    arg1 = PyTuple_GET_ITEM(args, 1);
+    arg0 = GMPY_ARG(0);
+    arg1 = GMPY_ARG(1);
 
     if (MPZ_Check(arg0) && MPZ_Check(arg1)) {
         mpz_lcm(result->z, MPZ(arg0), MPZ(arg1));
@@ -399,12 +407,12 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_gcdext,
 "    g == gcd(a,b) and g == a*s + b*t");
 
 static PyObject *
-GMPy_MPZ_Function_GCDext(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_GCDext(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     PyObject *arg0, *arg1, *result;
     MPZ_Object *g, *s, *t, *tempa, *tempb;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(GMPY_NARGS != 2) {
         TYPE_ERROR("gcdext() requires 'mpz','mpz' arguments");
         return NULL;
     }
@@ -421,11 +429,13 @@ GMPy_MPZ_Function_GCDext(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    arg0 = PyTuple_GET_ITEM(args, 0);
-    arg1 = PyTuple_GET_ITEM(args, 1);
+    arg0 = GMPY_ARG(0);
+    arg1 = GMPY_ARG(1);
 
     if (MPZ_Check(arg0) && MPZ_Check(arg1)) {
+        GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(MPZ(arg0)) + mpz_size(MPZ(arg1)));
         mpz_gcdext(g->z, s->z, t->z, MPZ(arg0), MPZ(arg1));
+        GMPY_MAYBE_END_ALLOW_THREADS;
     }
     else {
         tempa = GMPy_MPZ_From_Integer(arg0, NULL);
@@ -440,7 +450,9 @@ GMPy_MPZ_Function_GCDext(PyObject *self, PyObject *args)
             Py_DECREF(result);
             return NULL;
         }
+        GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempa->z) + mpz_size(tempb->z));
         mpz_gcdext(g->z, s->z, t->z, tempa->z, tempb->z);
+        GMPY_MAYBE_END_ALLOW_THREADS;
         Py_DECREF((PyObject*)tempa);
         Py_DECREF((PyObject*)tempb);
     }
@@ -456,13 +468,13 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_divm,
 "exception if no such value x exists.");
 
 static PyObject *
-GMPy_MPZ_Function_Divm(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Divm(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *result, *num, *den, *mod;
     mpz_t numz, denz, modz, gcdz;
     int ok = 0;
 
-    if (PyTuple_GET_SIZE(args) != 3) {
+    if (GMPY_NARGS != 3) {
         TYPE_ERROR("divm() requires 'mpz','mpz','mpz' arguments");
         return NULL;
     }
@@ -471,9 +483,9 @@ GMPy_MPZ_Function_Divm(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    num = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    den = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
-    mod = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 2), NULL);
+    num = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    den = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
+    mod = GMPy_MPZ_From_Integer(GMPY_ARG(2), NULL);
 
     if (!num || !den || !mod) {
         TYPE_ERROR("divm() requires 'mpz','mpz','mpz' arguments");
@@ -601,22 +613,22 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_multi_fac,
 "factorial is defined as n*(n-m)*(n-2m)...");
 
 static PyObject *
-GMPy_MPZ_Function_MultiFac(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_MultiFac(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *result = NULL;
     unsigned long n, m;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("multi_fac() requires 2 integer arguments");
         return NULL;
     }
 
-    n = c_ulong_From_Integer(PyTuple_GET_ITEM(args, 0));
+    n = c_ulong_From_Integer(GMPY_ARG(0));
     if (n == (unsigned long)(-1) && PyErr_Occurred()) {
         return NULL;
     }
     
-    m = c_ulong_From_Integer(PyTuple_GET_ITEM(args, 1));
+    m = c_ulong_From_Integer(GMPY_ARG(1));
     if (m == (unsigned long)(-1) && PyErr_Occurred()) {
         return NULL;
     }
@@ -742,21 +754,21 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_comb,
 "time'. n >= 0. Same as bincoef(x, n)");
 
 static PyObject *
-GMPy_MPZ_Function_Bincoef(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Bincoef(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *result = NULL, *tempx;
     unsigned long k;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("bincoef() requires two integer arguments");
         return NULL;
     }
     
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL))) {
         return NULL;
     }
 
-    k = c_ulong_From_Integer(PyTuple_GET_ITEM(args, 1));
+    k = c_ulong_From_Integer(GMPY_ARG(1));
     if (k == (unsigned long)(-1) && PyErr_Occurred()) {
         return NULL;
     }
@@ -778,7 +790,7 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_isqrt,
 static PyObject *
 GMPy_MPZ_Function_Isqrt(PyObject *self, PyObject *other)
 {
-    MPZ_Object *result;
+    MPZ_Object *result, *tempx;
 
     if (CHECK_MPZANY(other)) {
         if (mpz_sgn(MPZ(other)) < 0) {
@@ -786,20 +798,32 @@ GMPy_MPZ_Function_Isqrt(PyObject *self, PyObject *other)
             return NULL;
         }
         if ((result = GMPy_MPZ_New(NULL))) {
-            mpz_sqrt(result->z, MPZ(other));
+            if (MPZ_Check(other)) {
+                GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(MPZ(other)));
+                mpz_sqrt(result->z, MPZ(other));
+                GMPY_MAYBE_END_ALLOW_THREADS;
+            }
+            else {
+                mpz_sqrt(result->z, MPZ(other));
+            }
         }
     }
     else {
-        if (!(result = GMPy_MPZ_From_Integer(other, NULL))) {
+        if (!(tempx = GMPy_MPZ_From_Integer(other, NULL))) {
             TYPE_ERROR("isqrt() requires 'mpz' argument");
             return NULL;
         }
-        if (mpz_sgn(result->z) < 0) {
+        if (mpz_sgn(tempx->z) < 0) {
             VALUE_ERROR("isqrt() of negative number");
-            Py_DECREF((PyObject*)result);
+            Py_DECREF((PyObject*)tempx);
             return NULL;
         }
-        mpz_sqrt(result->z, result->z);
+        if ((result = GMPy_MPZ_New(NULL))) {
+            GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z));
+            mpz_sqrt(result->z, tempx->z);
+            GMPY_MAYBE_END_ALLOW_THREADS;
+        }
+        Py_DECREF((PyObject*)tempx);
     }
     return (PyObject*)result;
 }
@@ -837,7 +861,9 @@ GMPy_MPZ_Function_IsqrtRem(PyObject *self, PyObject *other)
         return NULL;
     }
 
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(temp->z));
     mpz_sqrtrem(root->z, rem->z, temp->z);
+    GMPY_MAYBE_END_ALLOW_THREADS;
     Py_DECREF((PyObject*)temp);
     PyTuple_SET_ITEM(result, 0, (PyObject*)root);
     PyTuple_SET_ITEM(result, 1, (PyObject*)rem);
@@ -851,13 +877,13 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_remove,
 "possible. m is the multiplicity f in x. f > 1.");
 
 static PyObject *
-GMPy_MPZ_Function_Remove(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Remove(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *result, *tempx, *tempf;
     PyObject *x, *f;
     size_t multiplicity;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("remove() requires 'mpz','mpz' arguments");
         return NULL;
     }
@@ -866,8 +892,8 @@ GMPy_MPZ_Function_Remove(PyObject *self, PyObject *args)
         return NULL;
     }
     
-    x = PyTuple_GET_ITEM(args, 0);
-    f = PyTuple_GET_ITEM(args, 1);
+    x = GMPY_ARG(0);
+    f = GMPY_ARG(1);
 
     if (MPZ_Check(x) && MPZ_Check(f)) {
         if (mpz_cmp_si(MPZ(f), 2) < 0) {
@@ -906,13 +932,13 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_invert,
 "inverse exists.");
 
 static PyObject *
-GMPy_MPZ_Function_Invert(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Invert(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     PyObject *x, *y;
     MPZ_Object *result, *tempx, *tempy;
     int success;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("invert() requires 'mpz','mpz' arguments");
         return NULL;
     }
@@ -921,8 +947,8 @@ GMPy_MPZ_Function_Invert(PyObject *self, PyObject *args)
         return NULL;
     }
     
-    x = PyTuple_GET_ITEM(args, 0);
-    y = PyTuple_GET_ITEM(args, 1);
+    x = GMPY_ARG(0);
+    y = GMPY_ARG(1);
 
     if (MPZ_Check(x) && MPZ_Check(y)) {
         if (mpz_sgn(MPZ(y)) == 0) {
@@ -966,18 +992,222 @@ GMPy_MPZ_Function_Invert(PyObject *self, PyObject *args)
     return (PyObject*)result;
 }
 
+/* Invert every element of v modulo m (m > 0) using Montgomery's trick:
+ * one modular inversion of the product of all the elements followed by
+ * 3*(n-1) modular multiplications. prefix is a scratch array and out
+ * receives the inverses; both must have room for v->length initialized
+ * values. Returns -1 on success, or the index of the first element that
+ * is not invertible. The Python API is not used so this can be called
+ * without holding the GIL.
+ */
+
+static Py_ssize_t
+GMPy_MPZ_BatchInvert_Core(MPZ_Vector_Object *v, mpz_srcptr m, mpz_t *prefix,
+                          mpz_t *out, mpz_ptr inv)
+{
+    Py_ssize_t i, n = v->length;
+    mpz_t view;
+
+    if (n == 0)
+        return -1;
+
+    /* out[i] temporarily holds the reduced value of element i. */
+    for (i = 0; i < n; i++) {
+        MPZ_VECTOR_VIEW(view, v, i);
+        mpz_fdiv_r(out[i], view, m);
+        if (i == 0) {
+            mpz_set(prefix[0], out[0]);
+        }
+        else {
+            mpz_mul(prefix[i], prefix[i - 1], out[i]);
+            mpz_tdiv_r(prefix[i], prefix[i], m);
+        }
+    }
+
+    if (!mpz_invert(inv, prefix[n - 1], m)) {
+        for (i = 0; i < n; i++) {
+            mpz_gcd(inv, out[i], m);
+            if (mpz_cmp_ui(inv, 1) != 0)
+                return i;
+        }
+        /* Not reached: a product of invertible elements is invertible. */
+        return 0;
+    }
+
+    /* inv is the inverse of out[0] * ... * out[i]. */
+    for (i = n - 1; i > 0; i--) {
+        mpz_mul(prefix[i], inv, prefix[i - 1]);
+        mpz_tdiv_r(prefix[i], prefix[i], m);
+        mpz_mul(inv, inv, out[i]);
+        mpz_tdiv_r(inv, inv, m);
+        mpz_swap(out[i], prefix[i]);
+    }
+    mpz_set(out[0], inv);
+    return -1;
+}
+
+/* Return the inverses modulo m of the integers in values. m must not be
+ * 0; its sign is ignored. If out is a list of xmpz with the same length as
+ * values, the inverses are stored in the xmpz and None is returned.
+ * Otherwise an mpz_vector is returned if values is an mpz_vector and a
+ * list is returned if not.
+ */
+
+static PyObject *
+GMPy_MPZ_BatchInvert(PyObject *values, mpz_srcptr m, PyObject *out, const char *name)
+{
+    MPZ_Vector_Object *v, *vresult;
+    PyObject *result = NULL, **targets = NULL;
+    mpz_t *prefix = NULL, *inverses = NULL, mm, inv;
+    Py_ssize_t i, n, bad;
+
+    if (!(v = GMPy_MPZ_Vector_From_Iterable(values, name)))
+        return NULL;
+    n = v->length;
+
+    if (out) {
+        int ok = PyList_Check(out) && PyList_GET_SIZE(out) == n;
+
+        for (i = 0; ok && i < n; i++)
+            ok = XMPZ_Check(PyList_GET_ITEM(out, i));
+        if (!ok) {
+            PyErr_Format(PyExc_TypeError,
+                         "%s requires a list of xmpz with the same length", name);
+            Py_DECREF((PyObject*)v);
+            return NULL;
+        }
+
+        /* Keep references to the xmpz since another thread can change
+         * the list while the GIL is released. */
+        if (!(targets = GMPY_MALLOC((n ? n : 1) * sizeof(PyObject*)))) {
+            Py_DECREF((PyObject*)v);
+            return PyErr_NoMemory();
+        }
+        for (i = 0; i < n; i++) {
+            targets[i] = PyList_GET_ITEM(out, i);
+            Py_INCREF(targets[i]);
+        }
+    }
+
+    prefix = GMPY_MALLOC((n ? n : 1) * sizeof(mpz_t));
+    inverses = GMPY_MALLOC((n ? n : 1) * sizeof(mpz_t));
+    if (!prefix || !inverses) {
+        GMPY_FREE(prefix);
+        GMPY_FREE(inverses);
+        if (targets) {
+            for (i = 0; i < n; i++)
+                Py_DECREF(targets[i]);
+            GMPY_FREE(targets);
+        }
+        Py_DECREF((PyObject*)v);
+        return PyErr_NoMemory();
+    }
+    for (i = 0; i < n; i++) {
+        mpz_init(prefix[i]);
+        mpz_init(inverses[i]);
+    }
+    mpz_init(mm);
+    mpz_init(inv);
+    mpz_abs(mm, m);
+
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(n * mpz_size(mm));
+    bad = GMPy_MPZ_BatchInvert_Core(v, mm, prefix, inverses, inv);
+    GMPY_MAYBE_END_ALLOW_THREADS;
+
+    if (bad >= 0) {
+        PyErr_Format(PyExc_ZeroDivisionError,
+                     "%s no inverse exists for element %zd", name, bad);
+        goto done;
+    }
+
+    if (out) {
+        for (i = 0; i < n; i++)
+            mpz_swap(MPZ(targets[i]), inverses[i]);
+        Py_INCREF(Py_None);
+        result = Py_None;
+    }
+    else if (MPZ_Vector_Check(values)) {
+        if (!(vresult = GMPy_MPZ_Vector_New(n, n * mpz_size(mm))))
+            goto done;
+        for (i = 0; i < n; i++) {
+            if (GMPy_MPZ_Vector_Append(vresult, inverses[i]) < 0) {
+                Py_DECREF((PyObject*)vresult);
+                goto done;
+            }
+        }
+        result = (PyObject*)vresult;
+    }
+    else {
+        result = GMPy_MPZ_List_FromArray(inverses, n);
+    }
+
+  done:
+    for (i = 0; i < n; i++) {
+        mpz_clear(prefix[i]);
+        mpz_clear(inverses[i]);
+    }
+    GMPY_FREE(prefix);
+    GMPY_FREE(inverses);
+    if (targets) {
+        for (i = 0; i < n; i++)
+            Py_DECREF(targets[i]);
+        GMPY_FREE(targets);
+    }
+    mpz_clear(mm);
+    mpz_clear(inv);
+    Py_DECREF((PyObject*)v);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_batch_invert,
+"batch_invert(values, m[, out]) -> list\n\n"
+"Return the inverse modulo m of each integer in values. Uses one\n"
+"modular inversion and 3*(n-1) modular multiplications. Raises\n"
+"ZeroDivisionError, including the index of the first element that is\n"
+"not invertible, if an inverse does not exist. If out is a list of\n"
+"xmpz with the same length as values, the inverses are stored in the\n"
+"xmpz and None is returned. If values is an mpz_vector, an mpz_vector\n"
+"is returned.");
+
+static PyObject *
+GMPy_MPZ_Function_BatchInvert(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    MPZ_Object *tempm;
+    PyObject *result;
+
+    if (GMPY_NARGS < 2 || GMPY_NARGS > 3 || !IS_INTEGER(GMPY_ARG(1))) {
+        TYPE_ERROR("batch_invert() requires 'iterable','mpz'[,'list'] arguments");
+        return NULL;
+    }
+
+    if (!(tempm = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL)))
+        return NULL;
+
+    if (mpz_sgn(tempm->z) == 0) {
+        ZERO_ERROR("batch_invert() division by 0");
+        Py_DECREF((PyObject*)tempm);
+        return NULL;
+    }
+
+    result = GMPy_MPZ_BatchInvert(GMPY_ARG(0), tempm->z,
+                                  GMPY_NARGS == 3 ? GMPY_ARG(2) : NULL,
+                                  "batch_invert()");
+    Py_DECREF((PyObject*)tempm);
+    return result;
+}
+
 PyDoc_STRVAR(GMPy_doc_mpz_function_divexact,
 "divexact(x, y) -> mpz\n\n"
 "Return the quotient of x divided by y. Faster than standard\n"
 "division but requires the remainder is zero!");
 
 static PyObject *
-GMPy_MPZ_Function_Divexact(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Divexact(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     PyObject *x, *y;
     MPZ_Object *result, *tempx, *tempy;
 
-    if(PyTuple_GET_SIZE(args) != 2) {
+    if(GMPY_NARGS != 2) {
         TYPE_ERROR("divexact() requires 'mpz','mpz' arguments");
         return NULL;
     }
@@ -986,8 +1216,8 @@ GMPy_MPZ_Function_Divexact(PyObject *self, PyObject *args)
         return NULL;
     }
     
-    x = PyTuple_GET_ITEM(args, 0);
-    y = PyTuple_GET_ITEM(args, 1);
+    x = GMPY_ARG(0);
+    y = GMPY_ARG(1);
 
     if (MPZ_Check(x) && MPZ_Check(y)) {
         if (mpz_sgn(MPZ(y)) == 0) {
@@ -1056,22 +1286,22 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_is_divisible,
 "Returns True if x is divisible by d, else return False.");
 
 static PyObject *
-GMPy_MPZ_Function_IsDivisible(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_IsDivisible(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     unsigned long temp;
     int error, res;
     MPZ_Object *tempx, *tempd;
     
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("is_divisible() requires 2 integer arguments");
         return NULL;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL))) {
         return NULL;
     }
 
-    temp = GMPy_Integer_AsUnsignedLongAndError(PyTuple_GET_ITEM(args, 1), &error);
+    temp = GMPy_Integer_AsUnsignedLongAndError(GMPY_ARG(1), &error);
     if (!error) {
         res = mpz_divisible_ui_p(tempx->z, temp);
         Py_DECREF((PyObject*)tempx);
@@ -1081,7 +1311,7 @@ GMPy_MPZ_Function_IsDivisible(PyObject *self, PyObject *args)
             Py_RETURN_FALSE;
     }
         
-    if (!(tempd = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL))) {
+    if (!(tempd = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL))) {
         TYPE_ERROR("is_divisible() requires 2 integer arguments");
         Py_DECREF((PyObject*)tempx);
         return NULL;
@@ -1136,19 +1366,19 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_is_congruent,
 "Returns True if x is congruent to y modulo m, else return False.");
 
 static PyObject *
-GMPy_MPZ_Function_IsCongruent(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_IsCongruent(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     int res;
     MPZ_Object *tempx, *tempy, *tempm;
     
-    if (PyTuple_GET_SIZE(args) != 3) {
+    if (GMPY_NARGS != 3) {
         TYPE_ERROR("is_congruent() requires 3 integer arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
-    tempm = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 2), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
+    tempm = GMPy_MPZ_From_Integer(GMPY_ARG(2), NULL);
     if (!tempx || !tempy || !tempm) {
         Py_XDECREF((PyObject*)tempx);
         Py_XDECREF((PyObject*)tempy);
@@ -1172,18 +1402,18 @@ PyDoc_STRVAR(GMPy_doc_mpz_method_is_congruent,
 "Returns True if x is congruent to y modulo m, else return False.");
 
 static PyObject *
-GMPy_MPZ_Method_IsCongruent(PyObject *self, PyObject *args)
+GMPy_MPZ_Method_IsCongruent(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     int res;
     MPZ_Object *tempy, *tempm;
     
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("is_congruent() requires 3 integer arguments");
         return NULL;
     }
 
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempm = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempm = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     if (!tempy || !tempm) {
         Py_XDECREF((PyObject*)tempy);
         Py_XDECREF((PyObject*)tempm);
@@ -1238,27 +1468,27 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_is_prime,
 "to n Miller-Rabin tests are performed.");
 
 static PyObject *
-GMPy_MPZ_Function_IsPrime(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_IsPrime(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     int i, reps = 25;
     MPZ_Object* tempx;
     Py_ssize_t argc;
 
-    argc = PyTuple_GET_SIZE(args);
+    argc = GMPY_NARGS;
 
     if (argc == 0 || argc > 2) {
         TYPE_ERROR("is_prime() requires 'mpz'[,'int'] arguments");
         return NULL; 
     }
         
-    if (PyTuple_GET_SIZE(args) == 2) {
-        reps = c_long_From_Integer(PyTuple_GET_ITEM(args, 1));
+    if (GMPY_NARGS == 2) {
+        reps = c_long_From_Integer(GMPY_ARG(1));
         if (reps == -1 && PyErr_Occurred()) {
             return NULL; 
         }
     }
     
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL))) {
         return NULL;
     }
 
@@ -1284,7 +1514,7 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_next_prime,
 static PyObject *
 GMPy_MPZ_Function_NextPrime(PyObject *self, PyObject *other)
 {
-    MPZ_Object *result;
+    MPZ_Object *result, *tempx;
 
     if(MPZ_Check(other)) {
         if(!(result = GMPy_MPZ_New(NULL))) {
@@ -1293,13 +1523,13 @@ GMPy_MPZ_Function_NextPrime(PyObject *self, PyObject *other)
         mpz_nextprime(result->z, MPZ(other));
     }
     else {
-        if (!(result = GMPy_MPZ_From_Integer(other, NULL))) {
+        if (!(tempx = GMPy_MPZ_From_Integer(other, NULL))) {
             TYPE_ERROR("next_prime() requires 'mpz' argument");
             return NULL;
         }
-        else {
-            mpz_nextprime(result->z, result->z);
-        }
+        if ((result = GMPy_MPZ_New(NULL)))
+            mpz_nextprime(result->z, tempx->z);
+        Py_DECREF((PyObject*)tempx);
     }
     return (PyObject*)result;
 }
@@ -1309,18 +1539,18 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_jacobi,
 "Return the Jacobi symbol (x|y). y must be odd and >0.");
 
 static PyObject *
-GMPy_MPZ_Function_Jacobi(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Jacobi(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *tempx, *tempy;
     long res;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("jacobi() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     if (!tempx || !tempy) {
         Py_XDECREF((PyObject*)tempx);
         Py_XDECREF((PyObject*)tempy);
@@ -1345,18 +1575,18 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_legendre,
 "Return the Legendre symbol (x|y). y is assumed to be an odd prime.");
 
 static PyObject *
-GMPy_MPZ_Function_Legendre(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Legendre(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *tempx, *tempy;
     long res;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("legendre() requires 'mpz','mpz' arguments");
         return NULL;
     }
 
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     if (!tempx || !tempy) {
         Py_XDECREF((PyObject*)tempx);
         Py_XDECREF((PyObject*)tempy);
@@ -1381,18 +1611,18 @@ PyDoc_STRVAR(GMPy_doc_mpz_function_kronecker,
 "Return the Kronecker-Jacobi symbol (x|y).");
 
 static PyObject *
-GMPy_MPZ_Function_Kronecker(PyObject *self, PyObject *args)
+GMPy_MPZ_Function_Kronecker(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *tempx, *tempy;
     long res;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("kronecker() requires 'mpz','mpz' arguments");
         return NULL;
     }
     
-    tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), NULL);
-    tempy = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL);
+    tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL);
+    tempy = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL);
     if (!tempx || !tempy) {
         Py_XDECREF((PyObject*)tempx);
         Py_XDECREF((PyObject*)tempy);
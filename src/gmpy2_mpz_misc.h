@@ -39,43 +39,45 @@ static PyObject * GMPy_MPZ_Attrib_GetDenom(MPQ_Object *self, void *closure);
 static PyObject * GMPy_MPZ_Method_Ceil(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Method_Floor(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Method_Trunc(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_Method_Round(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_Method_NumDigits(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_NumDigits(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Iroot(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_IrootRem(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Bincoef(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_GCD(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_LCM(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_GCDext(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Divm(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Method_Round(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Method_NumDigits(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Function_NumDigits(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Function_Iroot(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Function_IrootRem(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Function_Bincoef(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Function_GCD(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Function_LCM(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Function_GCDext(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Function_Divm(PyObject *self, GMPY_FASTCALL_ARGS);
 static PyObject * GMPy_MPZ_Function_Fac(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_Primorial(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_DoubleFac(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_Function_MultiFac(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_MultiFac(PyObject *self, GMPY_FASTCALL_ARGS);
 static PyObject * GMPy_MPZ_Function_Fib(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_Fib2(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_Lucas(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_Lucas2(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_Isqrt(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_IsqrtRem(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_Function_Remove(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Invert(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Divexact(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_Remove(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Function_Invert(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_BatchInvert(PyObject *values, mpz_srcptr m, PyObject *out, const char *name);
+static PyObject * GMPy_MPZ_Function_BatchInvert(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Function_Divexact(PyObject *self, GMPY_FASTCALL_ARGS);
 static PyObject * GMPy_MPZ_Function_IsSquare(PyObject *self, PyObject *other);
 
-static PyObject * GMPy_MPZ_Function_IsDivisible(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_IsDivisible(PyObject *self, GMPY_FASTCALL_ARGS);
 static PyObject * GMPy_MPZ_Method_IsDivisible(PyObject *self, PyObject *other);
 
-static PyObject * GMPy_MPZ_Function_IsCongruent(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Method_IsCongruent(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_IsCongruent(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Method_IsCongruent(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_MPZ_Function_IsPower(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_Function_IsPrime(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_IsPrime(PyObject *self, GMPY_FASTCALL_ARGS);
 static PyObject * GMPy_MPZ_Function_NextPrime(PyObject *self, PyObject *other);
-static PyObject * GMPy_MPZ_Function_Jacobi(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Legendre(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_Function_Kronecker(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_Function_Jacobi(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Function_Legendre(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_Function_Kronecker(PyObject *self, GMPY_FASTCALL_ARGS);
 static PyObject * GMPy_MPZ_Function_IsEven(PyObject *self, PyObject *other);
 static PyObject * GMPy_MPZ_Function_IsOdd(PyObject *self, PyObject *other);
 static Py_ssize_t GMPy_MPZ_Method_Length(MPZ_Object *self);
@@ -45,26 +45,26 @@ PyDoc_STRVAR(doc_pack,
 "length.");
 
 static PyObject *
-GMPy_MPZ_pack(PyObject *self, PyObject *args)
+GMPy_MPZ_pack(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t nbits, total_bits, tempx_bits;
     Py_ssize_t index, lst_count, i, temp_bits, limb_count;
     PyObject *lst;
-    mpz_t temp;
+    mpz_t temp, shifted;
     MPZ_Object *result, *tempx = 0;
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("pack() requires 'list','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (nbits == -1 && PyErr_Occurred()) {
         return NULL;
     }
 
-    if (!PyList_Check(PyTuple_GET_ITEM(args, 0))) {
+    if (!PyList_Check(GMPY_ARG(0))) {
         TYPE_ERROR("pack() requires 'list','int' arguments");
         return NULL;
     }
@@ -72,7 +72,7 @@ GMPy_MPZ_pack(PyObject *self, PyObject *args)
     if (!(result = GMPy_MPZ_New(context)))
         return NULL;
 
-    lst = PyTuple_GET_ITEM(args, 0);
+    lst = GMPY_ARG(0);
     lst_count = PyList_GET_SIZE(lst);
     total_bits = nbits * lst_count;
 
@@ -85,6 +85,7 @@ GMPy_MPZ_pack(PyObject *self, PyObject *args)
     mpz_setbit(result->z, total_bits + (mp_bits_per_limb * 2));
 
     mpz_inoc(temp);
+    mpz_inoc(shifted);
     mpz_set_ui(temp, 0);
     limb_count = 0;
     tempx_bits = 0;
@@ -95,12 +96,13 @@ GMPy_MPZ_pack(PyObject *self, PyObject *args)
             || (mpz_sizeinbase(tempx->z,2) > (size_t)nbits)) {
             TYPE_ERROR("pack() requires list elements be positive integers < 2^n bits");
             mpz_cloc(temp);
+            mpz_cloc(shifted);
             Py_XDECREF((PyObject*)tempx);
             Py_DECREF((PyObject*)result);
             return NULL;
         }
-        mpz_mul_2exp(tempx->z, tempx->z, tempx_bits);
-        mpz_add(temp, temp, tempx->z);
+        mpz_mul_2exp(shifted, tempx->z, tempx_bits);
+        mpz_add(temp, temp, shifted);
         tempx_bits += nbits;
         i = 0;
         temp_bits = mpz_sizeinbase(temp, 2) * mpz_sgn(temp);
@@ -124,6 +126,7 @@ GMPy_MPZ_pack(PyObject *self, PyObject *args)
     result->z->_mp_d[limb_count] = mpz_getlimbn(temp, 0);
     mpz_clrbit(result->z, total_bits + (mp_bits_per_limb * 2));
     mpz_cloc(temp);
+    mpz_cloc(shifted);
     return (PyObject*)result;
 }
 
@@ -133,7 +136,7 @@ PyDoc_STRVAR(doc_unpack,
 "repeated division by 2**n. Raises error if 'x' is negative.");
 
 static PyObject *
-GMPy_MPZ_unpack(PyObject *self, PyObject *args)
+GMPy_MPZ_unpack(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     mp_bitcnt_t nbits, total_bits, guard_bit, extra_bits, temp_bits;
     Py_ssize_t index = 0, lst_count, i, lst_ptr = 0;
@@ -143,17 +146,17 @@ GMPy_MPZ_unpack(PyObject *self, PyObject *args)
     MPZ_Object *item, *tempx = NULL;
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("unpack() requires 'int','int' arguments");
         return NULL;
     }
 
-    nbits = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    nbits = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (nbits == -1 && PyErr_Occurred()) {
         return NULL;
     }
 
-    if (!(tempx = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 0), context))) {
+    if (!(tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), context))) {
         TYPE_ERROR("unpack() requires 'int','int' arguments");
         return NULL;
     }
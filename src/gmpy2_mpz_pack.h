@@ -32,8 +32,8 @@
 extern "C" {
 #endif
 
-static PyObject * GMPy_MPZ_pack(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_unpack(PyObject *self, PyObject *args);
+static PyObject * GMPy_MPZ_pack(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_unpack(PyObject *self, GMPY_FASTCALL_ARGS);
 
 #ifdef __cplusplus
 }
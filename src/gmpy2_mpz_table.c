@@ -0,0 +1,504 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpz_table.c                                                       *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* Format of an mpz table file. All header fields are little-endian.
+ *
+ * byte[0:8]:    "GMPYTBL1"
+ * byte[8]:      size of a limb in bytes (4 or 8)
+ * byte[9]:      0 => limbs are little-endian
+ *               1 => limbs are big-endian
+ * byte[10:16]:  zero
+ * byte[16:24]:  number of values n
+ * byte[24]+:    n+1 offsets of 8 bytes; offset[i] is the position of value
+ *               i in the file and offset[n] is the end of the last value
+ * each value:   limb count as a signed 8-byte integer (negative for a
+ *               negative value), followed by the limbs of the absolute
+ *               value, least significant first
+ *
+ * Every value starts on an 8-byte boundary. When the table is read on a
+ * machine with the same limb format, mpz_import() copies the limbs with
+ * a single memcpy.
+ */
+
+#define GMPY_TABLE_MAGIC "GMPYTBL1"
+#define GMPY_TABLE_HEADER 24
+#define GMPY_TABLE_CHUNK 65536
+
+static void
+GMPy_Table_Put64(unsigned char *buffer, PY_LONG_LONG value)
+{
+    unsigned PY_LONG_LONG temp = (unsigned PY_LONG_LONG)value;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        buffer[i] = (unsigned char)(temp & 0xff);
+        temp >>= 8;
+    }
+}
+
+static PY_LONG_LONG
+GMPy_Table_Get64(const unsigned char *buffer)
+{
+    unsigned PY_LONG_LONG temp = 0;
+    int i;
+
+    for (i = 7; i >= 0; i--) {
+        temp = (temp << 8) | buffer[i];
+    }
+    return (PY_LONG_LONG)temp;
+}
+
+/* Output is collected in a buffer of GMPY_TABLE_CHUNK bytes and passed to
+ * file.write() whenever it fills up.
+ */
+
+typedef struct {
+    PyObject *file;
+    unsigned char *buffer;
+    size_t used;
+} GMPy_Table_Writer;
+
+static int
+GMPy_Table_Flush(GMPy_Table_Writer *writer)
+{
+    PyObject *temp, *result;
+
+    if (writer->used == 0)
+        return 0;
+
+    if (!(temp = PyBytes_FromStringAndSize((char*)writer->buffer, writer->used)))
+        return -1;
+    result = PyObject_CallMethod(writer->file, "write", "(O)", temp);
+    Py_DECREF(temp);
+    if (!result)
+        return -1;
+    Py_DECREF(result);
+    writer->used = 0;
+    return 0;
+}
+
+static int
+GMPy_Table_Write(GMPy_Table_Writer *writer, const void *data, size_t size)
+{
+    const unsigned char *cp = (const unsigned char*)data;
+    size_t n;
+
+    while (size > 0) {
+        if (writer->used == GMPY_TABLE_CHUNK && GMPy_Table_Flush(writer) < 0)
+            return -1;
+        n = GMPY_TABLE_CHUNK - writer->used;
+        if (n > size)
+            n = size;
+        memcpy(writer->buffer + writer->used, cp, n);
+        writer->used += n;
+        cp += n;
+        size -= n;
+    }
+    return 0;
+}
+
+/* Bytes used by a value, including its count and the padding. */
+
+static size_t
+GMPy_Table_Value_Size(mpz_srcptr z)
+{
+    return 8 + ((mpz_size(z) * sizeof(mp_limb_t) + 7) & ~(size_t)7);
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_write_table,
+"write_mpz_table(file, iterable) -> int\n\n"
+"Write the integers in iterable to file, which must be opened in binary\n"
+"mode, in a format that MPZTable() can memory-map. Returns the number\n"
+"of values written.");
+
+static PyObject *
+GMPy_MPZ_Function_WriteTable(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    PyObject *seq, *values = NULL, *result = NULL;
+    Py_ssize_t i, n;
+    size_t offset, padding;
+    unsigned char header[GMPY_TABLE_HEADER], temp[8];
+    static const unsigned char zeros[8] = {0};
+    GMPy_Table_Writer writer;
+    MPZ_Object *z;
+
+    if (GMPY_NARGS != 2) {
+        TYPE_ERROR("write_mpz_table() requires 2 arguments");
+        return NULL;
+    }
+
+    writer.file = GMPY_ARG(0);
+    writer.used = 0;
+    if (!(writer.buffer = PyMem_Malloc(GMPY_TABLE_CHUNK)))
+        return PyErr_NoMemory();
+
+    /* The offsets come first, so all the values are converted up front. */
+    if (!(seq = PySequence_Fast(GMPY_ARG(1), "write_mpz_table() requires an iterable")))
+        goto done;
+    n = PySequence_Fast_GET_SIZE(seq);
+    if (!(values = PyList_New(n))) {
+        Py_DECREF(seq);
+        goto done;
+    }
+    for (i = 0; i < n; i++) {
+        PyObject *item = PySequence_Fast_GET_ITEM(seq, i);
+
+        if (!IS_INTEGER(item)) {
+            TYPE_ERROR("write_mpz_table() requires integer values");
+            Py_DECREF(seq);
+            goto done;
+        }
+        if (!(z = GMPy_MPZ_From_Integer(item, NULL))) {
+            Py_DECREF(seq);
+            goto done;
+        }
+        PyList_SET_ITEM(values, i, (PyObject*)z);
+    }
+    Py_DECREF(seq);
+
+    memcpy(header, GMPY_TABLE_MAGIC, 8);
+    header[8] = (unsigned char)sizeof(mp_limb_t);
+    header[9] = GMPy_Limb_Endian() > 0 ? 1 : 0;
+    memset(header + 10, 0, 6);
+    GMPy_Table_Put64(header + 16, n);
+    if (GMPy_Table_Write(&writer, header, GMPY_TABLE_HEADER) < 0)
+        goto done;
+
+    offset = GMPY_TABLE_HEADER + 8 * ((size_t)n + 1);
+    for (i = 0; i <= n; i++) {
+        GMPy_Table_Put64(temp, (PY_LONG_LONG)offset);
+        if (GMPy_Table_Write(&writer, temp, 8) < 0)
+            goto done;
+        if (i < n)
+            offset += GMPy_Table_Value_Size(MPZ(PyList_GET_ITEM(values, i)));
+    }
+
+    for (i = 0; i < n; i++) {
+        mpz_srcptr zz = MPZ(PyList_GET_ITEM(values, i));
+
+        GMPy_Table_Put64(temp, (PY_LONG_LONG)zz->_mp_size);
+        padding = (8 - (mpz_size(zz) * sizeof(mp_limb_t)) % 8) % 8;
+        if (GMPy_Table_Write(&writer, temp, 8) < 0 ||
+            GMPy_Table_Write(&writer, zz->_mp_d, mpz_size(zz) * sizeof(mp_limb_t)) < 0 ||
+            GMPy_Table_Write(&writer, zeros, padding) < 0)
+            goto done;
+    }
+
+    if (GMPy_Table_Flush(&writer) < 0)
+        goto done;
+    result = PyIntOrLong_FromSsize_t(n);
+
+  done:
+    Py_XDECREF(values);
+    PyMem_Free(writer.buffer);
+    return result;
+}
+
+/* Open path and map it read-only with the mmap module. */
+
+static PyObject *
+GMPy_Table_Map_File(PyObject *path)
+{
+    PyObject *io = NULL, *mmap = NULL, *file = NULL, *fileno = NULL;
+    PyObject *args = NULL, *kwargs = NULL, *access = NULL, *result = NULL;
+
+    if (!(io = PyImport_ImportModule("io")) ||
+        !(mmap = PyImport_ImportModule("mmap")) ||
+        !(file = PyObject_CallMethod(io, "open", "(Os)", path, "rb")))
+        goto done;
+
+    if ((fileno = PyObject_CallMethod(file, "fileno", NULL)) &&
+        (access = PyObject_GetAttrString(mmap, "ACCESS_READ")) &&
+        (args = Py_BuildValue("(Oi)", fileno, 0)) &&
+        (kwargs = Py_BuildValue("{sO}", "access", access))) {
+        PyObject *mmap_type = PyObject_GetAttrString(mmap, "mmap");
+
+        if (mmap_type) {
+            result = PyObject_Call(mmap_type, args, kwargs);
+            Py_DECREF(mmap_type);
+        }
+    }
+
+    /* The mapping stays valid after the file is closed. */
+    if (result) {
+        PyObject *temp = PyObject_CallMethod(file, "close", NULL);
+
+        if (!temp)
+            Py_CLEAR(result);
+        Py_XDECREF(temp);
+    }
+    else {
+        PyObject *type, *value, *traceback, *temp;
+
+        PyErr_Fetch(&type, &value, &traceback);
+        temp = PyObject_CallMethod(file, "close", NULL);
+        Py_XDECREF(temp);
+        PyErr_Restore(type, value, traceback);
+    }
+
+  done:
+    Py_XDECREF(io);
+    Py_XDECREF(mmap);
+    Py_XDECREF(file);
+    Py_XDECREF(fileno);
+    Py_XDECREF(access);
+    Py_XDECREF(args);
+    Py_XDECREF(kwargs);
+    return result;
+}
+
+/* Release the data. Called by close() and on deallocation. */
+
+static void
+GMPy_MPZTable_Release(MPZTable_Object *self)
+{
+    if (!self->source)
+        return;
+#ifdef PY3
+    PyBuffer_Release(&self->view);
+#endif
+    Py_CLEAR(self->source);
+    self->data = NULL;
+    self->len = 0;
+    self->count = 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpztable_factory,
+"MPZTable(source) -> MPZTable\n\n"
+"Return a read-only sequence of the mpz values in a table written by\n"
+"write_mpz_table(). source is a file name, which is memory-mapped, or\n"
+"an object supporting the buffer protocol such as an mmap. Only the\n"
+"header is read when the table is opened; each value is imported from\n"
+"the mapping when it is accessed.");
+
+static PyObject *
+GMPy_MPZTable_Factory(PyObject *self, PyObject *other)
+{
+    MPZTable_Object *result;
+    PyObject *source;
+    PY_LONG_LONG count, first;
+    const unsigned char *cp;
+
+#ifdef PY3
+    if (PyUnicode_Check(other)) {
+#else
+    if (PyUnicode_Check(other) || PyBytes_Check(other)) {
+#endif
+        if (!(source = GMPy_Table_Map_File(other)))
+            return NULL;
+    }
+    else {
+        Py_INCREF(other);
+        source = other;
+    }
+
+    if (!(result = PyObject_New(MPZTable_Object, &MPZTable_Type))) {
+        Py_DECREF(source);
+        return NULL;
+    }
+    result->source = NULL;
+
+#ifdef PY3
+    if (PyObject_GetBuffer(source, &result->view, PyBUF_SIMPLE) < 0) {
+        Py_DECREF(source);
+        Py_DECREF((PyObject*)result);
+        return NULL;
+    }
+    result->data = (const unsigned char*)result->view.buf;
+    result->len = result->view.len;
+#else
+    {
+        const void *buf;
+
+        if (PyObject_AsReadBuffer(source, &buf, &result->len) < 0) {
+            Py_DECREF(source);
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        result->data = (const unsigned char*)buf;
+    }
+#endif
+    result->source = source;
+
+    cp = result->data;
+    if (result->len < GMPY_TABLE_HEADER + 8 ||
+        memcmp(cp, GMPY_TABLE_MAGIC, 8) != 0 ||
+        (cp[8] != 4 && cp[8] != 8) || cp[9] > 1) {
+        VALUE_ERROR("MPZTable() source is not an mpz table");
+        Py_DECREF((PyObject*)result);
+        return NULL;
+    }
+    result->limbsize = cp[8];
+    result->endian = cp[9] ? 1 : -1;
+
+    count = GMPy_Table_Get64(cp + 16);
+    if (count < 0 || count > (result->len - GMPY_TABLE_HEADER) / 8 - 1) {
+        VALUE_ERROR("MPZTable() table is truncated or corrupt");
+        Py_DECREF((PyObject*)result);
+        return NULL;
+    }
+    first = GMPY_TABLE_HEADER + 8 * (count + 1);
+    if (GMPy_Table_Get64(cp + GMPY_TABLE_HEADER) != first ||
+        GMPy_Table_Get64(cp + GMPY_TABLE_HEADER + 8 * count) > result->len) {
+        VALUE_ERROR("MPZTable() table is truncated or corrupt");
+        Py_DECREF((PyObject*)result);
+        return NULL;
+    }
+    result->count = (Py_ssize_t)count;
+    return (PyObject*)result;
+}
+
+static void
+GMPy_MPZTable_Dealloc(MPZTable_Object *self)
+{
+    GMPy_MPZTable_Release(self);
+    PyObject_Del(self);
+}
+
+static Py_ssize_t
+GMPy_MPZTable_Length_Slot(MPZTable_Object *self)
+{
+    return self->count;
+}
+
+/* Import value i. The offsets are checked here rather than when the
+ * table is opened so that opening takes constant time.
+ */
+
+static PyObject *
+GMPy_MPZTable_Item_Slot(MPZTable_Object *self, Py_ssize_t i)
+{
+    const unsigned char *cp;
+    PY_LONG_LONG start, end, limbs;
+    size_t nlimbs;
+    MPZ_Object *result;
+
+    if (!self->source) {
+        VALUE_ERROR("MPZTable is closed");
+        return NULL;
+    }
+    if (i < 0 || i >= self->count) {
+        PyErr_SetString(PyExc_IndexError, "MPZTable index out of range");
+        return NULL;
+    }
+
+    cp = self->data + GMPY_TABLE_HEADER + 8 * i;
+    start = GMPy_Table_Get64(cp);
+    end = GMPy_Table_Get64(cp + 8);
+    if (start < GMPY_TABLE_HEADER || end > self->len || end - start < 8) {
+        VALUE_ERROR("MPZTable() table is truncated or corrupt");
+        return NULL;
+    }
+
+    limbs = GMPy_Table_Get64(self->data + start);
+    if (limbs < -(end - start) || limbs > end - start ||
+        (size_t)(limbs < 0 ? -limbs : limbs) > (size_t)(end - start - 8) / self->limbsize) {
+        VALUE_ERROR("MPZTable() table is truncated or corrupt");
+        return NULL;
+    }
+    nlimbs = (size_t)(limbs < 0 ? -limbs : limbs);
+
+    if (!(result = GMPy_MPZ_NewSize((nlimbs * self->limbsize + sizeof(mp_limb_t) - 1)
+                                    / sizeof(mp_limb_t), NULL)))
+        return NULL;
+    mpz_import(result->z, nlimbs, -1, self->limbsize, self->endian, 0,
+               self->data + start + 8);
+    if (limbs < 0)
+        mpz_neg(result->z, result->z);
+    return (PyObject*)result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpztable_method_close,
+"x.close()\n\n"
+"Release the mapping. Values already read are not affected.");
+
+static PyObject *
+GMPy_MPZTable_Method_Close(PyObject *self, PyObject *other)
+{
+    GMPy_MPZTable_Release((MPZTable_Object*)self);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+GMPy_MPZTable_Repr_Slot(MPZTable_Object *self)
+{
+    if (!self->source)
+        return PyUnicode_FromString("<closed MPZTable>");
+    return PyUnicode_FromFormat("<MPZTable with %zd values>", self->count);
+}
+
+static PyMethodDef GMPy_MPZTable_methods[] =
+{
+    { "close", GMPy_MPZTable_Method_Close, METH_NOARGS, GMPy_doc_mpztable_method_close },
+    { NULL }
+};
+
+static PySequenceMethods GMPy_MPZTable_sequence_methods =
+{
+    (lenfunc) GMPy_MPZTable_Length_Slot,    /* sq_length        */
+        0,                                  /* sq_concat        */
+        0,                                  /* sq_repeat        */
+    (ssizeargfunc) GMPy_MPZTable_Item_Slot, /* sq_item          */
+};
+
+static PyTypeObject MPZTable_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                  /* ob_size          */
+#endif
+    "MPZTable",                             /* tp_name          */
+    sizeof(MPZTable_Object),                /* tp_basicsize     */
+        0,                                  /* tp_itemsize      */
+    (destructor) GMPy_MPZTable_Dealloc,     /* tp_dealloc       */
+        0,                                  /* tp_print         */
+        0,                                  /* tp_getattr       */
+        0,                                  /* tp_setattr       */
+        0,                                  /* tp_reserved      */
+    (reprfunc) GMPy_MPZTable_Repr_Slot,     /* tp_repr          */
+        0,                                  /* tp_as_number     */
+    &GMPy_MPZTable_sequence_methods,        /* tp_as_sequence   */
+        0,                                  /* tp_as_mapping    */
+        0,                                  /* tp_hash          */
+        0,                                  /* tp_call          */
+        0,                                  /* tp_str           */
+        0,                                  /* tp_getattro      */
+        0,                                  /* tp_setattro      */
+        0,                                  /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                     /* tp_flags         */
+    "Memory-mapped table of mpz values",    /* tp_doc           */
+        0,                                  /* tp_traverse      */
+        0,                                  /* tp_clear         */
+        0,                                  /* tp_richcompare   */
+        0,                                  /* tp_weaklistoffset*/
+        0,                                  /* tp_iter          */
+        0,                                  /* tp_iternext      */
+    GMPy_MPZTable_methods,                  /* tp_methods       */
+};
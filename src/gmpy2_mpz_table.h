@@ -0,0 +1,62 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpz_table.h                                                       *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_MPZ_TABLE_H
+#define GMPY_MPZ_TABLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* An MPZTable reads mpz values from a table file written by
+ * write_mpz_table(). The file is memory-mapped and a value is imported
+ * only when it is accessed.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *source;           /* mmap or other object owning the data */
+#ifdef PY3
+    Py_buffer view;
+#endif
+    const unsigned char *data;  /* start of the table */
+    Py_ssize_t len;             /* length of the table in bytes */
+    Py_ssize_t count;           /* number of values */
+    int limbsize;               /* size of a stored limb in bytes */
+    int endian;                 /* -1 for little-endian limbs, 1 for big */
+} MPZTable_Object;
+
+static PyTypeObject MPZTable_Type;
+#define MPZTable_Check(v) (((PyObject*)v)->ob_type == &MPZTable_Type)
+
+static PyObject * GMPy_MPZTable_Factory(PyObject *self, PyObject *other);
+static PyObject * GMPy_MPZ_Function_WriteTable(PyObject *self, GMPY_FASTCALL_ARGS);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
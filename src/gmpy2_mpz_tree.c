@@ -0,0 +1,443 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpz_tree.c                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+/* This file implements product trees and remainder trees. They are used to
+ * reduce a single integer modulo many moduli, and to compute the gcd of
+ * each modulus with the product of all the other moduli, in quasi-linear
+ * time. The trees are built and traversed using plain mpz_t values so the
+ * GIL can be released for the entire computation.
+ */
+
+/* Load the integers in obj into the leaves of a new product tree and
+ * initialize the remaining levels. obj can be an mpz_vector or any
+ * iterable of integers. The internal nodes are not computed until
+ * GMPy_ProdTree_Build() is called. Returns 0 on success and -1 (with an
+ * exception set) on failure; the tree must be cleared in either case.
+ */
+
+static int
+GMPy_ProdTree_FromIterable(GMPy_ProdTree *tree, PyObject *obj, const char *name)
+{
+    MPZ_Vector_Object *vec;
+    mpz_t view;
+    Py_ssize_t i, n, c;
+    int k, depth = 0;
+
+    tree->depth = 0;
+    tree->count = NULL;
+    tree->level = NULL;
+
+    if (!(vec = GMPy_MPZ_Vector_From_Iterable(obj, name)))
+        return -1;
+
+    n = vec->length;
+    if (n == 0) {
+        Py_DECREF((PyObject*)vec);
+        return 0;
+    }
+
+    for (c = n, depth = 1; c > 1; c = (c + 1) / 2)
+        depth++;
+
+    tree->count = GMPY_MALLOC(depth * sizeof(Py_ssize_t));
+    tree->level = GMPY_MALLOC(depth * sizeof(mpz_t*));
+    if (!tree->count || !tree->level) {
+        PyErr_NoMemory();
+        goto err;
+    }
+
+    /* tree->depth only counts the levels that have been initialized so
+     * GMPy_ProdTree_Clear() can be used after a partial failure.
+     */
+    for (k = 0, c = n; k < depth; k++, c = (c + 1) / 2) {
+        if (!(tree->level[k] = GMPY_MALLOC(c * sizeof(mpz_t)))) {
+            PyErr_NoMemory();
+            goto err;
+        }
+        for (i = 0; i < c; i++)
+            mpz_init(tree->level[k][i]);
+        tree->count[k] = c;
+        tree->depth++;
+    }
+
+    for (i = 0; i < n; i++) {
+        MPZ_VECTOR_VIEW(view, vec, i);
+        mpz_set(tree->level[0][i], view);
+    }
+    Py_DECREF((PyObject*)vec);
+    return 0;
+
+  err:
+    Py_DECREF((PyObject*)vec);
+    return -1;
+}
+
+/* Compute the internal nodes of the tree. The Python API is not used so
+ * this can be called without holding the GIL.
+ */
+
+static void
+GMPy_ProdTree_Build(GMPy_ProdTree *tree)
+{
+    Py_ssize_t i;
+    int k;
+
+    for (k = 1; k < tree->depth; k++) {
+        for (i = 0; i < tree->count[k]; i++) {
+            if (2 * i + 1 < tree->count[k - 1])
+                mpz_mul(tree->level[k][i], tree->level[k - 1][2 * i],
+                        tree->level[k - 1][2 * i + 1]);
+            else
+                mpz_set(tree->level[k][i], tree->level[k - 1][2 * i]);
+        }
+    }
+}
+
+/* Traverse a built product tree from the root to the leaves and store
+ * x mod leaf (or x mod leaf**2 if square is non-zero) in rem[i]. The
+ * remainders are truncated, so they have the same sign as x. The
+ * intermediate remainders are stored in work (see GMPy_ProdTree_NewWork())
+ * or, if work is NULL, the internal nodes are overwritten and only the
+ * leaves are preserved. The tree must have at least one level. The Python
+ * API is not used so this can be called without holding the GIL.
+ */
+
+static void
+GMPy_ProdTree_Remainders(GMPy_ProdTree *tree, mpz_srcptr x, int square, mpz_t *rem,
+                         mpz_t **work)
+{
+    mpz_t **store = work ? work : tree->level;
+    mpz_srcptr parent;
+    mpz_ptr dest;
+    mpz_t temp;
+    Py_ssize_t i;
+    int k;
+
+    mpz_init(temp);
+    for (k = tree->depth - 1; k >= 0; k--) {
+        for (i = 0; i < tree->count[k]; i++) {
+            parent = (k == tree->depth - 1) ? x : store[k + 1][i / 2];
+            dest = (k == 0) ? rem[i] : store[k][i];
+            if (square) {
+                mpz_mul(temp, tree->level[k][i], tree->level[k][i]);
+                mpz_tdiv_r(dest, parent, temp);
+            }
+            else {
+                mpz_tdiv_r(dest, parent, tree->level[k][i]);
+            }
+        }
+    }
+    mpz_clear(temp);
+}
+
+/* Return an array of levels with the same shape as the tree, with every
+ * value initialized to 0. Used as scratch space by
+ * GMPy_ProdTree_Remainders() when the tree must be preserved. Returns NULL
+ * (with an exception set) on failure.
+ */
+
+static mpz_t **
+GMPy_ProdTree_NewWork(GMPy_ProdTree *tree)
+{
+    mpz_t **work;
+    Py_ssize_t i;
+    int k;
+
+    if (!(work = GMPY_MALLOC((tree->depth ? tree->depth : 1) * sizeof(mpz_t*)))) {
+        PyErr_NoMemory();
+        return NULL;
+    }
+
+    for (k = 0; k < tree->depth; k++) {
+        if (!(work[k] = GMPY_MALLOC(tree->count[k] * sizeof(mpz_t)))) {
+            while (--k >= 0) {
+                for (i = 0; i < tree->count[k]; i++)
+                    mpz_clear(work[k][i]);
+                GMPY_FREE(work[k]);
+            }
+            GMPY_FREE(work);
+            PyErr_NoMemory();
+            return NULL;
+        }
+        for (i = 0; i < tree->count[k]; i++)
+            mpz_init(work[k][i]);
+    }
+    return work;
+}
+
+static void
+GMPy_ProdTree_ClearWork(GMPy_ProdTree *tree, mpz_t **work)
+{
+    Py_ssize_t i;
+    int k;
+
+    for (k = 0; k < tree->depth; k++) {
+        for (i = 0; i < tree->count[k]; i++)
+            mpz_clear(work[k][i]);
+        GMPY_FREE(work[k]);
+    }
+    GMPY_FREE(work);
+}
+
+/* Return the total size of the leaves in limbs. Used to decide if the GIL
+ * should be released.
+ */
+
+static size_t
+GMPy_ProdTree_Size(GMPy_ProdTree *tree)
+{
+    size_t size = 0;
+    Py_ssize_t i;
+
+    if (tree->depth == 0)
+        return 0;
+
+    for (i = 0; i < tree->count[0]; i++)
+        size += mpz_size(tree->level[0][i]);
+    return size;
+}
+
+static void
+GMPy_ProdTree_Clear(GMPy_ProdTree *tree)
+{
+    Py_ssize_t i;
+    int k;
+
+    for (k = 0; k < tree->depth; k++) {
+        for (i = 0; i < tree->count[k]; i++)
+            mpz_clear(tree->level[k][i]);
+        GMPY_FREE(tree->level[k]);
+    }
+    GMPY_FREE(tree->count);
+    GMPY_FREE(tree->level);
+    tree->depth = 0;
+    tree->count = NULL;
+    tree->level = NULL;
+}
+
+/* Return a list of n new mpz instances. The values in array are swapped
+ * into the new instances, so array is left with unspecified values.
+ */
+
+static PyObject *
+GMPy_MPZ_List_FromArray(mpz_t *array, Py_ssize_t n)
+{
+    PyObject *result;
+    MPZ_Object *temp;
+    Py_ssize_t i;
+
+    if (!(result = PyList_New(n)))
+        return NULL;
+
+    for (i = 0; i < n; i++) {
+        if (!(temp = GMPy_MPZ_New(NULL))) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        mpz_swap(temp->z, array[i]);
+        PyList_SET_ITEM(result, i, (PyObject*)temp);
+    }
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_prod_tree,
+"prod_tree(iterable) -> list\n\n"
+"Return the product tree of the integers in iterable as a list of\n"
+"levels. The first level contains the integers and each node of a\n"
+"level is the product of two adjacent nodes of the previous level.\n"
+"The last level contains the product of all the integers.");
+
+static PyObject *
+GMPy_MPZ_Function_ProdTree(PyObject *self, PyObject *other)
+{
+    GMPy_ProdTree tree;
+    PyObject *result = NULL, *temp;
+    int k;
+
+    if (GMPy_ProdTree_FromIterable(&tree, other, "prod_tree()") < 0)
+        goto err;
+
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(GMPy_ProdTree_Size(&tree));
+    GMPy_ProdTree_Build(&tree);
+    GMPY_MAYBE_END_ALLOW_THREADS;
+
+    if (!(result = PyList_New(tree.depth)))
+        goto err;
+
+    for (k = 0; k < tree.depth; k++) {
+        if (!(temp = GMPy_MPZ_List_FromArray(tree.level[k], tree.count[k]))) {
+            Py_CLEAR(result);
+            goto err;
+        }
+        PyList_SET_ITEM(result, k, temp);
+    }
+
+  err:
+    GMPy_ProdTree_Clear(&tree);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_batch_mod,
+"batch_mod(x, moduli) -> list\n\n"
+"Return a list containing x % m for each m in moduli. A remainder\n"
+"tree is used so the running time is quasi-linear in the total size\n"
+"of the moduli.");
+
+static PyObject *
+GMPy_MPZ_Function_BatchMod(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    GMPy_ProdTree tree;
+    MPZ_Object *tempx = NULL;
+    PyObject *result = NULL;
+    mpz_t *rem = NULL;
+    Py_ssize_t i, n = 0;
+
+    tree.depth = 0;
+    tree.count = NULL;
+    tree.level = NULL;
+
+    if (GMPY_NARGS != 2 || !IS_INTEGER(GMPY_ARG(0))) {
+        TYPE_ERROR("batch_mod() requires 'mpz','iterable' arguments");
+        return NULL;
+    }
+
+    if (!(tempx = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL)))
+        return NULL;
+
+    if (GMPy_ProdTree_FromIterable(&tree, GMPY_ARG(1), "batch_mod()") < 0)
+        goto err;
+
+    if (tree.depth == 0) {
+        result = PyList_New(0);
+        goto err;
+    }
+
+    n = tree.count[0];
+    for (i = 0; i < n; i++) {
+        if (mpz_sgn(tree.level[0][i]) == 0) {
+            ZERO_ERROR("batch_mod() division by zero");
+            goto err;
+        }
+    }
+
+    if (!(rem = GMPY_MALLOC(n * sizeof(mpz_t)))) {
+        PyErr_NoMemory();
+        goto err;
+    }
+    for (i = 0; i < n; i++)
+        mpz_init(rem[i]);
+
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(GMPy_ProdTree_Size(&tree) + mpz_size(tempx->z));
+    GMPy_ProdTree_Build(&tree);
+    GMPy_ProdTree_Remainders(&tree, tempx->z, 0, rem, NULL);
+
+    /* Convert the truncated remainders to floor remainders. */
+    for (i = 0; i < n; i++) {
+        if (mpz_sgn(rem[i]) != 0 && mpz_sgn(rem[i]) != mpz_sgn(tree.level[0][i]))
+            mpz_add(rem[i], rem[i], tree.level[0][i]);
+    }
+    GMPY_MAYBE_END_ALLOW_THREADS;
+
+    result = GMPy_MPZ_List_FromArray(rem, n);
+
+  err:
+    if (rem) {
+        for (i = 0; i < n; i++)
+            mpz_clear(rem[i]);
+        GMPY_FREE(rem);
+    }
+    GMPy_ProdTree_Clear(&tree);
+    Py_DECREF((PyObject*)tempx);
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_function_batch_gcd,
+"batch_gcd(moduli) -> list\n\n"
+"Return a list containing gcd(m, P/m) for each m in moduli, where P\n"
+"is the product of all the moduli. A non-trivial result identifies a\n"
+"modulus that shares a factor with another modulus. Uses Bernstein's\n"
+"product and remainder tree algorithm.");
+
+static PyObject *
+GMPy_MPZ_Function_BatchGCD(PyObject *self, PyObject *other)
+{
+    GMPy_ProdTree tree;
+    PyObject *result = NULL;
+    mpz_t *rem = NULL;
+    mpz_t product;
+    Py_ssize_t i, n = 0;
+
+    if (GMPy_ProdTree_FromIterable(&tree, other, "batch_gcd()") < 0)
+        goto err;
+
+    if (tree.depth == 0) {
+        result = PyList_New(0);
+        goto err;
+    }
+
+    n = tree.count[0];
+    for (i = 0; i < n; i++) {
+        if (mpz_sgn(tree.level[0][i]) == 0) {
+            VALUE_ERROR("batch_gcd() requires nonzero integers");
+            goto err;
+        }
+        mpz_abs(tree.level[0][i], tree.level[0][i]);
+    }
+
+    if (!(rem = GMPY_MALLOC(n * sizeof(mpz_t)))) {
+        PyErr_NoMemory();
+        goto err;
+    }
+    for (i = 0; i < n; i++)
+        mpz_init(rem[i]);
+
+    /* Reduce the product of all the moduli modulo the square of each
+     * modulus. If P mod m**2 = r then r/m = (P/m) mod m.
+     */
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(GMPy_ProdTree_Size(&tree));
+    GMPy_ProdTree_Build(&tree);
+    mpz_init_set(product, tree.level[tree.depth - 1][0]);
+    GMPy_ProdTree_Remainders(&tree, product, 1, rem, NULL);
+    mpz_clear(product);
+    for (i = 0; i < n; i++) {
+        mpz_divexact(rem[i], rem[i], tree.level[0][i]);
+        mpz_gcd(rem[i], rem[i], tree.level[0][i]);
+    }
+    GMPY_MAYBE_END_ALLOW_THREADS;
+
+    result = GMPy_MPZ_List_FromArray(rem, n);
+
+  err:
+    if (rem) {
+        for (i = 0; i < n; i++)
+            mpz_clear(rem[i]);
+        GMPY_FREE(rem);
+    }
+    GMPy_ProdTree_Clear(&tree);
+    return result;
+}
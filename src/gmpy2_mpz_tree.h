@@ -0,0 +1,65 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpz_tree.h                                                        *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+
+#ifndef GMPY_MPZ_TREE_H
+#define GMPY_MPZ_TREE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A product tree is stored as an array of levels. Level 0 contains the
+ * leaves. Each node on level k+1 is the product of two adjacent nodes on
+ * level k; an odd node at the end of a level is copied unchanged. The last
+ * level contains a single node equal to the product of all the leaves.
+ */
+
+typedef struct {
+    int depth;              /* number of levels */
+    Py_ssize_t *count;      /* number of nodes on each level */
+    mpz_t **level;          /* nodes on each level */
+} GMPy_ProdTree;
+
+static int         GMPy_ProdTree_FromIterable(GMPy_ProdTree *tree, PyObject *obj, const char *name);
+static void        GMPy_ProdTree_Build(GMPy_ProdTree *tree);
+static void        GMPy_ProdTree_Remainders(GMPy_ProdTree *tree, mpz_srcptr x, int square,
+                                            mpz_t *rem, mpz_t **work);
+static mpz_t **     GMPy_ProdTree_NewWork(GMPy_ProdTree *tree);
+static void        GMPy_ProdTree_ClearWork(GMPy_ProdTree *tree, mpz_t **work);
+static size_t      GMPy_ProdTree_Size(GMPy_ProdTree *tree);
+static void        GMPy_ProdTree_Clear(GMPy_ProdTree *tree);
+static PyObject *  GMPy_MPZ_List_FromArray(mpz_t *array, Py_ssize_t n);
+
+static PyObject *  GMPy_MPZ_Function_ProdTree(PyObject *self, PyObject *other);
+static PyObject *  GMPy_MPZ_Function_BatchMod(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject *  GMPy_MPZ_Function_BatchGCD(PyObject *self, PyObject *other);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
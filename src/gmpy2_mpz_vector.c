@@ -0,0 +1,601 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpz_vector.c                                                      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* This file implements the mpz_vector type. An mpz_vector is an immutable
+ * sequence of integers that stores the limbs of all the elements in a
+ * single buffer. Arithmetic is applied element-wise in a single C loop
+ * using read-only mpz_t views of the elements.
+ */
+
+PyDoc_STRVAR(GMPy_doc_mpz_vector_factory,
+"mpz_vector(iterable=()) -> mpz_vector\n\n"
+"Return an immutable vector of integers. The operators +, -, *, %,\n"
+"<<, and >> are applied element-wise. The other operand can be an\n"
+"integer or an mpz_vector of the same length. Indexing returns an\n"
+"mpz.");
+
+/* Element-wise operations supported by GMPy_MPZ_Vector_Apply(). */
+
+#define GMPY_VECTOR_ADD     0
+#define GMPY_VECTOR_SUB     1
+#define GMPY_VECTOR_MUL     2
+#define GMPY_VECTOR_MOD     3
+#define GMPY_VECTOR_LSHIFT  4
+#define GMPY_VECTOR_RSHIFT  5
+#define GMPY_VECTOR_POWMOD  6
+
+/* Create an empty vector with room for length elements and limbs limbs. */
+
+static MPZ_Vector_Object *
+GMPy_MPZ_Vector_New(Py_ssize_t length, size_t limbs)
+{
+    MPZ_Vector_Object *result;
+
+    if (!(result = PyObject_New(MPZ_Vector_Object, &MPZ_Vector_Type)))
+        return NULL;
+
+    result->length = 0;
+    result->allocated = (length > 0) ? length : 1;
+    result->limbs_used = 0;
+    result->limbs_alloc = (limbs > 0) ? limbs : 1;
+    result->offset = GMPY_MALLOC(result->allocated * sizeof(size_t));
+    result->size = GMPY_MALLOC(result->allocated * sizeof(mp_size_t));
+    result->limbs = GMPY_MALLOC(result->limbs_alloc * sizeof(mp_limb_t));
+
+    if (!result->offset || !result->size || !result->limbs) {
+        Py_DECREF((PyObject*)result);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    return result;
+}
+
+static void
+GMPy_MPZ_Vector_Dealloc(MPZ_Vector_Object *self)
+{
+    GMPY_FREE(self->offset);
+    GMPY_FREE(self->size);
+    GMPY_FREE(self->limbs);
+    PyObject_Del(self);
+}
+
+/* Append a copy of z to the end of the vector. Returns 0 on success and -1
+ * (with an exception set) on failure.
+ */
+
+static int
+GMPy_MPZ_Vector_Append(MPZ_Vector_Object *self, mpz_srcptr z)
+{
+    size_t n = mpz_size(z);
+
+    if (self->length == self->allocated) {
+        Py_ssize_t newalloc = self->allocated + (self->allocated >> 1) + 4;
+        size_t *newoffset;
+        mp_size_t *newsize;
+
+        if (!(newoffset = GMPY_REALLOC(self->offset, newalloc * sizeof(size_t)))) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        self->offset = newoffset;
+
+        if (!(newsize = GMPY_REALLOC(self->size, newalloc * sizeof(mp_size_t)))) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        self->size = newsize;
+        self->allocated = newalloc;
+    }
+
+    if (self->limbs_used + n > self->limbs_alloc) {
+        size_t newalloc = self->limbs_alloc + (self->limbs_alloc >> 1);
+        mp_limb_t *newlimbs;
+
+        if (newalloc < self->limbs_used + n)
+            newalloc = self->limbs_used + n;
+
+        if (!(newlimbs = GMPY_REALLOC(self->limbs, newalloc * sizeof(mp_limb_t)))) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        self->limbs = newlimbs;
+        self->limbs_alloc = newalloc;
+    }
+
+    if (n)
+        memcpy(self->limbs + self->limbs_used, z->_mp_d, n * sizeof(mp_limb_t));
+    self->offset[self->length] = self->limbs_used;
+    self->size[self->length] = z->_mp_size;
+    self->limbs_used += n;
+    self->length++;
+    return 0;
+}
+
+/* Return a new mpz_vector containing the integers in obj. If obj is already
+ * an mpz_vector, a new reference to obj is returned. name is used in the
+ * error message if obj is not an iterable of integers.
+ */
+
+static MPZ_Vector_Object *
+GMPy_MPZ_Vector_From_Iterable(PyObject *obj, const char *name)
+{
+    MPZ_Vector_Object *result;
+    MPZ_Object *temp;
+    PyObject *seq, *item;
+    Py_ssize_t i, n;
+
+    /* mpz_vector is immutable so just return a new reference. */
+    if (MPZ_Vector_Check(obj)) {
+        Py_INCREF(obj);
+        return (MPZ_Vector_Object*)obj;
+    }
+
+    if (!(seq = PySequence_Fast(obj, ""))) {
+        if (PyErr_ExceptionMatches(PyExc_TypeError)) {
+            PyErr_Format(PyExc_TypeError,
+                         "%s requires an iterable argument", name);
+        }
+        return NULL;
+    }
+
+    n = PySequence_Fast_GET_SIZE(seq);
+    if (!(result = GMPy_MPZ_Vector_New(n, n))) {
+        Py_DECREF(seq);
+        return NULL;
+    }
+
+    for (i = 0; i < n; i++) {
+        item = PySequence_Fast_GET_ITEM(seq, i);
+        if (CHECK_MPZANY(item)) {
+            if (GMPy_MPZ_Vector_Append(result, MPZ(item)) < 0)
+                goto err;
+        }
+        else if (IS_INTEGER(item)) {
+            if (!(temp = GMPy_MPZ_From_Integer(item, NULL)))
+                goto err;
+            if (GMPy_MPZ_Vector_Append(result, temp->z) < 0) {
+                Py_DECREF((PyObject*)temp);
+                goto err;
+            }
+            Py_DECREF((PyObject*)temp);
+        }
+        else {
+            PyErr_Format(PyExc_TypeError,
+                         "%s requires integer elements", name);
+            goto err;
+        }
+    }
+    Py_DECREF(seq);
+    return result;
+
+  err:
+    Py_DECREF(seq);
+    Py_DECREF((PyObject*)result);
+    return NULL;
+}
+
+/* Return a list containing a new mpz for each element of the vector. */
+
+static PyObject *
+GMPy_MPZ_Vector_To_List(MPZ_Vector_Object *self)
+{
+    PyObject *result;
+    MPZ_Object *temp;
+    mpz_t view;
+    Py_ssize_t i;
+
+    if (!(result = PyList_New(self->length)))
+        return NULL;
+
+    for (i = 0; i < self->length; i++) {
+        if (!(temp = GMPy_MPZ_New(NULL))) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        MPZ_VECTOR_VIEW(view, self, i);
+        mpz_set(temp->z, view);
+        PyList_SET_ITEM(result, i, (PyObject*)temp);
+    }
+    return result;
+}
+
+static PyObject *
+GMPy_MPZ_Vector_Factory(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    if (GMPY_NARGS == 0)
+        return (PyObject*)GMPy_MPZ_Vector_New(0, 0);
+
+    if (GMPY_NARGS != 1) {
+        TYPE_ERROR("mpz_vector() requires 0 or 1 arguments");
+        return NULL;
+    }
+
+    return (PyObject*)GMPy_MPZ_Vector_From_Iterable(GMPY_ARG(0), "mpz_vector()");
+}
+
+/* Apply op element-wise to nops operands. Each operand can be either an
+ * mpz_vector or an integer; at least one must be an mpz_vector. Returns
+ * NotImplemented if an operand is not supported.
+ */
+
+static PyObject *
+GMPy_MPZ_Vector_Apply(int op, int nops, PyObject *x, PyObject *y, PyObject *z)
+{
+    PyObject *args[3];
+    MPZ_Vector_Object *vec[3] = {NULL, NULL, NULL}, *result = NULL;
+    MPZ_Object *temp[3] = {NULL, NULL, NULL};
+    mpz_srcptr p[3] = {NULL, NULL, NULL};
+    mpz_t view[3], t, u, w;
+    Py_ssize_t i, n = -1;
+    int j;
+
+    args[0] = x; args[1] = y; args[2] = z;
+
+    for (j = 0; j < nops; j++) {
+        if (MPZ_Vector_Check(args[j])) {
+            vec[j] = (MPZ_Vector_Object*)args[j];
+            if (n >= 0 && vec[j]->length != n) {
+                VALUE_ERROR("mpz_vector lengths must be equal");
+                goto err;
+            }
+            n = vec[j]->length;
+        }
+        else if (IS_INTEGER(args[j])) {
+            if (!(temp[j] = GMPy_MPZ_From_Integer(args[j], NULL)))
+                goto err;
+            p[j] = temp[j]->z;
+        }
+        else {
+            for (j = 0; j < 3; j++)
+                Py_XDECREF((PyObject*)temp[j]);
+            Py_RETURN_NOTIMPLEMENTED;
+        }
+    }
+
+    /* Assume the result has the same size as the first vector operand. */
+    for (j = 0; j < nops && !vec[j]; j++);
+    if (!(result = GMPy_MPZ_Vector_New(n, vec[j]->limbs_used)))
+        goto err;
+
+    mpz_inoc(t);
+    mpz_inoc(u);
+    mpz_inoc(w);
+
+    for (i = 0; i < n; i++) {
+        for (j = 0; j < nops; j++) {
+            if (vec[j]) {
+                MPZ_VECTOR_VIEW(view[j], vec[j], i);
+                p[j] = view[j];
+            }
+        }
+
+        switch (op) {
+        case GMPY_VECTOR_ADD:
+            mpz_add(t, p[0], p[1]);
+            break;
+        case GMPY_VECTOR_SUB:
+            mpz_sub(t, p[0], p[1]);
+            break;
+        case GMPY_VECTOR_MUL:
+            mpz_mul(t, p[0], p[1]);
+            break;
+        case GMPY_VECTOR_MOD:
+            if (mpz_sgn(p[1]) == 0) {
+                ZERO_ERROR("division or modulo by zero");
+                goto err_temps;
+            }
+            mpz_fdiv_r(t, p[0], p[1]);
+            break;
+        case GMPY_VECTOR_LSHIFT:
+        case GMPY_VECTOR_RSHIFT:
+            if (mpz_sgn(p[1]) < 0) {
+                VALUE_ERROR("negative shift count");
+                goto err_temps;
+            }
+            if (!mpz_fits_ulong_p(p[1])) {
+                OVERFLOW_ERROR("outrageous shift count");
+                goto err_temps;
+            }
+            if (op == GMPY_VECTOR_LSHIFT)
+                mpz_mul_2exp(t, p[0], mpz_get_ui(p[1]));
+            else
+                mpz_fdiv_q_2exp(t, p[0], mpz_get_ui(p[1]));
+            break;
+        case GMPY_VECTOR_POWMOD:
+            if (mpz_sgn(p[2]) == 0) {
+                VALUE_ERROR("powmod() 3rd argument cannot be 0");
+                goto err_temps;
+            }
+            mpz_abs(u, p[2]);
+            if (mpz_sgn(p[1]) < 0) {
+                if (!mpz_invert(t, p[0], u)) {
+                    VALUE_ERROR("powmod() base not invertible");
+                    goto err_temps;
+                }
+                mpz_abs(w, p[1]);
+                mpz_powm(t, t, w, u);
+            }
+            else {
+                mpz_powm(t, p[0], p[1], u);
+            }
+            /* Use Python's convention for a negative modulus. */
+            if ((mpz_sgn(p[2]) < 0) && (mpz_sgn(t) > 0))
+                mpz_add(t, t, p[2]);
+            break;
+        }
+
+        if (GMPy_MPZ_Vector_Append(result, t) < 0)
+            goto err_temps;
+    }
+
+    mpz_cloc(t);
+    mpz_cloc(u);
+    mpz_cloc(w);
+    for (j = 0; j < 3; j++)
+        Py_XDECREF((PyObject*)temp[j]);
+    return (PyObject*)result;
+
+  err_temps:
+    mpz_cloc(t);
+    mpz_cloc(u);
+    mpz_cloc(w);
+  err:
+    for (j = 0; j < 3; j++)
+            Py_XDECREF((PyObject*)temp[j]);
+    Py_XDECREF((PyObject*)result);
+    return NULL;
+}
+
+static PyObject *
+GMPy_MPZ_Vector_Add_Slot(PyObject *x, PyObject *y)
+{
+    return GMPy_MPZ_Vector_Apply(GMPY_VECTOR_ADD, 2, x, y, NULL);
+}
+
+static PyObject *
+GMPy_MPZ_Vector_Sub_Slot(PyObject *x, PyObject *y)
+{
+    return GMPy_MPZ_Vector_Apply(GMPY_VECTOR_SUB, 2, x, y, NULL);
+}
+
+static PyObject *
+GMPy_MPZ_Vector_Mul_Slot(PyObject *x, PyObject *y)
+{
+    return GMPy_MPZ_Vector_Apply(GMPY_VECTOR_MUL, 2, x, y, NULL);
+}
+
+static PyObject *
+GMPy_MPZ_Vector_Mod_Slot(PyObject *x, PyObject *y)
+{
+    return GMPy_MPZ_Vector_Apply(GMPY_VECTOR_MOD, 2, x, y, NULL);
+}
+
+static PyObject *
+GMPy_MPZ_Vector_Lshift_Slot(PyObject *x, PyObject *y)
+{
+    return GMPy_MPZ_Vector_Apply(GMPY_VECTOR_LSHIFT, 2, x, y, NULL);
+}
+
+static PyObject *
+GMPy_MPZ_Vector_Rshift_Slot(PyObject *x, PyObject *y)
+{
+    return GMPy_MPZ_Vector_Apply(GMPY_VECTOR_RSHIFT, 2, x, y, NULL);
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_vector_method_powmod,
+"x.powmod(y, m) -> mpz_vector\n\n"
+"Return an mpz_vector containing powmod(x[i], y, m) for each element\n"
+"of x. y and m can be integers or mpz_vectors with the same length\n"
+"as x.");
+
+static PyObject *
+GMPy_MPZ_Vector_Method_PowMod(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    PyObject *result;
+
+    if (GMPY_NARGS != 2) {
+        TYPE_ERROR("powmod() requires 2 arguments");
+        return NULL;
+    }
+
+    result = GMPy_MPZ_Vector_Apply(GMPY_VECTOR_POWMOD, 3, self,
+                                   GMPY_ARG(0), GMPY_ARG(1));
+    if (result == Py_NotImplemented) {
+        Py_DECREF(result);
+        TYPE_ERROR("powmod() argument types not supported");
+        return NULL;
+    }
+    return result;
+}
+
+PyDoc_STRVAR(GMPy_doc_mpz_vector_method_sizeof,
+"x.__sizeof__() -> int\n\n"
+"Returns the amount of memory consumed by x.");
+
+static PyObject *
+GMPy_MPZ_Vector_Method_SizeOf(PyObject *self, PyObject *other)
+{
+    MPZ_Vector_Object *v = (MPZ_Vector_Object*)self;
+
+    return PyIntOrLong_FromSize_t(sizeof(MPZ_Vector_Object) + \
+        v->allocated * (sizeof(size_t) + sizeof(mp_size_t)) + \
+        v->limbs_alloc * sizeof(mp_limb_t));
+}
+
+static Py_ssize_t
+GMPy_MPZ_Vector_Length_Slot(MPZ_Vector_Object *self)
+{
+    return self->length;
+}
+
+static PyObject *
+GMPy_MPZ_Vector_Item_Slot(MPZ_Vector_Object *self, Py_ssize_t i)
+{
+    MPZ_Object *result;
+    mpz_t view;
+
+    if (i < 0 || i >= self->length) {
+        INDEX_ERROR("mpz_vector index out of range");
+        return NULL;
+    }
+
+    if ((result = GMPy_MPZ_New(NULL))) {
+        MPZ_VECTOR_VIEW(view, self, i);
+        mpz_set(result->z, view);
+    }
+    return (PyObject*)result;
+}
+
+static PyObject *
+GMPy_MPZ_Vector_Repr_Slot(MPZ_Vector_Object *self)
+{
+    PyObject *list = NULL, *sep = NULL, *body = NULL, *result = NULL;
+    PyObject *item;
+    Py_ssize_t i;
+
+    if (!(list = PyList_New(self->length)))
+        return NULL;
+
+    for (i = 0; i < self->length; i++) {
+        if (!(item = GMPy_MPZ_Vector_Item_Slot(self, i)))
+            goto done;
+        PyList_SET_ITEM(list, i, PyObject_Str(item));
+        Py_DECREF(item);
+        if (!PyList_GET_ITEM(list, i))
+            goto done;
+    }
+
+    if (!(sep = Py2or3String_FromString(", ")))
+        goto done;
+    if (!(body = PyObject_CallMethod(sep, "join", "O", list)))
+        goto done;
+
+#ifdef PY3
+    result = PyUnicode_FromFormat("mpz_vector([%U])", body);
+#else
+    result = PyString_FromFormat("mpz_vector([%s])", PyString_AS_STRING(body));
+#endif
+
+  done:
+    Py_XDECREF(list);
+    Py_XDECREF(sep);
+    Py_XDECREF(body);
+    return result;
+}
+
+#ifdef PY3
+static PyNumberMethods GMPy_MPZ_Vector_number_methods =
+{
+    (binaryfunc) GMPy_MPZ_Vector_Add_Slot,    /* nb_add                  */
+    (binaryfunc) GMPy_MPZ_Vector_Sub_Slot,    /* nb_subtract             */
+    (binaryfunc) GMPy_MPZ_Vector_Mul_Slot,    /* nb_multiply             */
+    (binaryfunc) GMPy_MPZ_Vector_Mod_Slot,    /* nb_remainder            */
+        0,                                    /* nb_divmod               */
+        0,                                    /* nb_power                */
+        0,                                    /* nb_negative             */
+        0,                                    /* nb_positive             */
+        0,                                    /* nb_absolute             */
+        0,                                    /* nb_bool                 */
+        0,                                    /* nb_invert               */
+    (binaryfunc) GMPy_MPZ_Vector_Lshift_Slot, /* nb_lshift               */
+    (binaryfunc) GMPy_MPZ_Vector_Rshift_Slot, /* nb_rshift               */
+};
+#else
+static PyNumberMethods GMPy_MPZ_Vector_number_methods =
+{
+    (binaryfunc) GMPy_MPZ_Vector_Add_Slot,    /* nb_add                  */
+    (binaryfunc) GMPy_MPZ_Vector_Sub_Slot,    /* nb_subtract             */
+    (binaryfunc) GMPy_MPZ_Vector_Mul_Slot,    /* nb_multiply             */
+        0,                                    /* nb_divide               */
+    (binaryfunc) GMPy_MPZ_Vector_Mod_Slot,    /* nb_remainder            */
+        0,                                    /* nb_divmod               */
+        0,                                    /* nb_power                */
+        0,                                    /* nb_negative             */
+        0,                                    /* nb_positive             */
+        0,                                    /* nb_absolute             */
+        0,                                    /* nb_nonzero              */
+        0,                                    /* nb_invert               */
+    (binaryfunc) GMPy_MPZ_Vector_Lshift_Slot, /* nb_lshift               */
+    (binaryfunc) GMPy_MPZ_Vector_Rshift_Slot, /* nb_rshift               */
+};
+#endif
+
+static PySequenceMethods GMPy_MPZ_Vector_sequence_methods =
+{
+    (lenfunc) GMPy_MPZ_Vector_Length_Slot,    /* sq_length               */
+        0,                                    /* sq_concat               */
+        0,                                    /* sq_repeat               */
+    (ssizeargfunc) GMPy_MPZ_Vector_Item_Slot, /* sq_item                 */
+};
+
+static PyMethodDef GMPy_MPZ_Vector_methods [] =
+{
+    { "__sizeof__", GMPy_MPZ_Vector_Method_SizeOf, METH_NOARGS, GMPy_doc_mpz_vector_method_sizeof },
+    { "powmod", (PyCFunction)GMPy_MPZ_Vector_Method_PowMod, GMPY_METH_FASTCALL, GMPy_doc_mpz_vector_method_powmod },
+    { NULL, NULL, 1 }
+};
+
+static PyTypeObject MPZ_Vector_Type =
+{
+#ifdef PY3
+    PyVarObject_HEAD_INIT(0, 0)
+#else
+    PyObject_HEAD_INIT(0)
+        0,                                  /* ob_size          */
+#endif
+    "mpz_vector",                           /* tp_name          */
+    sizeof(MPZ_Vector_Object),              /* tp_basicsize     */
+        0,                                  /* tp_itemsize      */
+    (destructor) GMPy_MPZ_Vector_Dealloc,   /* tp_dealloc       */
+        0,                                  /* tp_print         */
+        0,                                  /* tp_getattr       */
+        0,                                  /* tp_setattr       */
+        0,                                  /* tp_reserved      */
+    (reprfunc) GMPy_MPZ_Vector_Repr_Slot,   /* tp_repr          */
+    &GMPy_MPZ_Vector_number_methods,        /* tp_as_number     */
+    &GMPy_MPZ_Vector_sequence_methods,      /* tp_as_sequence   */
+        0,                                  /* tp_as_mapping    */
+        0,                                  /* tp_hash          */
+        0,                                  /* tp_call          */
+        0,                                  /* tp_str           */
+        0,                                  /* tp_getattro      */
+        0,                                  /* tp_setattro      */
+        0,                                  /* tp_as_buffer     */
+#ifdef PY3
+    Py_TPFLAGS_DEFAULT,                     /* tp_flags         */
+#else
+    Py_TPFLAGS_DEFAULT|Py_TPFLAGS_CHECKTYPES, /* tp_flags       */
+#endif
+    "Vector of multiple precision integers", /* tp_doc          */
+        0,                                  /* tp_traverse      */
+        0,                                  /* tp_clear         */
+        0,                                  /* tp_richcompare   */
+        0,                                  /* tp_weaklistoffset*/
+        0,                                  /* tp_iter          */
+        0,                                  /* tp_iternext      */
+    GMPy_MPZ_Vector_methods,                /* tp_methods       */
+};
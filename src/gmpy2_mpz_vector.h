@@ -0,0 +1,76 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_mpz_vector.h                                                      *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_MPZ_VECTOR_H
+#define GMPY_MPZ_VECTOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* An mpz_vector stores the limbs of all its elements in a single
+ * contiguous buffer. Element i uses the limbs starting at limbs[offset[i]]
+ * and size[i] has the same meaning as the _mp_size field of an mpz_t: the
+ * absolute value is the number of limbs and the sign is the sign of the
+ * value. An mpz_vector is immutable.
+ */
+
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t length;       /* number of elements */
+    Py_ssize_t allocated;    /* number of elements in offset and size */
+    mp_limb_t *limbs;        /* limbs of all the elements */
+    size_t limbs_used;       /* number of limbs in use */
+    size_t limbs_alloc;      /* number of limbs allocated */
+    size_t *offset;          /* offset of each element in limbs */
+    mp_size_t *size;         /* signed size of each element */
+} MPZ_Vector_Object;
+
+static PyTypeObject MPZ_Vector_Type;
+#define MPZ_Vector_Check(v) (((PyObject*)v)->ob_type == &MPZ_Vector_Type)
+
+/* Initialize a read-only mpz_t that refers to element i of the vector V.
+ * The mpz_t must not be modified or cleared. This is equivalent to
+ * mpz_roinit_n() but also works with older versions of GMP and MPIR.
+ */
+#define MPZ_VECTOR_VIEW(Z, V, I) \
+    { \
+        (Z)->_mp_size = (V)->size[I]; \
+        (Z)->_mp_alloc = (int)((V)->size[I] < 0 ? -(V)->size[I] : (V)->size[I]); \
+        (Z)->_mp_d = (V)->limbs + (V)->offset[I]; \
+    }
+
+static MPZ_Vector_Object * GMPy_MPZ_Vector_New(Py_ssize_t length, size_t limbs);
+static int                 GMPy_MPZ_Vector_Append(MPZ_Vector_Object *self, mpz_srcptr z);
+static MPZ_Vector_Object * GMPy_MPZ_Vector_From_Iterable(PyObject *obj, const char *name);
+static PyObject *          GMPy_MPZ_Vector_To_List(MPZ_Vector_Object *self);
+static PyObject *          GMPy_MPZ_Vector_Factory(PyObject *self, GMPY_FASTCALL_ARGS);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -58,8 +58,14 @@ static PyObject *
 GMPy_Integer_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
 {
     MPZ_Object *result;
+    long a, b, r;
 
-    if (!(result = GMPy_MPZ_New(context)))
+    if (GMPy_Integer_AsWord(x, &a) && GMPy_Integer_AsWord(y, &b) &&
+        !GMPY_MUL_OVERFLOW(a, b, &r)) {
+        return (PyObject*)GMPy_MPZ_From_SI(r, context);
+    }
+
+    if (!(result = GMPy_MPZ_NewSize(GMPY_MPZ_SIZE(x) + GMPY_MPZ_SIZE(y), context)))
         return NULL;
 
     if (CHECK_MPZANY(x)) {
@@ -81,7 +87,9 @@ GMPy_Integer_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
         }
 
         if (CHECK_MPZANY(y)) {
+            GMPY_MAYBE_BEGIN_ALLOW_THREADS(GMPY_GIL_SIZE(x, y));
             mpz_mul(result->z, MPZ(x), MPZ(y));
+            GMPY_MAYBE_END_ALLOW_THREADS;
             return (PyObject*)result;
         }
     }
@@ -117,7 +125,9 @@ GMPy_Integer_Mul(PyObject *x, PyObject *y, CTXT_Object *context)
             return NULL;
         }
 
+        GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempx->z) + mpz_size(tempy->z));
         mpz_mul(result->z, tempx->z, tempy->z);
+        GMPY_MAYBE_END_ALLOW_THREADS;
         Py_DECREF((PyObject*)tempx);
         Py_DECREF((PyObject*)tempy);
         return (PyObject*)result;
@@ -137,9 +147,17 @@ GMPy_MPZ_Mul_Slot(PyObject *x, PyObject *y)
 {
     if (CHECK_MPZANY(x) && CHECK_MPZANY(y)) {
         MPZ_Object *result;
+        long a, b, r;
+
+        if (GMPy_Integer_AsWord(x, &a) && GMPy_Integer_AsWord(y, &b) &&
+            !GMPY_MUL_OVERFLOW(a, b, &r)) {
+            return (PyObject*)GMPy_MPZ_From_SI(r, NULL);
+        }
 
-        if ((result = GMPy_MPZ_New(NULL))) {
+        if ((result = GMPy_MPZ_NewSize(GMPY_MPZ_SIZE(x) + GMPY_MPZ_SIZE(y), NULL))) {
+            GMPY_MAYBE_BEGIN_ALLOW_THREADS(GMPY_GIL_SIZE(x, y));
             mpz_mul(result->z, MPZ(x), MPZ(y));
+            GMPY_MAYBE_END_ALLOW_THREADS;
         }
         return (PyObject*)result;
     }
@@ -467,11 +485,11 @@ PyDoc_STRVAR(GMPy_doc_context_mul,
 "Return x * y.");
 
 static PyObject *
-GMPy_Context_Mul(PyObject *self, PyObject *args)
+GMPy_Context_Mul(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("mul() requires 2 arguments");
         return NULL;
     }
@@ -483,6 +501,6 @@ GMPy_Context_Mul(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Mul(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1), context);
+    return GMPy_Number_Mul(GMPY_ARG(0), GMPY_ARG(1), context);
 }
 
@@ -48,7 +48,7 @@ static PyObject * GMPy_MPQ_Mul_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPFR_Mul_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPC_Mul_Slot(PyObject *x, PyObject *y);
 
-static PyObject * GMPy_Context_Mul(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Mul(PyObject *self, GMPY_FASTCALL_ARGS);
 
 #ifdef __cplusplus
 }
@@ -102,11 +102,11 @@ GMPy_Number_Mul_2exp(PyObject *x, PyObject *y, CTXT_Object *context)
 }
 
 static PyObject *
-GMPy_Context_Mul_2exp(PyObject *self, PyObject *args)
+GMPy_Context_Mul_2exp(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("mul_2exp() requires 2 arguments");
         return NULL;
     }
@@ -118,8 +118,8 @@ GMPy_Context_Mul_2exp(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Mul_2exp(PyTuple_GET_ITEM(args, 0),
-                                PyTuple_GET_ITEM(args, 1),
+    return GMPy_Number_Mul_2exp(GMPY_ARG(0),
+                                GMPY_ARG(1),
                                 context);
 }
 
@@ -202,11 +202,11 @@ GMPy_Number_Div_2exp(PyObject *x, PyObject *y, CTXT_Object *context)
 }
 
 static PyObject *
-GMPy_Context_Div_2exp(PyObject *self, PyObject *args)
+GMPy_Context_Div_2exp(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("div_2exp() requires 2 arguments");
         return NULL;
     }
@@ -218,8 +218,8 @@ GMPy_Context_Div_2exp(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Div_2exp(PyTuple_GET_ITEM(args, 0),
-                                PyTuple_GET_ITEM(args, 1),
+    return GMPy_Number_Div_2exp(GMPY_ARG(0),
+                                GMPY_ARG(1),
                                 context);
 }
 
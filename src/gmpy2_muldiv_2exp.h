@@ -35,12 +35,12 @@ extern "C" {
 static PyObject * GMPy_Real_Mul_2exp(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Complex_Mul_2exp(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Mul_2exp(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Mul_2exp(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Mul_2exp(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_Div_2exp(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Complex_Div_2exp(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Div_2exp(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Div_2exp(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Div_2exp(PyObject *self, GMPY_FASTCALL_ARGS);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,398 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_pickle.c                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+/* An mpz, xmpz, mpq, or mpfr is pickled as
+ *
+ *     (from_binary, (to_binary(x),))
+ *
+ * With pickle protocol 5, large values are instead pickled as
+ *
+ *     (_from_pickle_buffers, (tag, sign, buffer))            mpz, xmpz
+ *     (_from_pickle_buffers, (tag, sign, num, den))          mpq
+ *     (_from_pickle_buffers, (tag, sign, prec, exp, rc, m))  mpfr
+ *
+ * where tag is the to_binary() type code and each buffer is a PickleBuffer
+ * over the limbs of the absolute value, least significant first. Pickle
+ * passes the buffers to buffer_callback, or writes them in-band, without
+ * copying them. The limbs are only exported on little-endian hosts, so a
+ * buffer is always a little-endian byte string and can be read on hosts
+ * with a different limb size. An mpc, and values on big-endian hosts,
+ * always use to_binary().
+ */
+
+static PyObject *GMPy_Pickle_From_Binary = NULL;
+
+#ifdef GMPY_PICKLE_BUFFERS
+static PyObject *GMPy_Pickle_From_Buffers = NULL;
+
+static int
+GMPy_LimbBuffer_GetBuffer(GMPy_LimbBuffer_Object *self, Py_buffer *view, int flags)
+{
+    return PyBuffer_FillInfo(view, (PyObject*)self, self->data, self->len, 1, flags);
+}
+
+static void
+GMPy_LimbBuffer_Dealloc(GMPy_LimbBuffer_Object *self)
+{
+    Py_DECREF(self->owner);
+    PyObject_Del(self);
+}
+
+static PyBufferProcs GMPy_LimbBuffer_buffer_methods =
+{
+    (getbufferproc) GMPy_LimbBuffer_GetBuffer,
+    (releasebufferproc) 0,
+};
+
+static PyTypeObject GMPy_LimbBuffer_Type =
+{
+    PyVarObject_HEAD_INIT(0, 0)
+    "gmpy2 limb buffer",                    /* tp_name          */
+    sizeof(GMPy_LimbBuffer_Object),         /* tp_basicsize     */
+        0,                                  /* tp_itemsize      */
+    (destructor) GMPy_LimbBuffer_Dealloc,   /* tp_dealloc       */
+        0,                                  /* tp_print         */
+        0,                                  /* tp_getattr       */
+        0,                                  /* tp_setattr       */
+        0,                                  /* tp_reserved      */
+        0,                                  /* tp_repr          */
+        0,                                  /* tp_as_number     */
+        0,                                  /* tp_as_sequence   */
+        0,                                  /* tp_as_mapping    */
+        0,                                  /* tp_hash          */
+        0,                                  /* tp_call          */
+        0,                                  /* tp_str           */
+        0,                                  /* tp_getattro      */
+        0,                                  /* tp_setattro      */
+    &GMPy_LimbBuffer_buffer_methods,        /* tp_as_buffer     */
+    Py_TPFLAGS_DEFAULT,                     /* tp_flags         */
+    "GMPY2 Limb Buffer Object",             /* tp_doc           */
+};
+
+/* Return a PickleBuffer over len bytes of limbs owned by owner. The owner
+ * must not change while the buffer exists.
+ */
+
+static PyObject *
+GMPy_Pickle_Buffer(PyObject *owner, void *data, Py_ssize_t len)
+{
+    GMPy_LimbBuffer_Object *temp;
+    PyObject *result;
+
+    if (!(temp = PyObject_New(GMPy_LimbBuffer_Object, &GMPy_LimbBuffer_Type)))
+        return NULL;
+    Py_INCREF(owner);
+    temp->owner = owner;
+    temp->data = data;
+    temp->len = len;
+    result = PyPickleBuffer_FromObject((PyObject*)temp);
+    Py_DECREF((PyObject*)temp);
+    return result;
+}
+
+/* Return the number of bytes of limb data in x if it should be pickled
+ * with buffers, or 0 if it should use to_binary().
+ */
+
+static size_t
+GMPy_Pickle_Buffer_Size(PyObject *x)
+{
+    size_t size = 0;
+
+    if (MPZ_Check(x))
+        size = mpz_size(MPZ(x));
+    else if (XMPZ_Check(x))
+        size = mpz_size(MPZ(x));
+    else if (MPQ_Check(x))
+        size = mpz_size(mpq_numref(MPQ(x))) + mpz_size(mpq_denref(MPQ(x)));
+    else if (MPFR_Check(x) && mpfr_regular_p(MPFR(x)))
+        size = (mpfr_get_prec(MPFR(x)) + mp_bits_per_limb - 1) / mp_bits_per_limb;
+
+    size *= sizeof(mp_limb_t);
+    return size < GMPY_PICKLE_BUFFER_MIN ? 0 : size;
+}
+
+static PyObject *
+GMPy_Pickle_Reduce_Buffers(PyObject *self)
+{
+    PyObject *temp, *num, *den;
+
+    if (MPZ_Check(self)) {
+        if (!(temp = PyPickleBuffer_FromObject(self)))
+            return NULL;
+        return Py_BuildValue("O(iiN)", GMPy_Pickle_From_Buffers, 0x01,
+                             mpz_sgn(MPZ(self)), temp);
+    }
+
+    if (XMPZ_Check(self)) {
+        /* An xmpz can change after it is pickled, so export a copy. */
+        if (!(num = (PyObject*)GMPy_MPZ_From_XMPZ((XMPZ_Object*)self, NULL)))
+            return NULL;
+        temp = PyPickleBuffer_FromObject(num);
+        Py_DECREF(num);
+        if (!temp)
+            return NULL;
+        return Py_BuildValue("O(iiN)", GMPy_Pickle_From_Buffers, 0x02,
+                             mpz_sgn(MPZ(self)), temp);
+    }
+
+    if (MPQ_Check(self)) {
+        mpz_srcptr n = mpq_numref(MPQ(self)), d = mpq_denref(MPQ(self));
+
+        if (!(num = GMPy_Pickle_Buffer(self, n->_mp_d,
+                                       mpz_size(n) * sizeof(mp_limb_t))))
+            return NULL;
+        if (!(den = GMPy_Pickle_Buffer(self, d->_mp_d,
+                                       mpz_size(d) * sizeof(mp_limb_t)))) {
+            Py_DECREF(num);
+            return NULL;
+        }
+        return Py_BuildValue("O(iiNN)", GMPy_Pickle_From_Buffers, 0x03,
+                             mpq_sgn(MPQ(self)), num, den);
+    }
+
+    /* A regular mpfr. */
+    {
+        mpfr_srcptr f = MPFR(self);
+        size_t nlimbs = (mpfr_get_prec(f) + mp_bits_per_limb - 1) / mp_bits_per_limb;
+
+        if (!(temp = GMPy_Pickle_Buffer(self, f->_mpfr_d,
+                                        nlimbs * sizeof(mp_limb_t))))
+            return NULL;
+        return Py_BuildValue("O(iinniN)", GMPy_Pickle_From_Buffers, 0x04,
+                             mpfr_signbit(f) ? -1 : 1,
+                             (Py_ssize_t)mpfr_get_prec(f),
+                             (Py_ssize_t)mpfr_get_exp(f),
+                             ((MPFR_Object*)self)->rc, temp);
+    }
+}
+#endif
+
+PyDoc_STRVAR(GMPy_doc_method_reduce_ex,
+"x.__reduce_ex__(protocol) -> tuple\n\n"
+"Support pickling. With protocol 5 or later, the limbs of a large value\n"
+"are passed as out-of-band buffers.");
+
+static PyObject *
+GMPy_MPANY_Reduce_Ex(PyObject *self, PyObject *other)
+{
+    PyObject *temp;
+    long protocol;
+
+    protocol = c_long_From_Integer(other);
+    if (protocol == -1 && PyErr_Occurred())
+        return NULL;
+
+#ifdef GMPY_PICKLE_BUFFERS
+    if (protocol >= 5 && GMPy_Limb_Endian() < 0 &&
+        GMPy_Pickle_Buffer_Size(self)) {
+        return GMPy_Pickle_Reduce_Buffers(self);
+    }
+#endif
+
+    if (!(temp = GMPy_MPANY_To_Binary(NULL, self)))
+        return NULL;
+    return Py_BuildValue("O(N)", GMPy_Pickle_From_Binary, temp);
+}
+
+#ifdef GMPY_PICKLE_BUFFERS
+/* Set z to the absolute value stored in a buffer of little-endian limbs. */
+
+static int
+GMPy_Pickle_Import(mpz_ptr z, PyObject *obj)
+{
+    Py_buffer view;
+
+    if (PyObject_GetBuffer(obj, &view, PyBUF_SIMPLE) < 0)
+        return -1;
+    if (view.len % sizeof(mp_limb_t) == 0)
+        mpz_import(z, view.len / sizeof(mp_limb_t), -1, sizeof(mp_limb_t), -1, 0, view.buf);
+    else
+        mpz_import(z, view.len, -1, 1, 0, 0, view.buf);
+    PyBuffer_Release(&view);
+    return 0;
+}
+
+/* Set f to the regular value sign * 0.m * 2**exp, where m is the mantissa
+ * stored in a buffer of little-endian limbs with its high bit set. The
+ * limbs are copied directly when the limb size matches.
+ */
+
+static int
+GMPy_Pickle_Import_Mantissa(mpfr_ptr f, int sign, mpfr_exp_t exp, PyObject *obj)
+{
+    Py_buffer view;
+    mpfr_prec_t prec = mpfr_get_prec(f);
+    size_t nlimbs = (prec + mp_bits_per_limb - 1) / mp_bits_per_limb;
+    int unused = (int)(nlimbs * mp_bits_per_limb - prec);
+    mpz_t temp;
+
+    if (PyObject_GetBuffer(obj, &view, PyBUF_SIMPLE) < 0)
+        return -1;
+
+    if (view.len == 0 || !(((unsigned char*)view.buf)[view.len - 1] & 0x80)) {
+        PyBuffer_Release(&view);
+        VALUE_ERROR("invalid mantissa for _from_pickle_buffers()");
+        return -1;
+    }
+
+    if ((size_t)view.len == nlimbs * sizeof(mp_limb_t)) {
+        mpfr_set_ui(f, 1, MPFR_RNDN);
+        memcpy(f->_mpfr_d, view.buf, view.len);
+        f->_mpfr_d[0] &= ~(((mp_limb_t)1 << unused) - 1);
+        f->_mpfr_exp = exp;
+        if (sign < 0)
+            mpfr_neg(f, f, MPFR_RNDN);
+    }
+    else {
+        mpz_init(temp);
+        mpz_import(temp, view.len, -1, 1, 0, 0, view.buf);
+        if (sign < 0)
+            mpz_neg(temp, temp);
+        mpfr_set_z_2exp(f, temp, exp - 8 * (mpfr_exp_t)view.len, MPFR_RNDN);
+        mpz_clear(temp);
+    }
+    PyBuffer_Release(&view);
+    return 0;
+}
+
+PyDoc_STRVAR(GMPy_doc_function_from_pickle_buffers,
+"_from_pickle_buffers(tag, sign, *args) -> number\n\n"
+"Reconstruct a value pickled with out-of-band buffers. Used by pickle.");
+
+static PyObject *
+GMPy_MPANY_From_Pickle_Buffers(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    long tag, sign;
+    Py_ssize_t prec, exp;
+    long rc;
+
+    if (GMPY_NARGS < 3) {
+        TYPE_ERROR("_from_pickle_buffers() requires at least 3 arguments");
+        return NULL;
+    }
+
+    tag = c_long_From_Integer(GMPY_ARG(0));
+    if (tag == -1 && PyErr_Occurred())
+        return NULL;
+    sign = c_long_From_Integer(GMPY_ARG(1));
+    if (sign == -1 && PyErr_Occurred())
+        return NULL;
+
+    if ((tag == 0x01 || tag == 0x02) && GMPY_NARGS == 3) {
+        PyObject *result;
+
+        if (tag == 0x01)
+            result = (PyObject*)GMPy_MPZ_New(NULL);
+        else
+            result = (PyObject*)GMPy_XMPZ_New(NULL);
+        if (!result)
+            return NULL;
+        if (GMPy_Pickle_Import(MPZ(result), GMPY_ARG(2)) < 0) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        if (sign < 0)
+            mpz_neg(MPZ(result), MPZ(result));
+        return result;
+    }
+
+    if (tag == 0x03 && GMPY_NARGS == 4) {
+        MPQ_Object *result;
+
+        if (!(result = GMPy_MPQ_New(NULL)))
+            return NULL;
+        if (GMPy_Pickle_Import(mpq_numref(result->q), GMPY_ARG(2)) < 0 ||
+            GMPy_Pickle_Import(mpq_denref(result->q), GMPY_ARG(3)) < 0) {
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        /* The value was written in lowest terms; only reject a zero
+         * denominator rather than paying for a gcd. */
+        if (mpz_sgn(mpq_denref(result->q)) == 0) {
+            Py_DECREF((PyObject*)result);
+            VALUE_ERROR("invalid denominator for _from_pickle_buffers()");
+            return NULL;
+        }
+        if (sign < 0)
+            mpq_neg(result->q, result->q);
+        return (PyObject*)result;
+    }
+
+    if (tag == 0x04 && GMPY_NARGS == 6) {
+        MPFR_Object *result;
+
+        prec = PyLong_AsSsize_t(GMPY_ARG(2));
+        if (prec == -1 && PyErr_Occurred())
+            return NULL;
+        exp = PyLong_AsSsize_t(GMPY_ARG(3));
+        if (exp == -1 && PyErr_Occurred())
+            return NULL;
+        rc = c_long_From_Integer(GMPY_ARG(4));
+        if (rc == -1 && PyErr_Occurred())
+            return NULL;
+
+        /* GMPy_MPFR_New() treats precisions 0 and 1 as the context
+         * precision. */
+        if (prec < 2 || prec > MPFR_PREC_MAX) {
+            VALUE_ERROR("invalid value for precision");
+            return NULL;
+        }
+        if (exp < mpfr_get_emin_min() || exp > mpfr_get_emax_max()) {
+            VALUE_ERROR("invalid exponent for _from_pickle_buffers()");
+            return NULL;
+        }
+
+        if (!(result = GMPy_MPFR_New((mpfr_prec_t)prec, NULL)))
+            return NULL;
+        if (GMPy_Pickle_Import_Mantissa(result->f, (int)sign,
+                                        (mpfr_exp_t)exp, GMPY_ARG(5)) < 0) {
+            Py_DECREF((PyObject*)result);
+            return NULL;
+        }
+        result->rc = rc > 0 ? 1 : (rc < 0 ? -1 : 0);
+        return (PyObject*)result;
+    }
+
+    VALUE_ERROR("invalid arguments for _from_pickle_buffers()");
+    return NULL;
+}
+#endif
+
+/* Look up the reconstructors used by __reduce_ex__(). */
+
+static int
+GMPy_Pickle_Init(PyObject *module)
+{
+    if (!(GMPy_Pickle_From_Binary = PyObject_GetAttrString(module, "from_binary")))
+        return -1;
+#ifdef GMPY_PICKLE_BUFFERS
+    if (!(GMPy_Pickle_From_Buffers = PyObject_GetAttrString(module, "_from_pickle_buffers")))
+        return -1;
+#endif
+    return 0;
+}
@@ -0,0 +1,68 @@
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * gmpy2_pickle.h                                                          *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
+ * Python interface to the GMP or MPIR, MPFR, and MPC multiple precision   *
+ * libraries.                                                              *
+ *                                                                         *
+ * Copyright 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007,               *
+ *           2008, 2009 Alex Martelli                                      *
+ *                                                                         *
+ * Copyright 2008, 2009, 2010, 2011, 2012, 2013, 2014 Case Van Horsen      *
+ *                                                                         *
+ * This file is part of GMPY2.                                             *
+ *                                                                         *
+ * GMPY2 is free software: you can redistribute it and/or modify it under  *
+ * the terms of the GNU Lesser General Public License as published by the  *
+ * Free Software Foundation, either version 3 of the License, or (at your  *
+ * option) any later version.                                              *
+ *                                                                         *
+ * GMPY2 is distributed in the hope that it will be useful, but WITHOUT    *
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or   *
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU Lesser General Public    *
+ * License for more details.                                               *
+ *                                                                         *
+ * You should have received a copy of the GNU Lesser General Public        *
+ * License along with GMPY2; if not, see <http://www.gnu.org/licenses/>    *
+ * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#ifndef GMPY_PICKLE_H
+#define GMPY_PICKLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Pickle support. Values are normally pickled with to_binary(). Pickle
+ * protocol 5 (Python 3.8 and later) can pass large buffers out-of-band,
+ * so the limbs of large values are exported as PickleBuffers instead.
+ */
+
+#if PY_VERSION_HEX >= 0x03080000
+#  define GMPY_PICKLE_BUFFERS
+#endif
+
+/* Values with less data than this (in bytes) always use to_binary(). */
+#define GMPY_PICKLE_BUFFER_MIN 1024
+
+#ifdef GMPY_PICKLE_BUFFERS
+/* A read-only buffer over limbs owned by another object. */
+
+typedef struct {
+    PyObject_HEAD
+    PyObject *owner;            /* object that owns the limbs */
+    void *data;
+    Py_ssize_t len;
+} GMPy_LimbBuffer_Object;
+
+static PyTypeObject GMPy_LimbBuffer_Type;
+
+static PyObject * GMPy_MPANY_From_Pickle_Buffers(PyObject *self, GMPY_FASTCALL_ARGS);
+#endif
+
+static int        GMPy_Pickle_Init(PyObject *module);
+static PyObject * GMPy_MPANY_Reduce_Ex(PyObject *self, PyObject *other);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -127,11 +127,11 @@ PyDoc_STRVAR(GMPy_doc_context_plus,
 "Return +x, the context is applied to the result.");
 
 static PyObject *
-GMPy_Context_Plus(PyObject *self, PyObject *args)
+GMPy_Context_Plus(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 1) {
+    if (GMPY_NARGS != 1) {
         TYPE_ERROR("plus() requires 1 argument.");
         return NULL;
     }
@@ -143,6 +143,6 @@ GMPy_Context_Plus(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Plus(PyTuple_GET_ITEM(args, 0), context);
+    return GMPy_Number_Plus(GMPY_ARG(0), context);
 }
 
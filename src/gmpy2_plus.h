@@ -48,7 +48,7 @@ static PyObject * GMPy_MPQ_Plus_Slot(MPQ_Object *x);
 static PyObject * GMPy_MPFR_Plus_Slot(MPFR_Object *x);
 static PyObject * GMPy_MPC_Plus_Slot(MPC_Object *x);
 
-static PyObject * GMPy_Context_Plus(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Plus(PyObject *self, GMPY_FASTCALL_ARGS);
 
 #ifdef __cplusplus
 }
@@ -50,6 +50,29 @@
  */
 
 
+/* Compute b ** e for word-sized operands by square-and-multiply. Returns 0
+ * as soon as an intermediate value overflows; the caller then falls back
+ * to mpz_pow_ui().
+ */
+
+static int
+GMPy_Word_Pow(long b, unsigned long e, long *r)
+{
+    long result = 1;
+
+    while (1) {
+        if ((e & 1) && GMPY_MUL_OVERFLOW(result, b, &result))
+            return 0;
+        e >>= 1;
+        if (!e)
+            break;
+        if (GMPY_MUL_OVERFLOW(b, b, &b))
+            return 0;
+    }
+    *r = result;
+    return 1;
+}
+
 /* Pympz_Pow_Integer is called by GMPy_Number_Pow() after verifying that the
  * first two arguments are integers, but not necessarily mpz. The third
  * argument must either be an integer or Py_None. The context argument is not
@@ -61,11 +84,16 @@ GMPy_Integer_Pow(PyObject *b, PyObject *e, PyObject *m, CTXT_Object *context)
 {
     MPZ_Object *result = NULL, *tempb = NULL, *tempe = NULL, *tempm = NULL;
     int has_mod;
+    long wb, we, wr;
 
     /* Try to parse the modulus value first. */
 
     if (m == Py_None) {
         has_mod = 0;
+        if (GMPy_Integer_AsWord(b, &wb) && GMPy_Integer_AsWord(e, &we) &&
+            we >= 0 && GMPy_Word_Pow(wb, (unsigned long)we, &wr)) {
+            return (PyObject*)GMPy_MPZ_From_SI(wr, context);
+        }
     }
     else {
         has_mod = 1;
@@ -79,7 +107,7 @@ GMPy_Integer_Pow(PyObject *b, PyObject *e, PyObject *m, CTXT_Object *context)
         }
     }
 
-    result = GMPy_MPZ_New(context);
+    result = GMPy_MPZ_NewSize(has_mod ? mpz_size(tempm->z) : 0, context);
     tempb = GMPy_MPZ_From_Integer(b, context);
     tempe = GMPy_MPZ_From_Integer(e, context);
 
@@ -135,12 +163,16 @@ GMPy_Integer_Pow(PyObject *b, PyObject *e, PyObject *m, CTXT_Object *context)
                 mpz_abs(exp, tempe->z);
             }
 
+            GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(exp) * mpz_size(mm));
             mpz_powm(result->z, base, exp, mm);
+            GMPY_MAYBE_END_ALLOW_THREADS;
             mpz_cloc(base);
             mpz_cloc(exp);
         }
         else {
+            GMPY_MAYBE_BEGIN_ALLOW_THREADS(mpz_size(tempe->z) * mpz_size(mm));
             mpz_powm(result->z, tempb->z, tempe->z, mm);
+            GMPY_MAYBE_END_ALLOW_THREADS;
         }
         mpz_cloc(mm);
 
@@ -161,7 +193,7 @@ GMPy_Integer_Pow(PyObject *b, PyObject *e, PyObject *m, CTXT_Object *context)
     Py_XDECREF((PyObject*)tempb);
     Py_XDECREF((PyObject*)tempe);
     Py_XDECREF((PyObject*)tempm);
-    Py_DECREF((PyObject*)result);
+    Py_XDECREF((PyObject*)result);
     return NULL;
 }
 
@@ -401,18 +433,18 @@ PyDoc_STRVAR(GMPy_doc_integer_powmod,
 "built-in pow(), but converts all three arguments to mpz.");
 
 static PyObject *
-GMPy_Integer_PowMod(PyObject *self, PyObject *args)
+GMPy_Integer_PowMod(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     PyObject *x, *y, *m;
 
-    if (PyTuple_GET_SIZE(args) != 3) {
+    if (GMPY_NARGS != 3) {
         TYPE_ERROR("powmod() requires 3 arguments.");
         return NULL;
     }
 
-    x = PyTuple_GET_ITEM(args, 0);
-    y = PyTuple_GET_ITEM(args, 1);
-    m = PyTuple_GET_ITEM(args, 2);
+    x = GMPY_ARG(0);
+    y = GMPY_ARG(1);
+    m = GMPY_ARG(2);
 
     if (IS_INTEGER(x) && IS_INTEGER(y) && IS_INTEGER(m))
         return GMPy_Integer_Pow(x, y, m, NULL);
@@ -421,6 +453,170 @@ GMPy_Integer_PowMod(PyObject *self, PyObject *args)
     return NULL;
 }
 
+PyDoc_STRVAR(GMPy_doc_integer_multi_powmod,
+"multi_powmod(bases, exps, m) -> mpz\n\n"
+"Return the product of (bases[i]**exps[i]) mod m. bases and exps can\n"
+"be mpz_vectors or iterables of integers with the same length. The\n"
+"powers are computed simultaneously so the squarings are shared.");
+
+/* Choose the window for Straus' method with k bases and exponents with
+ * bits bits. The cost is the table size, the squarings, and the expected
+ * number of multiplications by a non-zero digit.
+ */
+
+static int
+GMPy_MultiPowMod_Window(Py_ssize_t k, mp_bitcnt_t bits)
+{
+    double cost, best_cost = 0;
+    int w, best = 1;
+
+    for (w = 1; w <= 8; w++) {
+        cost = (double)k * ((1 << w) - 2) + (double)bits +
+               (double)k * ((bits + w - 1) / w) * (1.0 - 1.0 / (1 << w));
+        if (w == 1 || cost < best_cost) {
+            best = w;
+            best_cost = cost;
+        }
+    }
+    return best;
+}
+
+static PyObject *
+GMPy_Integer_MultiPowMod(PyObject *self, GMPY_FASTCALL_ARGS)
+{
+    MPZ_Vector_Object *vb = NULL, *ve = NULL;
+    MPZ_Object *tempm = NULL, *result = NULL;
+    mpz_t *table = NULL, mm, acc, view;
+    mp_bitcnt_t bits = 0, nbits;
+    Py_ssize_t i, k = 0, pos, bad = -1;
+    unsigned long d, tsize = 0;
+    int w = 1, j, acc_one = 1;
+    size_t size;
+
+    if (GMPY_NARGS != 3) {
+        TYPE_ERROR("multi_powmod() requires 3 arguments");
+        return NULL;
+    }
+
+    if (!IS_INTEGER(GMPY_ARG(2))) {
+        TYPE_ERROR("multi_powmod() requires 'int' modulus");
+        return NULL;
+    }
+
+    if (!(tempm = GMPy_MPZ_From_Integer(GMPY_ARG(2), NULL)))
+        return NULL;
+
+    if (mpz_sgn(tempm->z) == 0) {
+        VALUE_ERROR("multi_powmod() 3rd argument cannot be 0");
+        goto err;
+    }
+
+    if (!(vb = GMPy_MPZ_Vector_From_Iterable(GMPY_ARG(0), "multi_powmod()")) ||
+        !(ve = GMPy_MPZ_Vector_From_Iterable(GMPY_ARG(1), "multi_powmod()")))
+        goto err;
+
+    k = vb->length;
+    if (ve->length != k) {
+        VALUE_ERROR("multi_powmod() requires sequences with the same length");
+        goto err;
+    }
+
+    for (i = 0; i < k; i++) {
+        MPZ_VECTOR_VIEW(view, ve, i);
+        nbits = mpz_sgn(view) ? mpz_sizeinbase(view, 2) : 0;
+        if (nbits > bits)
+            bits = nbits;
+    }
+
+    /* table[i * tsize + d] holds bases[i]**d mod m for 0 < d < 2**w. */
+    w = GMPy_MultiPowMod_Window(k, bits);
+    tsize = 1UL << w;
+    if (k && !(table = GMPY_MALLOC(k * tsize * sizeof(mpz_t)))) {
+        PyErr_NoMemory();
+        goto err;
+    }
+    for (i = 0; i < (Py_ssize_t)(k * tsize); i++)
+        mpz_init(table[i]);
+
+    if (!(result = GMPy_MPZ_New(NULL)))
+        goto err;
+
+    mpz_init(mm);
+    mpz_init(acc);
+    mpz_abs(mm, tempm->z);
+    size = ve->limbs_used * mpz_size(mm);
+
+    GMPY_MAYBE_BEGIN_ALLOW_THREADS(size);
+    for (i = 0; i < k; i++) {
+        mpz_t *t = table + i * tsize;
+
+        MPZ_VECTOR_VIEW(view, vb, i);
+        mpz_fdiv_r(t[1], view, mm);
+        MPZ_VECTOR_VIEW(view, ve, i);
+        if (mpz_sgn(view) < 0 && !mpz_invert(t[1], t[1], mm)) {
+            bad = i;
+            break;
+        }
+        for (d = 2; d < tsize; d++) {
+            mpz_mul(t[d], t[d - 1], t[1]);
+            mpz_tdiv_r(t[d], t[d], mm);
+        }
+    }
+
+    if (bad < 0) {
+        for (pos = (Py_ssize_t)((bits + w - 1) / w) - 1; pos >= 0; pos--) {
+            if (!acc_one) {
+                for (j = 0; j < w; j++) {
+                    mpz_mul(acc, acc, acc);
+                    mpz_tdiv_r(acc, acc, mm);
+                }
+            }
+            for (i = 0; i < k; i++) {
+                MPZ_VECTOR_VIEW(view, ve, i);
+                d = GMPy_FixedBasePow_Digit(view, (mp_bitcnt_t)pos * w, w);
+                if (!d)
+                    continue;
+                if (acc_one) {
+                    mpz_set(acc, table[i * tsize + d]);
+                    acc_one = 0;
+                }
+                else {
+                    mpz_mul(acc, acc, table[i * tsize + d]);
+                    mpz_tdiv_r(acc, acc, mm);
+                }
+            }
+        }
+        if (acc_one)
+            mpz_set_ui(acc, 1);
+        mpz_tdiv_r(result->z, acc, mm);
+
+        /* Use Python's convention for a negative modulus. */
+        if (mpz_sgn(tempm->z) < 0 && mpz_sgn(result->z) > 0)
+            mpz_add(result->z, result->z, tempm->z);
+    }
+    GMPY_MAYBE_END_ALLOW_THREADS;
+
+    mpz_clear(mm);
+    mpz_clear(acc);
+
+    if (bad >= 0) {
+        PyErr_Format(PyExc_ValueError,
+                     "multi_powmod() base not invertible for element %zd", bad);
+        Py_CLEAR(result);
+    }
+
+  err:
+    if (table) {
+        for (i = 0; i < (Py_ssize_t)(k * tsize); i++)
+            mpz_clear(table[i]);
+        GMPY_FREE(table);
+    }
+    Py_XDECREF((PyObject*)vb);
+    Py_XDECREF((PyObject*)ve);
+    Py_DECREF((PyObject*)tempm);
+    return (PyObject*)result;
+}
+
 static PyObject *
 GMPy_Number_Pow(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context)
 {
@@ -445,11 +641,11 @@ PyDoc_STRVAR(GMPy_doc_context_pow,
 "Return x ** y.");
 
 static PyObject *
-GMPy_Context_Pow(PyObject *self, PyObject *args)
+GMPy_Context_Pow(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("pow() requires 2 arguments.");
         return NULL;
     }
@@ -460,7 +656,7 @@ GMPy_Context_Pow(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Pow(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1),
+    return GMPy_Number_Pow(GMPY_ARG(0), GMPY_ARG(1),
                            Py_None, context);
 }
 
@@ -40,9 +40,10 @@ static PyObject * GMPy_Integer_Pow(PyObject *base, PyObject *exp, PyObject *mod,
 static PyObject * GMPy_Rational_Pow(PyObject *base, PyObject *exp, PyObject *mod, CTXT_Object *context);
 static PyObject * GMPy_Real_Pow(PyObject *base, PyObject *exp, PyObject *mod, CTXT_Object *context);
 static PyObject * GMPy_Complex_Pow(PyObject *base, PyObject *exp, PyObject *mod, CTXT_Object *context);
-static PyObject * GMPy_Integer_PowMod(PyObject *self, PyObject *args);
+static PyObject * GMPy_Integer_PowMod(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_Integer_MultiPowMod(PyObject *self, GMPY_FASTCALL_ARGS);
 
-static PyObject * GMPy_Context_Pow(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Pow(PyObject *self, GMPY_FASTCALL_ARGS);
 static PyObject * GMPy_Number_Pow(PyObject *x, PyObject *y, PyObject *z, CTXT_Object *context);
 
 #ifdef __cplusplus
@@ -76,11 +76,11 @@ static PyObject * GMPy_Context_Is_Integer(PyObject *self, PyObject *other);
 
 static PyObject * GMPy_Real_Is_LessGreater(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Is_LessGreater(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Is_LessGreater(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Is_LessGreater(PyObject *self, GMPY_FASTCALL_ARGS);
 
 static PyObject * GMPy_Real_Is_Unordered(PyObject *x, PyObject *y, CTXT_Object *context);
 static PyObject * GMPy_Number_Is_Unordered(PyObject *x, PyObject *y, CTXT_Object *context);
-static PyObject * GMPy_Context_Is_Unordered(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_Is_Unordered(PyObject *self, GMPY_FASTCALL_ARGS);
 
 #ifdef __cplusplus
 }
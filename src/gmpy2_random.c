@@ -55,7 +55,7 @@ PyDoc_STRVAR(GMPy_doc_random_state_factory,
 "generator. An optional integer can be specified as the seed value.");
 
 static PyObject *
-GMPy_RandomState_Factory(PyObject *self, PyObject *args)
+GMPy_RandomState_Factory(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     RandomState_Object *result;
     MPZ_Object *temp;
@@ -64,11 +64,11 @@ GMPy_RandomState_Factory(PyObject *self, PyObject *args)
         return NULL;
     }
 
-    if (PyTuple_GET_SIZE(args) == 0) {
+    if (GMPY_NARGS == 0) {
         gmp_randseed_ui(result->state, 0);
     }
-    else if (PyTuple_GET_SIZE(args) == 1) {
-        if (!(temp = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args,0), NULL))) {
+    else if (GMPY_NARGS == 1) {
+        if (!(temp = GMPy_MPZ_From_Integer(GMPY_ARG(0), NULL))) {
             Py_DECREF((PyObject*)result);
             TYPE_ERROR("seed must be an integer");
             return NULL;
@@ -90,29 +90,29 @@ PyDoc_STRVAR(GMPy_doc_mpz_urandomb_function,
 "2**bit_count-1.");
 
 static PyObject *
-GMPy_MPZ_urandomb_Function(PyObject *self, PyObject *args)
+GMPy_MPZ_urandomb_Function(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *result;
     mp_bitcnt_t len;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("mpz_urandomb() requires 2 arguments");
         return NULL;
     }
 
-    if (!RandomState_Check(PyTuple_GET_ITEM(args, 0))) {
+    if (!RandomState_Check(GMPY_ARG(0))) {
         TYPE_ERROR("mpz_urandomb() requires 'random_state' and 'bit_count' arguments");
         return NULL;
     }
 
-    len = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    len = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (len == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         TYPE_ERROR("mpz_urandomb() requires 'random_state' and 'bit_count' arguments");
         return NULL;
     }
 
     if ((result = GMPy_MPZ_New(NULL))) {
-        mpz_urandomb(result->z, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), len);
+        mpz_urandomb(result->z, RANDOM_STATE(GMPY_ARG(0)), len);
     }
 
     return (PyObject*)result;
@@ -124,29 +124,29 @@ PyDoc_STRVAR(GMPy_doc_mpz_rrandomb_function,
 "sequences of zeros and one in its binary representation.");
 
 static PyObject *
-GMPy_MPZ_rrandomb_Function(PyObject *self, PyObject *args)
+GMPy_MPZ_rrandomb_Function(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *result;
     mp_bitcnt_t len;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("mpz_rrandomb() requires 2 arguments");
         return NULL;
     }
 
-    if (!RandomState_Check(PyTuple_GET_ITEM(args, 0))) {
+    if (!RandomState_Check(GMPY_ARG(0))) {
         TYPE_ERROR("mpz_rrandomb() requires 'random_state' and 'bit_count' arguments");
         return NULL;
     }
 
-    len = mp_bitcnt_t_From_Integer(PyTuple_GET_ITEM(args, 1));
+    len = mp_bitcnt_t_From_Integer(GMPY_ARG(1));
     if (len == (mp_bitcnt_t)(-1) && PyErr_Occurred()) {
         TYPE_ERROR("mpz_rrandomb() requires 'random_state' and 'bit_count' arguments");
         return NULL;
     }
 
     if ((result = GMPy_MPZ_New(NULL))) {
-        mpz_rrandomb(result->z, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), len);
+        mpz_rrandomb(result->z, RANDOM_STATE(GMPY_ARG(0)), len);
     }
 
     return (PyObject*)result;
@@ -157,27 +157,27 @@ PyDoc_STRVAR(GMPy_doc_mpz_random_function,
 "Return uniformly distributed random integer between 0 and n-1.");
 
 static PyObject *
-GMPy_MPZ_random_Function(PyObject *self, PyObject *args)
+GMPy_MPZ_random_Function(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPZ_Object *result, *temp;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("mpz_random() requires 2 arguments");
         return NULL;
     }
 
-    if (!RandomState_Check(PyTuple_GET_ITEM(args, 0))) {
+    if (!RandomState_Check(GMPY_ARG(0))) {
         TYPE_ERROR("mpz_random() requires 'random_state' and 'int' arguments");
         return NULL;
     }
 
-    if (!(temp = GMPy_MPZ_From_Integer(PyTuple_GET_ITEM(args, 1), NULL))) {
+    if (!(temp = GMPy_MPZ_From_Integer(GMPY_ARG(1), NULL))) {
         TYPE_ERROR("mpz_random() requires 'random_state' and 'int' arguments");
         return NULL;
     }
 
     if ((result = GMPy_MPZ_New(NULL))) {
-        mpz_urandomm(result->z, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), temp->z);
+        mpz_urandomm(result->z, RANDOM_STATE(GMPY_ARG(0)), temp->z);
     }
 
     Py_DECREF((PyObject*)temp);
@@ -189,25 +189,25 @@ PyDoc_STRVAR(GMPy_doc_mpfr_random_function,
 "Return uniformly distributed number between [0,1].");
 
 static PyObject *
-GMPy_MPFR_random_Function(PyObject *self, PyObject *args)
+GMPy_MPFR_random_Function(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPFR_Object *result;
     CTXT_Object *context = NULL;
 
     CHECK_CONTEXT(context);
 
-    if (PyTuple_GET_SIZE(args) != 1) {
+    if (GMPY_NARGS != 1) {
         TYPE_ERROR("mpfr_random() requires 1 argument");
         return NULL;
     }
 
-    if (!RandomState_Check(PyTuple_GET_ITEM(args, 0))) {
+    if (!RandomState_Check(GMPY_ARG(0))) {
         TYPE_ERROR("mpfr_random() requires 'random_state' argument");
         return NULL;
     }
 
     if ((result = GMPy_MPFR_New(0, context))) {
-        mpfr_urandom(result->f, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)), GET_MPFR_ROUND(context));
+        mpfr_urandom(result->f, RANDOM_STATE(GMPY_ARG(0)), GET_MPFR_ROUND(context));
     }
 
     return (PyObject*)result;
@@ -218,7 +218,7 @@ PyDoc_STRVAR(GMPy_doc_mpfr_grandom_function,
 "Return two random numbers with gaussian distribution.");
 
 static PyObject *
-GMPy_MPFR_grandom_Function(PyObject *self, PyObject *args)
+GMPy_MPFR_grandom_Function(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPFR_Object *result1, *result2;
     PyObject *result;
@@ -226,12 +226,12 @@ GMPy_MPFR_grandom_Function(PyObject *self, PyObject *args)
 
     CHECK_CONTEXT(context);
 
-    if (PyTuple_GET_SIZE(args) != 1) {
+    if (GMPY_NARGS != 1) {
         TYPE_ERROR("mpfr_grandom() requires 1 argument");
         return NULL;
     }
 
-    if (!RandomState_Check(PyTuple_GET_ITEM(args, 0))) {
+    if (!RandomState_Check(GMPY_ARG(0))) {
         TYPE_ERROR("mpfr_grandom() requires 'random_state' argument");
         return NULL;
     }
@@ -245,7 +245,7 @@ GMPy_MPFR_grandom_Function(PyObject *self, PyObject *args)
     }
 
     mpfr_grandom(result1->f, result2->f,
-                 RANDOM_STATE(PyTuple_GET_ITEM(args, 0)),
+                 RANDOM_STATE(GMPY_ARG(0)),
                  GET_MPFR_ROUND(context));
 
     result = Py_BuildValue("(NN)", (PyObject*)result1, (PyObject*)result2);
@@ -261,25 +261,25 @@ PyDoc_STRVAR(GMPy_doc_mpc_random_function,
 "Return uniformly distributed number in the unit square [0,1]x[0,1].");
 
 static PyObject *
-GMPy_MPC_random_Function(PyObject *self, PyObject *args)
+GMPy_MPC_random_Function(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     MPC_Object *result;
     CTXT_Object *context = NULL;
 
     CHECK_CONTEXT(context);
 
-    if (PyTuple_GET_SIZE(args) != 1) {
+    if (GMPY_NARGS != 1) {
         TYPE_ERROR("mpfc_random() requires 1 argument");
         return NULL;
     }
 
-    if (!RandomState_Check(PyTuple_GET_ITEM(args, 0))) {
+    if (!RandomState_Check(GMPY_ARG(0))) {
         TYPE_ERROR("mpc_random() requires 'random_state' argument");
         return NULL;
     }
 
     if ((result = GMPy_MPC_New(0, 0, context))) {
-        mpc_urandom(result->c, RANDOM_STATE(PyTuple_GET_ITEM(args, 0)));
+        mpc_urandom(result->c, RANDOM_STATE(GMPY_ARG(0)));
     }
 
     return (PyObject*)result;
@@ -54,13 +54,13 @@ static RandomState_Object * GMPy_RandomState_New(void);
 static void                 GMPy_RandomState_Dealloc(RandomState_Object *self);
 
 static PyObject * GMPy_RandomState_Repr(RandomState_Object *self);
-static PyObject * GMPy_RandomState_Factory(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_urandomb_Function(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_rrandomb_Function(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPZ_random_Function(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPFR_random_Function(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPFR_grandom_Function(PyObject *self, PyObject *args);
-static PyObject * GMPy_MPC_random_Function(PyObject *self, PyObject *args);
+static PyObject * GMPy_RandomState_Factory(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_urandomb_Function(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_rrandomb_Function(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPZ_random_Function(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPFR_random_Function(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPFR_grandom_Function(PyObject *self, GMPY_FASTCALL_ARGS);
+static PyObject * GMPy_MPC_random_Function(PyObject *self, GMPY_FASTCALL_ARGS);
 
 #ifdef __cplusplus
 }
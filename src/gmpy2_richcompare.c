@@ -49,6 +49,21 @@ GMPy_RichCompare_Slot(PyObject *a, PyObject *b, int op)
     PyObject *tempa = NULL, *tempb = NULL, *result = NULL;
     CTXT_Object *context = NULL;
 
+    /* Integer comparisons do not need the context, so handle them before
+     * looking it up.
+     */
+
+    if (CHECK_MPZANY(a)) {
+        long x, y;
+
+        if (GMPy_Integer_AsWord(a, &x) && GMPy_Integer_AsWord(b, &y)) {
+            return _cmp_to_object((x > y) - (x < y), op);
+        }
+        if (CHECK_MPZANY(b)) {
+            return _cmp_to_object(mpz_cmp(MPZ(a), MPZ(b)), op);
+        }
+    }
+
     CHECK_CONTEXT(context);
 
     if (CHECK_MPZANY(a)) {
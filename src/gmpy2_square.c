@@ -48,7 +48,7 @@ _GMPy_MPZ_Square(PyObject *x, CTXT_Object *context)
 {
     MPZ_Object *result = NULL;
 
-    if (!(result = GMPy_MPZ_New(context))) {
+    if (!(result = GMPy_MPZ_NewSize(2 * mpz_size(MPZ(x)), context))) {
         return NULL;
     }
 
@@ -58,8 +58,14 @@ static PyObject *
 GMPy_Integer_Sub(PyObject *x, PyObject *y, CTXT_Object *context)
 {
     MPZ_Object *result;
+    long a, b, r;
 
-    if (!(result = GMPy_MPZ_New(context)))
+    if (GMPy_Integer_AsWord(x, &a) && GMPy_Integer_AsWord(y, &b) &&
+        !GMPY_SUB_OVERFLOW(a, b, &r)) {
+        return (PyObject*)GMPy_MPZ_From_SI(r, context);
+    }
+
+    if (!(result = GMPy_MPZ_NewSize(GMPY_ADD_SIZE(x, y), context)))
         return NULL;
 
     if (CHECK_MPZANY(x)) {
@@ -149,8 +155,14 @@ GMPy_MPZ_Sub_Slot(PyObject *x, PyObject *y)
 {
     if (CHECK_MPZANY(x) && CHECK_MPZANY(y)) {
         MPZ_Object *result;
+        long a, b, r;
+
+        if (GMPy_Integer_AsWord(x, &a) && GMPy_Integer_AsWord(y, &b) &&
+            !GMPY_SUB_OVERFLOW(a, b, &r)) {
+            return (PyObject*)GMPy_MPZ_From_SI(r, NULL);
+        }
 
-        if ((result = GMPy_MPZ_New(NULL))) {
+        if ((result = GMPy_MPZ_NewSize(GMPY_ADD_SIZE(x, y), NULL))) {
             mpz_sub(result->z, MPZ(x), MPZ(y));
         }
         return (PyObject*)result;
@@ -488,11 +500,11 @@ PyDoc_STRVAR(GMPy_doc_context_sub,
 "Return x - y.");
 
 static PyObject *
-GMPy_Context_Sub(PyObject *self, PyObject *args)
+GMPy_Context_Sub(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("sub() requires 2 arguments");
         return NULL;
     }
@@ -504,7 +516,7 @@ GMPy_Context_Sub(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_Sub(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1),
+    return GMPy_Number_Sub(GMPY_ARG(0), GMPY_ARG(1),
                            context);
 }
 
@@ -429,11 +429,11 @@ PyDoc_STRVAR(GMPy_doc_context_truediv,
 "Return x / y; uses true division.");
 
 static PyObject *
-GMPy_Context_TrueDiv(PyObject *self, PyObject *args)
+GMPy_Context_TrueDiv(PyObject *self, GMPY_FASTCALL_ARGS)
 {
     CTXT_Object *context = NULL;
 
-    if (PyTuple_GET_SIZE(args) != 2) {
+    if (GMPY_NARGS != 2) {
         TYPE_ERROR("div() requires 2 arguments.");
         return NULL;
     }
@@ -445,7 +445,7 @@ GMPy_Context_TrueDiv(PyObject *self, PyObject *args)
         CHECK_CONTEXT(context);
     }
 
-    return GMPy_Number_TrueDiv(PyTuple_GET_ITEM(args, 0), PyTuple_GET_ITEM(args, 1),
+    return GMPy_Number_TrueDiv(GMPY_ARG(0), GMPY_ARG(1),
                                context);
 }
 
@@ -48,7 +48,7 @@ static PyObject * GMPy_MPQ_TrueDiv_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPFR_TrueDiv_Slot(PyObject *x, PyObject *y);
 static PyObject * GMPy_MPC_TrueDiv_Slot(PyObject *x, PyObject *y);
 
-static PyObject * GMPy_Context_TrueDiv(PyObject *self, PyObject *args);
+static PyObject * GMPy_Context_TrueDiv(PyObject *self, GMPY_FASTCALL_ARGS);
 
 #ifdef __cplusplus
 }
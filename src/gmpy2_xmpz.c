@@ -44,7 +44,7 @@ PyDoc_STRVAR(GMPy_doc_xmpz_factory,
 "     recommended in most cases.");
 
 static PyObject *
-GMPy_XMPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
+GMPy_XMPZ_Factory(PyObject *self, GMPY_FASTCALL_KWARGS)
 {
     XMPZ_Object *result = 0;
     PyObject *n = 0;
@@ -55,7 +55,7 @@ GMPy_XMPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
 
     CHECK_CONTEXT(context);
 
-    argc = PyTuple_GET_SIZE(args);
+    argc = GMPY_NARGS;
     
     if (argc == 0) {
         if ((result = GMPy_XMPZ_New(context))) {
@@ -64,8 +64,8 @@ GMPy_XMPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
         return (PyObject*)result;
     }
     
-    if (argc == 1 && !keywds) {
-        n = PyTuple_GET_ITEM(args, 0);
+    if (argc == 1 && !GMPY_NKWARGS) {
+        n = GMPY_ARG(0);
         if (IS_REAL(n)) {
             result = GMPy_XMPZ_From_Number(n, context);
         }
@@ -78,7 +78,7 @@ GMPy_XMPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds)
         return (PyObject*)result;
     }
 
-    if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|i", kwlist, &n, &base)) {
+    if (!GMPy_ParseArgsAndKeywords(GMPY_FASTCALL_PASS, "O|i", kwlist, &n, &base)) {
         return NULL;
     }
 
@@ -192,12 +192,13 @@ static PyMappingMethods GMPy_XMPZ_mapping_methods = {
 static PyMethodDef GMPy_XMPZ_methods [] =
 {
     { "__format__", GMPy_MPZ_Format, METH_VARARGS, GMPy_doc_mpz_format },
+    { "__reduce_ex__", GMPy_MPANY_Reduce_Ex, METH_O, GMPy_doc_method_reduce_ex },
     { "__sizeof__", GMPy_XMPZ_Method_SizeOf, METH_NOARGS, GMPy_doc_xmpz_method_sizeof },
     { "bit_clear", GMPy_MPZ_bit_clear_method, METH_O, doc_bit_clear_method },
     { "bit_flip", GMPy_MPZ_bit_flip_method, METH_O, doc_bit_flip_method },
     { "bit_length", GMPy_MPZ_bit_length_method, METH_NOARGS, doc_bit_length_method },
-    { "bit_scan0", GMPy_MPZ_bit_scan0_method, METH_VARARGS, doc_bit_scan0_method },
-    { "bit_scan1", GMPy_MPZ_bit_scan1_method, METH_VARARGS, doc_bit_scan1_method },
+    { "bit_scan0", (PyCFunction)GMPy_MPZ_bit_scan0_method, GMPY_METH_FASTCALL, doc_bit_scan0_method },
+    { "bit_scan1", (PyCFunction)GMPy_MPZ_bit_scan1_method, GMPY_METH_FASTCALL, doc_bit_scan1_method },
     { "bit_set", GMPy_MPZ_bit_set_method, METH_O, doc_bit_set_method },
     { "bit_test", GMPy_MPZ_bit_test_method, METH_O, doc_bit_test_method },
     { "copy", GMPy_XMPZ_Method_Copy, METH_NOARGS, GMPy_doc_xmpz_method_copy },
@@ -206,7 +207,8 @@ static PyMethodDef GMPy_XMPZ_methods [] =
     { "iter_clear", (PyCFunction)GMPy_XMPZ_Method_IterClear, METH_VARARGS | METH_KEYWORDS, GMPy_doc_xmpz_method_iter_clear },
     { "iter_set", (PyCFunction)GMPy_XMPZ_Method_IterSet, METH_VARARGS | METH_KEYWORDS, GMPy_doc_xmpz_method_iter_set },
     { "make_mpz", GMPy_XMPZ_Method_MakeMPZ, METH_NOARGS, GMPy_doc_xmpz_method_make_mpz },
-    { "num_digits", GMPy_MPZ_Method_NumDigits, METH_VARARGS, GMPy_doc_mpz_method_num_digits },
+    { "limbs", GMPy_MPZ_Method_Limbs, METH_NOARGS, GMPy_doc_mpz_method_limbs },
+    { "num_digits", (PyCFunction)GMPy_MPZ_Method_NumDigits, GMPY_METH_FASTCALL, GMPy_doc_mpz_method_num_digits },
     { NULL, NULL, 1 }
 };
 
@@ -32,14 +32,9 @@
 extern "C" {
 #endif
 
-typedef struct {
-    PyObject_HEAD
-    mpz_t z;
-} XMPZ_Object;
+/* XMPZ_Object, XMPZ(), and XMPZ_Check() are defined in gmpy2_capi.h. */
 
 static PyTypeObject XMPZ_Type;
-#define XMPZ(obj) (((XMPZ_Object*)(obj))->z)
-#define XMPZ_Check(v) (((PyObject*)v)->ob_type == &XMPZ_Type)
 #define CHECK_MPZANY(v) (MPZ_Check(v) || XMPZ_Check(v))
 
 typedef struct {
@@ -52,7 +47,7 @@ typedef struct {
 static PyTypeObject GMPy_Iter_Type;
 #define GMPy_Iter_Check(v) (((PyObject*)v)->ob_type == &GMPy_Iter_Type)
 
-static PyObject * GMPy_XMPZ_Factory(PyObject *self, PyObject *args, PyObject *keywds);
+static PyObject * GMPy_XMPZ_Factory(PyObject *self, GMPY_FASTCALL_KWARGS);
 
 #ifdef __cplusplus
 }
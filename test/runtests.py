@@ -59,7 +59,12 @@ if sys.version.startswith('3.1'):
     print()
 
 mpz_doctests = ["test_mpz_create.txt", "test_mpz.txt", "test_mpz_io.txt",
-                "test_mpz_pack_unpack.txt", "test_mpz_to_from_binary.txt"]
+                "test_mpz_pack_unpack.txt", "test_mpz_to_from_binary.txt",
+                "test_mpz_vector.txt", "test_mpz_tree.txt",
+                "test_modcontext.txt", "test_fixedbase.txt",
+                "test_multi_powmod.txt", "test_batch_invert.txt",
+                "test_crt.txt", "test_binary_many.txt",
+                "test_mpz_table.txt"]
 
 mpq_doctests = ["test_mpq.txt", "test_mpq_to_from_binary.txt"]
 
@@ -71,11 +76,17 @@ mpfr_doctests = ["test_mpfr_create.txt", "test_mpfr.txt",
 mpc_doctests = ["test_mpc_create.txt", "test_mpc.txt",
                 "test_mpc_to_from_binary.txt"]
 
-gmpy2_tests = ["test_misc.txt", "test_abs.txt"]
+gmpy2_tests = ["test_misc.txt", "test_abs.txt", "test_cache.txt"]
 
 # The following tests will only pass on Python 3.2+.
 py32_doctests = ["test_py32_hash.txt"]
 
+# The following tests require contextvars (Python 3.7+).
+py37_doctests = ["test_contextvars.txt"]
+
+# The following tests require pickle protocol 5 (Python 3.8+).
+py38_doctests = ["test_pickle_buffers.txt"]
+
 failed = 0
 attempted = 0
 
@@ -90,6 +101,12 @@ all_doctests += mpc_doctests
 if sys.version >= "3.2":
     all_doctests += py32_doctests
 
+if sys.version_info[:2] >= (3, 7):
+    all_doctests += py37_doctests
+
+if sys.version_info[:2] >= (3, 8):
+    all_doctests += py38_doctests
+
 for test in sorted(all_doctests):
     for r in range(repeat):
         result = doctest.testfile(test, globs=globals(),
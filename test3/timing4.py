@@ -0,0 +1,39 @@
+# Measure the cost of looking up the current context when several threads
+# call gmpy2 interleaved. A short switch interval forces frequent thread
+# switches.
+
+import sys
+import threading
+import time
+import gmpy2
+
+def work(n, result):
+    x = gmpy2.mpfr(1.5)
+    y = gmpy2.mpfr(2.5)
+    start = time.time()
+    for i in range(n):
+        x + y; x + y; x + y; x + y; x + y
+        x + y; x + y; x + y; x + y; x + y
+    result.append(time.time() - start)
+
+def timed(nthreads, n):
+    result = []
+    threads = [threading.Thread(target=work, args=(n, result))
+               for i in range(nthreads)]
+    start = time.time()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    return (time.time() - start) / (nthreads * n * 10)
+
+def test(n=100000, repeat=5):
+    for interval in (sys.getswitchinterval(), 1e-6):
+        sys.setswitchinterval(interval)
+        print("Switch interval %g s:" % interval)
+        for nthreads in (1, 2, 4):
+            best = min(timed(nthreads, n) for i in range(repeat))
+            print("    %d thread(s): %5.1f ns per mpfr addition" % (nthreads, best * 1e9))
+
+if __name__ == '__main__':
+    test()
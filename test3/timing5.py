@@ -0,0 +1,47 @@
+# Measure the word-sized fast paths: integer arithmetic and comparisons
+# whose operands and results fit in a machine word, as in hashing, counters
+# and modular arithmetic with 64-bit moduli. The last row uses operands
+# whose products overflow a word and so take the general path.
+
+import time
+import gmpy2
+
+def timed(op, x, y, n):
+    start = time.time()
+    for i in range(n):
+        op(x, y); op(x, y); op(x, y); op(x, y); op(x, y)
+        op(x, y); op(x, y); op(x, y); op(x, y); op(x, y)
+    return (time.time() - start) / (n * 10)
+
+ops = [
+    ("+", lambda x, y: x + y),
+    ("-", lambda x, y: x - y),
+    ("*", lambda x, y: x * y),
+    ("//", lambda x, y: x // y),
+    ("%", lambda x, y: x % y),
+    ("divmod", divmod),
+    ("**", lambda x, y: x ** 3),
+    ("<", lambda x, y: x < y),
+    ("==", lambda x, y: x == y),
+]
+
+operands = [
+    ("small mpz", gmpy2.mpz(1000), gmpy2.mpz(-37)),
+    ("word mpz", gmpy2.mpz(123456789), gmpy2.mpz(-987654)),
+    ("mpz, int", gmpy2.mpz(123456789), 987654),
+    ("int", 123456789, -987654),
+    ("large mpz", gmpy2.mpz(2**40 + 1), gmpy2.mpz(2**40 - 1)),
+]
+
+def test(n=20000, repeat=5):
+    print("%-10s" % "" + "".join("%9s" % name for name, op in ops))
+    for label, x, y in operands:
+        row = "%-10s" % label
+        for name, op in ops:
+            best = min(timed(op, x, y, n) for i in range(repeat))
+            row += "%9.1f" % (best * 1e9)
+        print(row)
+    print("(ns per operation)")
+
+if __name__ == '__main__':
+    test()